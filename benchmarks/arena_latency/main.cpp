@@ -0,0 +1,157 @@
+// This benchmark measures the tail latency of interactive requests while
+// the executor is flooded with background work.
+// A producer thread keeps submitting background tasks that each spin for
+// a fixed amount of time, and the main thread runs a small interactive
+// taskflow (a fan-out and fan-in of short tasks) one request at a time.
+// The benchmark reports the p50 and p99 latency of the requests
+//
+//   + shared: all workers in one arena, so requests queue up behind
+//     the background tasks
+//   + arenas: the interactive taskflow runs in an arena of its own workers,
+//     isolated from the background arena
+//   + stealing: as arenas, but idle interactive workers help the
+//     background arena
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+struct Result {
+  double p50 {0};
+  double p99 {0};
+  size_t num_background {0};
+};
+
+Result measure(
+  tf::Executor& executor,
+  size_t interactive,
+  size_t background,
+  size_t num_requests,
+  size_t fan_out,
+  std::chrono::microseconds work
+) {
+
+  // background flood, bounded such that the queues do not grow unboundedly
+  std::atomic<bool> stop {false};
+  std::atomic<size_t> num_pending {0};
+  std::atomic<size_t> num_background {0};
+
+  std::thread producer([&](){
+    tf::TaskParams params;
+    params.arena = background;
+    while(!stop.load(std::memory_order_relaxed)) {
+      if(num_pending.load(std::memory_order_relaxed) >= 4 * executor.num_workers()) {
+        std::this_thread::yield();
+        continue;
+      }
+      num_pending.fetch_add(1, std::memory_order_relaxed);
+      executor.silent_async(params, [&, work](){
+        auto beg = std::chrono::steady_clock::now();
+        while(std::chrono::steady_clock::now() - beg < work);
+        num_pending.fetch_sub(1, std::memory_order_relaxed);
+        num_background.fetch_add(1, std::memory_order_relaxed);
+      });
+    }
+  });
+
+  tf::Taskflow taskflow;
+  taskflow.arena(interactive);
+
+  auto S = taskflow.emplace([](){});
+  auto T = taskflow.emplace([](){});
+  for(size_t i=0; i<fan_out; i++) {
+    auto task = taskflow.emplace([](){
+      auto beg = std::chrono::steady_clock::now();
+      while(std::chrono::steady_clock::now() - beg < std::chrono::microseconds(1));
+    });
+    S.precede(task);
+    task.precede(T);
+  }
+
+  std::vector<double> latencies(num_requests);
+
+  for(size_t r=0; r<num_requests; r++) {
+    auto beg = std::chrono::steady_clock::now();
+    executor.run(taskflow).wait();
+    latencies[r] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - beg
+    ).count() / 1e3;
+  }
+
+  stop = true;
+  producer.join();
+  executor.wait_for_all();
+
+  std::sort(latencies.begin(), latencies.end());
+
+  Result result;
+  result.p50 = latencies[latencies.size() / 2];
+  result.p99 = latencies[latencies.size() * 99 / 100];
+  result.num_background = num_background;
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"ArenaLatency"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t num_interactive {1};
+  app.add_option("-i,--num_interactive", num_interactive, "number of interactive workers in arenas (default=1)");
+
+  size_t num_requests {1000};
+  app.add_option("-n,--num_requests", num_requests, "number of interactive requests (default=1000)");
+
+  size_t fan_out {16};
+  app.add_option("-f,--fan_out", fan_out, "number of tasks per request (default=16)");
+
+  size_t work {100};
+  app.add_option("-w,--work", work, "duration of each background task in us (default=100)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  num_threads = std::max(num_threads, 2u);
+  num_interactive = std::clamp(num_interactive, size_t{1}, size_t{num_threads - 1});
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_interactive=" << num_interactive << ' '
+            << "num_requests=" << num_requests << ' '
+            << "fan_out=" << fan_out << ' '
+            << "work=" << work << ' '
+            << std::endl;
+
+  std::cout << std::setw(12) << "mode"
+            << std::setw(12) << "p50 (us)"
+            << std::setw(12) << "p99 (us)"
+            << std::setw(16) << "background"
+            << std::endl;
+
+  auto report = [](const char* mode, const Result& r) {
+    std::cout << std::setw(12) << mode
+              << std::setw(12) << r.p50
+              << std::setw(12) << r.p99
+              << std::setw(16) << r.num_background
+              << std::endl;
+  };
+
+  auto us = std::chrono::microseconds(work);
+
+  {
+    tf::Executor executor(num_threads);
+    report("shared", measure(executor, 0, 0, num_requests, fan_out, us));
+  }
+
+  for(bool steal : {false, true}) {
+    tf::Executor executor({
+      {"interactive", num_interactive, steal},
+      {"background", num_threads - num_interactive}
+    });
+    report(
+      steal ? "stealing" : "arenas",
+      measure(executor, 0, 1, num_requests, fan_out, us)
+    );
+  }
+
+  return 0;
+}
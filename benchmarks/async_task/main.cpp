@@ -19,6 +19,9 @@ void bench_async_task(
       if(model == "tf") {
         runtime += measure_time_taskflow(num_threads, S).count();
       }
+      else if(model == "tf-bulk") {
+        runtime += measure_time_taskflow_bulk(num_threads, S).count();
+      }
       else if(model == "std") {
         runtime += measure_time_std(num_threads, S).count();
       }
@@ -48,19 +51,29 @@ int main(int argc, char* argv[]) {
   app.add_option("-r,--num_rounds", num_rounds, "number of rounds (default=1)");
 
   std::string model = "tf";
-  app.add_option("-m,--model", model, "model name std|omp|tf|tbb (default=tf)")
+  app.add_option("-m,--model", model, "model name std|omp|tf|tf-bulk|tbb (default=tf)")
      ->check([] (const std::string& m) {
-        if(m != "std" && m != "omp" && m != "tf" && m != "tbb") {
-          return "model name should be \"std\", \"omp\", \"tbb\", or \"tf\"";
+        if(m != "std" && m != "omp" && m != "tf" && m != "tf-bulk" && m != "tbb") {
+          return "model name should be \"std\", \"omp\", \"tbb\", \"tf\", or \"tf-bulk\"";
         }
         return "";
      });
 
   CLI11_PARSE(app, argc, argv);
 
+  // task allocator of the tf model, selected at compile time
+#if defined(TF_ENABLE_TASK_POOL)
+  std::string allocator = "pool";
+#elif defined(TF_ENABLE_TASK_SLAB)
+  std::string allocator = "slab";
+#else
+  std::string allocator = "malloc";
+#endif
+
   std::cout << "model=" << model << ' '
             << "num_threads=" << num_threads << ' '
             << "num_rounds=" << num_rounds << ' '
+            << "allocator=" << allocator << ' '
             << std::endl;
 
   bench_async_task(model, num_threads, num_rounds);
@@ -26,4 +26,26 @@ std::chrono::microseconds measure_time_taskflow(unsigned num_threads, size_t num
   return std::chrono::duration_cast<std::chrono::microseconds>(end - beg);
 }
 
+// async_task computing with one bulk submission
+void async_task_taskflow_bulk(unsigned num_threads, size_t num_tasks) {
+
+  static tf::Executor executor(num_threads);
+
+  std::atomic<size_t> counter(0);
+
+  executor.bulk_silent_async(num_tasks, [&] (size_t) { func(counter); });
+
+  executor.wait_for_all();
+  
+  if(counter.load(std::memory_order_relaxed) != num_tasks) {
+    throw std::runtime_error("incorrect result");
+  }
+}
+
+std::chrono::microseconds measure_time_taskflow_bulk(unsigned num_threads, size_t num_tasks) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  async_task_taskflow_bulk(num_threads, num_tasks);
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg);
+}
 
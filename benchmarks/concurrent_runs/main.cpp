@@ -0,0 +1,108 @@
+// This benchmark measures the throughput of a request-handling taskflow
+// that many client threads submit to the same executor. Each request runs
+// the same taskflow of a few stages:
+//
+//   parse -> {stage_1, ..., stage_W} -> respond
+//
+// and each client submits its next request after the previous one completes.
+// The benchmark compares the two modes of running the same taskflow:
+//
+//   + serialized: the default mode, in which the executor runs the
+//     submissions of a taskflow one after another
+//   + concurrent: tf::Taskflow::concurrent_runs, in which each submission
+//     runs on its own array of tasks reused across submissions
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+void work(size_t n) {
+  volatile size_t sum = 0;
+  for(size_t k=0; k<n; k++) {
+    sum = sum + k;
+  }
+}
+
+double measure(
+  tf::Executor& executor, bool concurrent, 
+  size_t num_clients, size_t num_requests, size_t width, size_t grain
+) {
+
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(concurrent);
+
+  auto parse = taskflow.emplace([=](){ work(grain); });
+  auto respond = taskflow.emplace([=](){ work(grain); });
+  for(size_t i=0; i<width; i++) {
+    taskflow.emplace([=](){ work(grain); }).succeed(parse).precede(respond);
+  }
+
+  std::vector<std::thread> clients;
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  for(size_t c=0; c<num_clients; c++) {
+    clients.emplace_back([&](){
+      for(size_t r=0; r<num_requests; r++) {
+        executor.run(taskflow).wait();
+      }
+    });
+  }
+  for(auto& c : clients) {
+    c.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  auto sec = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+
+  return num_clients * num_requests / sec;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"ConcurrentRuns"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t max_clients {32};
+  app.add_option("-c,--max_clients", max_clients, "maximum number of client threads (default=32)");
+
+  size_t num_requests {1000};
+  app.add_option("-n,--num_requests", num_requests, "number of requests per client (default=1000)");
+
+  size_t width {4};
+  app.add_option("-w,--width", width, "number of parallel stages per request (default=4)");
+
+  size_t grain {1000};
+  app.add_option("-g,--grain", grain, "iterations of work per task (default=1000)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "max_clients=" << max_clients << ' '
+            << "num_requests=" << num_requests << ' '
+            << "width=" << width << ' '
+            << "grain=" << grain << ' '
+            << std::endl;
+
+  std::cout << std::setw(12) << "clients"
+            << std::setw(18) << "serialized (r/s)"
+            << std::setw(18) << "concurrent (r/s)"
+            << std::setw(12) << "speedup"
+            << std::endl;
+
+  tf::Executor executor(num_threads);
+
+  for(size_t clients=1; clients<=max_clients; clients*=2) {
+
+    auto serialized = measure(executor, false, clients, num_requests, width, grain);
+    auto concurrent = measure(executor, true,  clients, num_requests, width, grain);
+
+    std::cout << std::setw(12) << clients
+              << std::setw(18) << static_cast<size_t>(serialized)
+              << std::setw(18) << static_cast<size_t>(concurrent)
+              << std::setw(12) << concurrent / serialized
+              << std::endl;
+  }
+
+  return 0;
+}
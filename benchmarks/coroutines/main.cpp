@@ -0,0 +1,176 @@
+// This benchmark measures a fan-out/await-heavy workload, where each of
+// many requests goes through a number of stages and each stage fans out
+// a group of child tasks and waits for all of them before the next stage.
+// It compares two ways of waiting for the children:
+//
+//   + corun    : a runtime task that coruns the children with
+//                tf::Runtime::corun, which keeps the request on the stack
+//                of its worker while the worker runs other tasks
+//   + coroutine: a coroutine task that awaits the children with
+//                co_await tf::corun, which suspends the request and
+//                frees its worker until the children finish
+//
+// Each child performs a small amount of work such that the runtime is
+// dominated by the cost of waiting for the children.
+// The benchmark reports the runtime and the peak number of requests
+// in progress at the same time.
+// Coroutine tasks require C++20.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+void work(size_t iterations) {
+  volatile size_t sum = 0;
+  for(size_t k=0; k<iterations; k++) {
+    sum = sum + k;
+  }
+}
+
+struct Result {
+  double ms {0};
+  size_t peak {0};
+};
+
+// Class: Requests
+// one child graph per request and the counters of the requests in progress
+class Requests {
+
+  public:
+
+  Requests(size_t num_requests, size_t width, size_t iterations) :
+    _children(num_requests) {
+    for(auto& children : _children) {
+      for(size_t i=0; i<width; i++) {
+        children.emplace([iterations](){ work(iterations); });
+      }
+    }
+  }
+
+  tf::Taskflow& children(size_t r) { return _children[r]; }
+
+  void enter() {
+    auto n = _num_active.fetch_add(1, std::memory_order_relaxed) + 1;
+    auto peak = _peak.load(std::memory_order_relaxed);
+    while(peak < n && !_peak.compare_exchange_weak(peak, n, std::memory_order_relaxed));
+  }
+
+  void leave() {
+    _num_active.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  size_t peak() const { return _peak.load(); }
+
+  private:
+
+  std::vector<tf::Taskflow> _children;
+  std::atomic<size_t> _num_active {0};
+  std::atomic<size_t> _peak {0};
+};
+
+template <typename C>
+Result measure(tf::Executor& executor, size_t num_requests, C&& make_task, Requests& requests) {
+
+  tf::Taskflow taskflow;
+
+  for(size_t r=0; r<num_requests; r++) {
+    taskflow.emplace(make_task(r));
+  }
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  executor.run(taskflow).wait();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  Result result;
+  result.ms = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e3;
+  result.peak = requests.peak();
+  return result;
+}
+
+Result measure_corun(
+  tf::Executor& executor, size_t num_requests, size_t num_stages, size_t width, size_t iterations
+) {
+  Requests requests(num_requests, width, iterations);
+  return measure(executor, num_requests, [&](size_t r){
+    return [&, r](tf::Runtime& rt){
+      requests.enter();
+      for(size_t s=0; s<num_stages; s++) {
+        rt.corun(requests.children(r));
+      }
+      requests.leave();
+    };
+  }, requests);
+}
+
+#if __cplusplus >= TF_CPP20
+Result measure_coroutine(
+  tf::Executor& executor, size_t num_requests, size_t num_stages, size_t width, size_t iterations
+) {
+  Requests requests(num_requests, width, iterations);
+  return measure(executor, num_requests, [&](size_t r){
+    return [&, r]() -> tf::Coro<void> {
+      requests.enter();
+      for(size_t s=0; s<num_stages; s++) {
+        co_await tf::corun(requests.children(r));
+      }
+      requests.leave();
+    };
+  }, requests);
+}
+#endif
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"Coroutines"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t num_requests {1000};
+  app.add_option("-n,--num_requests", num_requests, "number of requests (default=1000)");
+
+  size_t num_stages {8};
+  app.add_option("-s,--num_stages", num_stages, "number of fan-out stages per request (default=8)");
+
+  size_t max_width {256};
+  app.add_option("-w,--max_width", max_width, "maximum number of children per stage (default=256)");
+
+  size_t iterations {64};
+  app.add_option("-i,--iterations", iterations, "amount of work per child (default=64)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_requests=" << num_requests << ' '
+            << "num_stages=" << num_stages << ' '
+            << "max_width=" << max_width << ' '
+            << "iterations=" << iterations << ' '
+            << std::endl;
+
+#if __cplusplus >= TF_CPP20
+
+  tf::Executor executor(num_threads);
+
+  std::cout << std::setw(12) << "width"
+            << std::setw(16) << "corun (ms)"
+            << std::setw(12) << "peak"
+            << std::setw(16) << "coroutine (ms)"
+            << std::setw(12) << "peak"
+            << std::endl;
+
+  for(size_t width=1; width<=max_width; width*=2) {
+    auto corun = measure_corun(executor, num_requests, num_stages, width, iterations);
+    auto coroutine = measure_coroutine(executor, num_requests, num_stages, width, iterations);
+    std::cout << std::setw(12) << width
+              << std::setw(16) << corun.ms
+              << std::setw(12) << corun.peak
+              << std::setw(16) << coroutine.ms
+              << std::setw(12) << coroutine.peak
+              << std::endl;
+  }
+
+#else
+  std::cout << "coroutine tasks require C++20 (-DCMAKE_CXX_STANDARD=20)" << std::endl;
+#endif
+
+  return 0;
+}
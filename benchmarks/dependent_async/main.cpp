@@ -0,0 +1,135 @@
+// This benchmark stresses the registration of dependencies between
+// dependent async tasks, where the cost is dominated by linking successors
+// to their predecessors rather than by the tasks. It measures three graphs:
+//
+//   + fan-out: many submitter threads attach successors to the same hot
+//              predecessor at the same time, racing with the predecessor
+//              that finishes and spawns the successors linked so far
+//   + fan-in : one task depends on all the tasks of a wide layer
+//   + reduce : a binary reduction tree in which every task depends on
+//              its two children, built from the leaves up
+//
+// Each graph is built and run a number of rounds, and the benchmark
+// reports the runtime per round and the rate of dependencies per second.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+struct Result {
+  double ms {0};
+  double edges_per_sec {0};
+};
+
+template <typename F>
+Result measure(size_t num_rounds, size_t num_edges, F&& round) {
+  auto beg = std::chrono::high_resolution_clock::now();
+  for(size_t r=0; r<num_rounds; r++) {
+    round();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+  return {us / 1e3 / num_rounds, num_rounds * num_edges / (us / 1e6)};
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"DependentAsync"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t num_submitters {4};
+  app.add_option("-s,--num_submitters", num_submitters, "number of submitter threads (default=4)");
+
+  size_t width {100000};
+  app.add_option("-w,--width", width, "number of successors or predecessors per round (default=100000)");
+
+  size_t num_rounds {10};
+  app.add_option("-r,--num_rounds", num_rounds, "number of rounds (default=10)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_submitters=" << num_submitters << ' '
+            << "width=" << width << ' '
+            << "num_rounds=" << num_rounds << ' '
+            << std::endl;
+
+  tf::Executor executor(num_threads);
+
+  std::atomic<size_t> counter {0};
+
+  auto inc = [&](){ counter.fetch_add(1, std::memory_order_relaxed); };
+
+  // fan-out: submitters race to link successors to one hot predecessor,
+  // which finishes while the successors are still being linked
+  auto fan_out = [&](){
+    auto hot = executor.silent_dependent_async(inc);
+    std::vector<std::thread> submitters;
+    for(size_t s=0; s<num_submitters; s++) {
+      submitters.emplace_back([&, s](){
+        for(size_t i=s; i<width; i+=num_submitters) {
+          executor.silent_dependent_async(inc, hot);
+        }
+      });
+    }
+    for(auto& s : submitters) {
+      s.join();
+    }
+    executor.wait_for_all();
+  };
+
+  // fan-in: one task depends on a wide layer of tasks
+  auto fan_in = [&](){
+    std::vector<tf::AsyncTask> layer;
+    layer.reserve(width);
+    for(size_t i=0; i<width; i++) {
+      layer.push_back(executor.silent_dependent_async(inc));
+    }
+    executor.silent_dependent_async(inc, layer.begin(), layer.end());
+    executor.wait_for_all();
+  };
+
+  // reduce: a binary reduction tree over width leaves
+  auto reduce = [&](){
+    std::vector<tf::AsyncTask> level;
+    level.reserve(width);
+    for(size_t i=0; i<width; i++) {
+      level.push_back(executor.silent_dependent_async(inc));
+    }
+    while(level.size() > 1) {
+      std::vector<tf::AsyncTask> next;
+      next.reserve((level.size() + 1) / 2);
+      for(size_t i=0; i+1<level.size(); i+=2) {
+        next.push_back(executor.silent_dependent_async(inc, level[i], level[i+1]));
+      }
+      if(level.size() % 2) {
+        next.push_back(std::move(level.back()));
+      }
+      level = std::move(next);
+    }
+    executor.wait_for_all();
+  };
+
+  std::cout << std::setw(12) << "graph"
+            << std::setw(16) << "runtime (ms)"
+            << std::setw(20) << "edges (per sec)"
+            << std::endl;
+
+  auto report = [&](const char* graph, Result result) {
+    std::cout << std::setw(12) << graph
+              << std::setw(16) << result.ms
+              << std::setw(20) << static_cast<size_t>(result.edges_per_sec)
+              << std::endl;
+  };
+
+  report("fan-out", measure(num_rounds, width, fan_out));
+  report("fan-in", measure(num_rounds, width, fan_in));
+  report("reduce", measure(num_rounds, 2*(width - 1), reduce));
+
+  if(counter != num_rounds * (width + 1 + width + 1 + 2*width - 1)) {
+    throw std::runtime_error("incorrect result");
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+// This benchmark measures the rate at which threads outside an executor
+// submit tasks, which all go through the shared buffers of the executor.
+// For an increasing number of producer threads, it reports
+//
+//   + locked: a mutex-protected tf::UnboundedTaskQueue, which is how
+//     the shared buffers used to be implemented
+//   + injection: a tf::InjectionQueue, which the shared buffers use now
+//   + executor: tf::Executor::silent_async called by the producers
+//
+// In the two queue measurements, one consumer thread steals the items
+// while the producers push them.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+template <typename P>
+double measure(size_t num_producers, size_t num_items, P&& produce) {
+
+  std::vector<std::thread> producers;
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  for(size_t p=0; p<num_producers; p++) {
+    producers.emplace_back([&, p](){
+      produce(p, num_items);
+    });
+  }
+  for(auto& p : producers) {
+    p.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  auto sec = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+
+  return num_producers * num_items / sec;
+}
+
+// Function: consume
+// steals items from the queue until the given number of items is consumed
+template <typename Q>
+std::thread consume(Q& queue, size_t total) {
+  return std::thread([&queue, total](){
+    size_t consumed = 0;
+    while(consumed < total) {
+      if(queue.steal()) {
+        ++consumed;
+      }
+    }
+  });
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"ExternalProducers"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t max_producers {16};
+  app.add_option("-p,--max_producers", max_producers, "maximum number of producer threads (default=16)");
+
+  size_t num_items {100000};
+  app.add_option("-n,--num_items", num_items, "number of items per producer (default=100000)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "max_producers=" << max_producers << ' '
+            << "num_items=" << num_items << ' '
+            << std::endl;
+
+  tf::Executor executor(num_threads);
+
+  int item {0};
+  std::atomic<size_t> counter {0};
+  size_t num_tasks {0};
+
+  std::cout << std::setw(12) << "producers"
+            << std::setw(20) << "locked (items/s)"
+            << std::setw(20) << "injection (items/s)"
+            << std::setw(20) << "executor (tasks/s)"
+            << std::endl;
+
+  for(size_t P=1; P<=max_producers; P*=2) {
+
+    std::mutex mutex;
+    tf::UnboundedTaskQueue<int*> locked;
+    auto consumer = consume(locked, P*num_items);
+    auto l = measure(P, num_items, [&](size_t, size_t N){
+      for(size_t i=0; i<N; i++) {
+        std::scoped_lock lock(mutex);
+        locked.push(&item);
+      }
+    });
+    consumer.join();
+
+    tf::InjectionQueue<int*> injection;
+    consumer = consume(injection, P*num_items);
+    auto j = measure(P, num_items, [&](size_t, size_t N){
+      for(size_t i=0; i<N; i++) {
+        injection.push(&item);
+      }
+    });
+    consumer.join();
+
+    auto e = measure(P, num_items, [&](size_t, size_t N){
+      for(size_t i=0; i<N; i++) {
+        executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+    executor.wait_for_all();
+    num_tasks += P*num_items;
+
+    std::cout << std::setw(12) << P
+              << std::setw(20) << static_cast<size_t>(l)
+              << std::setw(20) << static_cast<size_t>(j)
+              << std::setw(20) << static_cast<size_t>(e)
+              << std::endl;
+  }
+
+  if(counter != num_tasks) {
+    throw std::runtime_error("incorrect result");
+  }
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+// This benchmark measures the cost of fanning out many independent tasks
+// from a running worker. It compares two ways of releasing the same number
+// of children:
+//
+//   + per_node: a task with N successors, which are released one by one,
+//     each with its own queue push and wake-up notification
+//   + batched : a subflow of N tasks, which are scheduled as one range
+//     using a bulk push to the worker queue and a single notification
+//
+// Each child performs a small amount of work such that the runtime is
+// dominated by the scheduling overhead.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+void work() {
+  volatile size_t sum = 0;
+  for(size_t k=0; k<64; k++) {
+    sum = sum + k;
+  }
+}
+
+double measure_per_node(tf::Executor& executor, size_t width, unsigned num_rounds) {
+
+  tf::Taskflow taskflow;
+
+  auto root = taskflow.emplace([](){});
+  auto sink = taskflow.emplace([](){});
+
+  for(size_t i=0; i<width; i++) {
+    taskflow.emplace([](){ work(); }).succeed(root).precede(sink);
+  }
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  executor.run_n(taskflow, num_rounds).wait();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e3;
+}
+
+double measure_batched(tf::Executor& executor, size_t width, unsigned num_rounds) {
+
+  tf::Taskflow taskflow;
+
+  taskflow.emplace([width](tf::Subflow& sf){
+    for(size_t i=0; i<width; i++) {
+      sf.emplace([](){ work(); });
+    }
+  });
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  executor.run_n(taskflow, num_rounds).wait();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e3;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"FanOut"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  unsigned num_rounds {100};
+  app.add_option("-r,--num_rounds", num_rounds, "number of rounds (default=100)");
+
+  size_t max_width {65536};
+  app.add_option("-w,--max_width", max_width, "maximum fan-out width (default=65536)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_rounds=" << num_rounds << ' '
+            << "max_width=" << max_width << ' '
+            << std::endl;
+
+  std::cout << std::setw(12) << "width"
+            << std::setw(16) << "per_node (ms)"
+            << std::setw(16) << "batched (ms)"
+            << std::setw(12) << "speedup"
+            << std::endl;
+
+  tf::Executor executor(num_threads);
+
+  for(size_t width=16; width<=max_width; width*=4) {
+
+    auto per_node = measure_per_node(executor, width, num_rounds);
+    auto batched  = measure_batched(executor, width, num_rounds);
+
+    std::cout << std::setw(12) << width
+              << std::setw(16) << per_node
+              << std::setw(16) << batched
+              << std::setw(12) << per_node / batched
+              << std::endl;
+  }
+
+  return 0;
+}
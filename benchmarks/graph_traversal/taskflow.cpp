@@ -29,8 +29,11 @@ struct TF {
     }
   }
 
-  void run() {
-    executor.run(taskflow).get();
+  void run(unsigned num_runs, bool compiled) {
+    if(compiled) {
+      taskflow.compile();
+    }
+    executor.run_n(taskflow, num_runs).get();
   }
 
   tf::Executor executor;
@@ -39,14 +42,18 @@ struct TF {
 
 };
 
-void traverse_level_graph_taskflow(LevelGraph& graph, unsigned num_threads){
+void traverse_level_graph_taskflow(
+  LevelGraph& graph, unsigned num_threads, unsigned num_runs, bool compiled
+){
   TF tf(graph, num_threads);
-  tf.run();
+  tf.run(num_runs, compiled);
 }
 
-std::chrono::microseconds measure_time_taskflow(LevelGraph& graph, unsigned num_threads){
+std::chrono::microseconds measure_time_taskflow(
+  LevelGraph& graph, unsigned num_threads, unsigned num_runs, bool compiled
+){
   auto beg = std::chrono::high_resolution_clock::now();
-  traverse_level_graph_taskflow(graph, num_threads);
+  traverse_level_graph_taskflow(graph, num_threads, num_runs, compiled);
   auto end = std::chrono::high_resolution_clock::now();
   return std::chrono::duration_cast<std::chrono::microseconds>(end - beg);
 }
@@ -61,9 +61,17 @@ int main(int argc, char* argv[]) {
 
   CLI11_PARSE(app, argc, argv);
 
+  // stealing strategy of the tf model, selected at compile time
+#if defined(TF_ENABLE_BATCH_STEALING)
+  std::string stealing = "batch";
+#else
+  std::string stealing = "single";
+#endif
+
   std::cout << "model=" << model << ' '
             << "num_threads=" << num_threads << ' '
             << "num_rounds=" << num_rounds << ' '
+            << "stealing=" << stealing << ' '
             << std::endl;
 
   linear_chain(model, log_length, num_threads, num_rounds);
@@ -0,0 +1,318 @@
+// This benchmark runs the notifiers the executor can be built with,
+// tf::AtomicNotifier (C++20 only), tf::NonblockingNotifierV1, and
+// tf::NonblockingNotifierV2, under the same scenarios for 1, 2, 4, ...,
+// max_workers waiting threads
+//
+//   + notify_one: latency from notify_one until one parked thread
+//     takes the token
+//   + notify_n: latency from notify_n(k) until the last of k parked
+//     threads takes its token
+//   + herd: latency from notify_all with a single token until all
+//     threads are parked again (the cost of a thundering herd)
+//   + churn: throughput of prepare_wait/cancel_wait pairs while
+//     another thread keeps calling notify_one
+//
+// Each row reports the p50 and p99 latency in nanoseconds (zero for churn),
+// the throughput in operations per second (the reciprocal of the mean
+// latency for the latency scenarios), and the number of threads returning
+// from commit_wait per notification, which exposes excess wakeups.
+// The results are printed as CSV or JSON for further processing.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+struct Result {
+  const char* notifier {nullptr};
+  const char* scenario {nullptr};
+  size_t workers {0};
+  size_t samples {0};
+  double p50 {0};
+  double p99 {0};
+  double throughput {0};
+  double wakeups {0};
+};
+
+inline int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+// Class: Waiters
+// W threads that park on the notifier until a token is available,
+// following the protocol of the executor's scheduling loop
+template <typename N>
+class Waiters {
+
+  public:
+
+  explicit Waiters(size_t W) : _notifier(W) {
+    for(size_t i=0; i<W; i++) {
+      _threads.emplace_back([this, i](){ _loop(_notifier.waiter(i)); });
+    }
+  }
+
+  ~Waiters() {
+    _stop.store(true, std::memory_order_relaxed);
+    _notifier.notify_all();
+    for(auto& t : _threads) {
+      t.join();
+    }
+  }
+
+  N& notifier() { return _notifier; }
+
+  // waits until all threads are about to commit their wait and then
+  // gives them the delay to actually park
+  void wait_parked(std::chrono::microseconds delay) {
+    while(_num_parked.load() != _threads.size()) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(delay);
+  }
+
+  // publishes the tokens and returns the time of the publication
+  int64_t publish(size_t num_tokens) {
+    _num_taken.store(0, std::memory_order_relaxed);
+    _last.store(0, std::memory_order_relaxed);
+    auto stamp = now_ns();
+    _tokens.fetch_add(num_tokens);
+    return stamp;
+  }
+
+  // waits until the given number of tokens is taken and returns the time
+  // the last one was taken
+  int64_t wait_taken(size_t num_tokens) {
+    while(_num_taken.load() != num_tokens) {
+      std::this_thread::yield();
+    }
+    return _last.load();
+  }
+
+  size_t num_wakeups() const { return _num_wakeups.load(); }
+
+  private:
+
+  N _notifier;
+
+  std::atomic<bool> _stop {false};
+  std::atomic<size_t> _tokens {0};
+  std::atomic<size_t> _num_taken {0};
+  std::atomic<size_t> _num_parked {0};
+  std::atomic<size_t> _num_wakeups {0};
+  std::atomic<int64_t> _last {0};
+
+  std::vector<std::thread> _threads;
+
+  bool _take() {
+    auto t = _tokens.load(std::memory_order_relaxed);
+    while(t && !_tokens.compare_exchange_weak(t, t-1));
+    if(t == 0) {
+      return false;
+    }
+    auto stamp = now_ns();
+    auto last = _last.load(std::memory_order_relaxed);
+    while(last < stamp && !_last.compare_exchange_weak(last, stamp));
+    _num_taken.fetch_add(1);
+    return true;
+  }
+
+  void _loop(typename N::Waiter* w) {
+    while(!_stop.load(std::memory_order_relaxed)) {
+      if(_take()) {
+        continue;
+      }
+      _notifier.prepare_wait(w);
+      if(_stop.load() || _tokens.load() != 0) {
+        _notifier.cancel_wait(w);
+        continue;
+      }
+      _num_parked.fetch_add(1);
+      _notifier.commit_wait(w);
+      _num_parked.fetch_sub(1);
+      _num_wakeups.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+// Function: summarize
+// sorts the latency samples and fills in the percentiles of the result
+Result summarize(
+  const char* notifier, const char* scenario, size_t W,
+  std::vector<double>& latencies, size_t num_wakeups
+) {
+  std::sort(latencies.begin(), latencies.end());
+  Result r;
+  r.notifier = notifier;
+  r.scenario = scenario;
+  r.workers = W;
+  r.samples = latencies.size();
+  r.p50 = latencies[latencies.size() / 2];
+  r.p99 = latencies[latencies.size() * 99 / 100];
+  r.throughput = 1e9 * latencies.size() /
+                 std::accumulate(latencies.begin(), latencies.end(), 0.0);
+  r.wakeups = static_cast<double>(num_wakeups) / latencies.size();
+  return r;
+}
+
+template <typename N>
+Result notify_one(
+  const char* name, size_t W, size_t num_rounds, std::chrono::microseconds delay
+) {
+  Waiters<N> waiters(W);
+  std::vector<double> latencies(num_rounds);
+  for(size_t r=0; r<num_rounds; r++) {
+    waiters.wait_parked(delay);
+    auto beg = waiters.publish(1);
+    waiters.notifier().notify_one();
+    latencies[r] = waiters.wait_taken(1) - beg;
+  }
+  return summarize(name, "notify_one", W, latencies, waiters.num_wakeups());
+}
+
+template <typename N>
+Result notify_n(
+  const char* name, size_t W, size_t burst, size_t num_rounds, std::chrono::microseconds delay
+) {
+  Waiters<N> waiters(W);
+  std::vector<double> latencies(num_rounds);
+  auto k = std::min(burst, W);
+  for(size_t r=0; r<num_rounds; r++) {
+    waiters.wait_parked(delay);
+    auto beg = waiters.publish(k);
+    waiters.notifier().notify_n(k);
+    latencies[r] = waiters.wait_taken(k) - beg;
+  }
+  return summarize(name, "notify_n", W, latencies, waiters.num_wakeups());
+}
+
+template <typename N>
+Result herd(
+  const char* name, size_t W, size_t num_rounds, std::chrono::microseconds delay
+) {
+  Waiters<N> waiters(W);
+  std::vector<double> latencies(num_rounds);
+  for(size_t r=0; r<num_rounds; r++) {
+    waiters.wait_parked(delay);
+    auto beg = waiters.publish(1);
+    waiters.notifier().notify_all();
+    waiters.wait_taken(1);
+    // the herd has settled once every thread is about to park again
+    waiters.wait_parked(std::chrono::microseconds(0));
+    latencies[r] = now_ns() - beg;
+  }
+  return summarize(name, "herd", W, latencies, waiters.num_wakeups());
+}
+
+template <typename N>
+Result churn(const char* name, size_t W, size_t num_ops) {
+
+  N notifier(W);
+  std::atomic<size_t> num_done {0};
+  std::vector<std::thread> threads;
+
+  auto beg = now_ns();
+  for(size_t i=0; i<W; i++) {
+    threads.emplace_back([&, i](){
+      auto w = notifier.waiter(i);
+      for(size_t k=0; k<num_ops; k++) {
+        notifier.prepare_wait(w);
+        notifier.cancel_wait(w);
+      }
+      num_done.fetch_add(1);
+    });
+  }
+  while(num_done.load() != W) {
+    notifier.notify_one();
+  }
+  auto end = now_ns();
+
+  for(auto& t : threads) {
+    t.join();
+  }
+
+  Result r;
+  r.notifier = name;
+  r.scenario = "churn";
+  r.workers = W;
+  r.samples = W * num_ops;
+  r.throughput = 1e9 * r.samples / (end - beg);
+  return r;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"Notifiers"};
+
+  size_t max_workers {std::thread::hardware_concurrency()};
+  app.add_option("-w,--max_workers", max_workers, "maximum number of waiting threads (default=hardware concurrency)");
+
+  size_t num_rounds {1000};
+  app.add_option("-r,--num_rounds", num_rounds, "number of notifications per latency measurement (default=1000)");
+
+  size_t num_ops {100000};
+  app.add_option("-n,--num_ops", num_ops, "number of prepare/cancel pairs per thread in churn (default=100000)");
+
+  size_t burst {4};
+  app.add_option("-k,--burst", burst, "number of threads notified by notify_n (default=4)");
+
+  size_t delay {50};
+  app.add_option("-d,--delay", delay, "time given to the threads to park in us (default=50)");
+
+  std::string format {"csv"};
+  app.add_option("-f,--format", format, "output format (default=csv)")
+     ->check(CLI::IsMember({"csv", "json"}));
+
+  CLI11_PARSE(app, argc, argv);
+
+  max_workers = std::max(max_workers, size_t{1});
+  num_rounds = std::max(num_rounds, size_t{1});
+  burst = std::max(burst, size_t{1});
+
+  auto us = std::chrono::microseconds(delay);
+
+  std::vector<Result> results;
+
+  auto measure = [&](const char* name, auto tag) {
+    using N = std::remove_pointer_t<decltype(tag)>;
+    for(size_t W=1; W<=max_workers; W*=2) {
+      results.push_back(notify_one<N>(name, W, num_rounds, us));
+      results.push_back(notify_n<N>(name, W, burst, num_rounds, us));
+      results.push_back(herd<N>(name, W, num_rounds, us));
+      results.push_back(churn<N>(name, W, num_ops));
+    }
+  };
+
+#if __cplusplus >= TF_CPP20
+  measure("atomic", static_cast<tf::AtomicNotifier*>(nullptr));
+#endif
+  measure("nonblocking_v1", static_cast<tf::NonblockingNotifierV1*>(nullptr));
+  measure("nonblocking_v2", static_cast<tf::NonblockingNotifierV2*>(nullptr));
+
+  if(format == "json") {
+    std::cout << "[\n";
+    for(size_t i=0; i<results.size(); i++) {
+      auto& r = results[i];
+      std::cout << "  {\"notifier\": \"" << r.notifier << "\", "
+                << "\"scenario\": \"" << r.scenario << "\", "
+                << "\"workers\": " << r.workers << ", "
+                << "\"samples\": " << r.samples << ", "
+                << "\"p50_ns\": " << r.p50 << ", "
+                << "\"p99_ns\": " << r.p99 << ", "
+                << "\"ops_per_sec\": " << r.throughput << ", "
+                << "\"wakeups\": " << r.wakeups << '}'
+                << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    std::cout << "]\n";
+  }
+  else {
+    std::cout << "notifier,scenario,workers,samples,p50_ns,p99_ns,ops_per_sec,wakeups\n";
+    for(auto& r : results) {
+      std::cout << r.notifier << ',' << r.scenario << ',' << r.workers << ','
+                << r.samples << ',' << r.p50 << ',' << r.p99 << ','
+                << r.throughput << ',' << r.wakeups << '\n';
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,117 @@
+// This benchmark measures the trade-off between the wake-up latency of idle
+// workers and the CPU time they burn under different spin policies.
+// The main thread submits one task at a time with a fixed gap in between,
+// which leaves the workers idle most of the time.
+// Each task records the latency between its submission and the start of
+// its execution (wake latency), and the benchmark reports the CPU time of
+// the process divided by the wall time (busy cores).
+// The busy-poll policy keeps the given number of workers polling the queues,
+// which never sleep and thus avoid the futex wake-up of the notifier.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+#include <ctime>
+
+struct Result {
+  double p50 {0};
+  double p99 {0};
+  double busy_cores {0};
+};
+
+Result measure(
+  std::shared_ptr<tf::SpinPolicy> policy,
+  unsigned num_threads,
+  size_t num_tasks,
+  std::chrono::microseconds gap
+) {
+
+  tf::Executor executor(num_threads, nullptr, std::move(policy));
+
+  std::vector<double> latencies(num_tasks);
+
+  auto cpu_beg = std::clock();
+  auto beg = std::chrono::steady_clock::now();
+
+  for(size_t i=0; i<num_tasks; i++) {
+    auto submit = std::chrono::steady_clock::now();
+    executor.silent_async([&latencies, i, submit](){
+      latencies[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - submit
+      ).count() / 1e3;
+    });
+    // busy-wait for precise gaps since sleep_for oversleeps by tens of us
+    while(std::chrono::steady_clock::now() - submit < gap);
+  }
+  executor.wait_for_all();
+
+  auto end = std::chrono::steady_clock::now();
+  auto cpu_end = std::clock();
+
+  std::sort(latencies.begin(), latencies.end());
+
+  Result result;
+  result.p50 = latencies[latencies.size() / 2];
+  result.p99 = latencies[latencies.size() * 99 / 100];
+
+  // exclude the submitting thread, which always spins
+  auto wall = std::chrono::duration<double>(end - beg).count();
+  auto cpu = static_cast<double>(cpu_end - cpu_beg) / CLOCKS_PER_SEC;
+  result.busy_cores = cpu / wall - 1;
+
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"SpinPolicy"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t num_tasks {1000};
+  app.add_option("-n,--num_tasks", num_tasks, "number of tasks per gap (default=1000)");
+
+  size_t max_gap {10000};
+  app.add_option("-g,--max_gap", max_gap, "maximum gap between two tasks in us (default=10000)");
+
+  size_t num_pollers {1};
+  app.add_option("-k,--num_pollers", num_pollers, "number of polling workers of the busy-poll policy (default=1)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_tasks=" << num_tasks << ' '
+            << "max_gap=" << max_gap << ' '
+            << "num_pollers=" << num_pollers << ' '
+            << std::endl;
+
+  std::cout << std::setw(10) << "gap (us)"
+            << std::setw(12) << "policy"
+            << std::setw(12) << "p50 (us)"
+            << std::setw(12) << "p99 (us)"
+            << std::setw(14) << "busy_cores"
+            << std::endl;
+
+  for(size_t gap=10; gap<=max_gap; gap*=10) {
+
+    std::pair<const char*, std::shared_ptr<tf::SpinPolicy>> policies[] = {
+      {"default",  nullptr},
+      {"sleepy",   std::make_shared<tf::FixedSpinPolicy>(1, 0)},
+      {"spinny",   std::make_shared<tf::FixedSpinPolicy>(64, 100000)},
+      {"adaptive", std::make_shared<tf::AdaptiveSpinPolicy>()},
+      {"busy-poll", std::make_shared<tf::BusyPollSpinPolicy>(num_pollers)}
+    };
+
+    for(auto& [name, policy] : policies) {
+      auto result = measure(policy, num_threads, num_tasks, std::chrono::microseconds(gap));
+      std::cout << std::setw(10) << gap
+                << std::setw(12) << name
+                << std::setw(12) << result.p50
+                << std::setw(12) << result.p99
+                << std::setw(14) << result.busy_cores
+                << std::endl;
+    }
+  }
+
+  return 0;
+}
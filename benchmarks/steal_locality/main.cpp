@@ -0,0 +1,156 @@
+// This benchmark measures the locality of work stealing under the flat
+// (uniformly random) and the hierarchical (topology-aware) victim selection.
+// Each task in a binary tree records the worker that runs it, and we count
+// how often a child task runs within the same L3 domain or the same NUMA
+// node as its parent. A child that runs elsewhere must have been stolen
+// across the corresponding domain.
+//
+// By default, the topology of the running machine is used. Use --l3 and
+// --numa to emulate a machine of the given number of domains, which is
+// useful for reasoning about the policy on a single-socket box.
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+tf::CPUTopology make_topology(unsigned num_threads, unsigned num_l3, unsigned num_numa) {
+
+  if(num_l3 == 0 && num_numa == 0) {
+    return tf::CPUTopology::system();
+  }
+
+  num_l3 = std::max(num_l3, num_numa);
+  num_numa = std::max(num_numa, 1u);
+
+  std::vector<tf::CPUTopology::CPU> cpus(num_threads);
+  for(unsigned i=0; i<num_threads; i++) {
+    size_t l3 = i * num_l3 / num_threads;
+    cpus[i].l3 = l3;
+    cpus[i].numa = l3 * num_numa / num_l3;
+  }
+  return tf::CPUTopology(std::move(cpus));
+}
+
+struct Result {
+  double runtime {0};
+  size_t same_worker {0};
+  size_t same_l3 {0};
+  size_t same_numa {0};
+  size_t remote {0};
+};
+
+void measure(
+  Result& result,
+  tf::Executor& executor,
+  const tf::CPUTopology& topology,
+  size_t num_layers
+) {
+
+  tf::Taskflow taskflow;
+
+  std::vector<tf::Task> tasks(size_t{1} << num_layers);
+  std::vector<int> workers(tasks.size(), -1);
+
+  for(size_t i=1; i<tasks.size(); i++) {
+    tasks[i] = taskflow.emplace([&, i](){
+      workers[i] = executor.this_worker_id();
+      // a small amount of work to keep the queues populated
+      volatile size_t sum = 0;
+      for(size_t k=0; k<256; k++) {
+        sum = sum + k;
+      }
+    });
+  }
+
+  for(size_t i=1; i<tasks.size(); i++) {
+    size_t l = i << 1;
+    size_t r = l + 1;
+    if(r < tasks.size()) {
+      tasks[i].precede(tasks[l], tasks[r]);
+    }
+  }
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  executor.run(taskflow).wait();
+  auto end = std::chrono::high_resolution_clock::now();
+
+  result.runtime += std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count();
+
+  for(size_t i=2; i<tasks.size(); i++) {
+    auto p = static_cast<size_t>(workers[i/2]);
+    auto c = static_cast<size_t>(workers[i]);
+    if(p == c) {
+      result.same_worker++;
+    }
+    else switch(topology.distance(p, c)) {
+      case 0: result.same_l3++; break;
+      case 1: result.same_numa++; break;
+      default: result.remote++; break;
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"StealLocality"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  unsigned num_rounds {1};
+  app.add_option("-r,--num_rounds", num_rounds, "number of rounds (default=1)");
+
+  size_t num_layers {18};
+  app.add_option("-l,--num_layers", num_layers, "number of tree layers (default=18)");
+
+  unsigned num_l3 {0};
+  app.add_option("--l3", num_l3, "number of emulated L3 domains (default=system topology)");
+
+  unsigned num_numa {0};
+  app.add_option("--numa", num_numa, "number of emulated NUMA nodes (default=system topology)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  auto topology = make_topology(num_threads, num_l3, num_numa);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_rounds=" << num_rounds << ' '
+            << "num_layers=" << num_layers << ' '
+            << "num_cpus=" << topology.num_cpus() << ' '
+            << std::endl;
+
+  std::cout << std::setw(14) << "policy"
+            << std::setw(12) << "runtime"
+            << std::setw(14) << "same_worker"
+            << std::setw(12) << "same_l3"
+            << std::setw(12) << "same_numa"
+            << std::setw(12) << "remote"
+            << std::endl;
+
+  // the flat policy is an empty topology, while the locality is still
+  // classified against the real (or emulated) topology
+  for(auto policy : {"flat", "hierarchical"}) {
+
+    tf::Executor executor(
+      num_threads, std::string(policy) == "flat" ? tf::CPUTopology() : topology
+    );
+
+    Result result;
+    for(unsigned r=0; r<num_rounds; r++) {
+      measure(result, executor, topology, num_layers);
+    }
+
+    auto total = static_cast<double>(
+      result.same_worker + result.same_l3 + result.same_numa + result.remote
+    );
+
+    std::cout << std::setw(14) << policy
+              << std::setw(12) << result.runtime / num_rounds / 1e3
+              << std::setw(14) << result.same_worker / total
+              << std::setw(12) << result.same_l3 / total
+              << std::setw(12) << result.same_numa / total
+              << std::setw(12) << result.remote / total
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,148 @@
+// This benchmark measures the rate at which an executor runs tiny taskflows,
+// where the cost of a run is dominated by the bookkeeping of the submission
+// rather than the tasks. It compares the two ways to wait for a run:
+//
+//   + future: tf::Executor::run, which completes a std::promise and
+//     returns a tf::Future
+//   + handle: tf::Executor::submit, which completes an atomic flag in
+//     the topology and returns a tf::RunHandle
+//
+// Each submitter thread either waits for every run before submitting the
+// next one (sync) or submits a batch of runs before waiting for all of
+// them (batch).
+
+#include <taskflow/taskflow.hpp>
+#include <CLI11.hpp>
+
+template <typename S>
+double measure(size_t num_submitters, size_t num_runs, size_t batch, S&& submit) {
+
+  std::vector<std::thread> submitters;
+
+  auto beg = std::chrono::high_resolution_clock::now();
+  for(size_t s=0; s<num_submitters; s++) {
+    submitters.emplace_back([&](){
+      submit(num_runs, batch);
+    });
+  }
+  for(auto& s : submitters) {
+    s.join();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  auto sec = std::chrono::duration_cast<std::chrono::microseconds>(end - beg).count() / 1e6;
+
+  return num_submitters * num_runs / sec;
+}
+
+int main(int argc, char* argv[]) {
+
+  CLI::App app{"TinyRuns"};
+
+  unsigned num_threads {std::thread::hardware_concurrency()};
+  app.add_option("-t,--num_threads", num_threads, "number of threads (default=hardware concurrency)");
+
+  size_t num_submitters {1};
+  app.add_option("-s,--num_submitters", num_submitters, "number of submitter threads (default=1)");
+
+  size_t num_runs {200000};
+  app.add_option("-n,--num_runs", num_runs, "number of runs per submitter (default=200000)");
+
+  size_t num_tasks {1};
+  app.add_option("-k,--num_tasks", num_tasks, "number of tasks per taskflow (default=1)");
+
+  size_t batch {64};
+  app.add_option("-b,--batch", batch, "number of runs per batch (default=64)");
+
+  CLI11_PARSE(app, argc, argv);
+
+  std::cout << "num_threads=" << num_threads << ' '
+            << "num_submitters=" << num_submitters << ' '
+            << "num_runs=" << num_runs << ' '
+            << "num_tasks=" << num_tasks << ' '
+            << "batch=" << batch << ' '
+            << std::endl;
+
+  tf::Executor executor(num_threads);
+
+  // one tiny taskflow per submitter such that runs do not queue up
+  // behind the runs of other submitters
+  std::vector<tf::Taskflow> taskflows(num_submitters);
+  std::atomic<size_t> counter {0};
+  for(auto& taskflow : taskflows) {
+    for(size_t k=0; k<num_tasks; k++) {
+      taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+  }
+  std::atomic<size_t> next {0};
+
+  auto future_sync = [&](size_t N, size_t) {
+    auto& taskflow = taskflows[next++ % num_submitters];
+    for(size_t i=0; i<N; i++) {
+      executor.run(taskflow).wait();
+    }
+  };
+
+  auto handle_sync = [&](size_t N, size_t) {
+    auto& taskflow = taskflows[next++ % num_submitters];
+    for(size_t i=0; i<N; i++) {
+      executor.submit(taskflow).wait();
+    }
+  };
+
+  auto future_batch = [&](size_t N, size_t B) {
+    auto& taskflow = taskflows[next++ % num_submitters];
+    std::vector<tf::Future<void>> futures;
+    for(size_t i=0; i<N; i+=B) {
+      for(size_t b=0; b<B && i+b<N; b++) {
+        futures.push_back(executor.run(taskflow));
+      }
+      for(auto& fu : futures) {
+        fu.wait();
+      }
+      futures.clear();
+    }
+  };
+
+  auto handle_batch = [&](size_t N, size_t B) {
+    auto& taskflow = taskflows[next++ % num_submitters];
+    std::vector<tf::RunHandle> handles;
+    for(size_t i=0; i<N; i+=B) {
+      for(size_t b=0; b<B && i+b<N; b++) {
+        handles.push_back(executor.submit(taskflow));
+      }
+      for(auto& h : handles) {
+        h.wait();
+      }
+      handles.clear();
+    }
+  };
+
+  std::cout << std::setw(12) << "mode"
+            << std::setw(18) << "future (runs/s)"
+            << std::setw(18) << "handle (runs/s)"
+            << std::setw(12) << "speedup"
+            << std::endl;
+
+  auto report = [&](const char* mode, double future, double handle) {
+    std::cout << std::setw(12) << mode
+              << std::setw(18) << static_cast<size_t>(future)
+              << std::setw(18) << static_cast<size_t>(handle)
+              << std::setw(12) << handle / future
+              << std::endl;
+  };
+
+  auto fs = measure(num_submitters, num_runs, batch, future_sync);
+  auto hs = measure(num_submitters, num_runs, batch, handle_sync);
+  report("sync", fs, hs);
+
+  auto fb = measure(num_submitters, num_runs, batch, future_batch);
+  auto hb = measure(num_submitters, num_runs, batch, handle_batch);
+  report("batch", fb, hb);
+
+  if(counter != 4 * num_submitters * num_runs * num_tasks) {
+    throw std::runtime_error("incorrect result");
+  }
+
+  return 0;
+}
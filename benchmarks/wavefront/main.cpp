@@ -11,7 +11,8 @@ double **matrix = nullptr;
 void wavefront(
   const std::string& model,
   const unsigned num_threads,
-  const unsigned num_rounds
+  const unsigned num_rounds,
+  const unsigned num_runs
   ) {
 
   std::cout << std::setw(12) << "size"
@@ -30,8 +31,8 @@ void wavefront(
     init_matrix();
 
     for(unsigned j=0; j<num_rounds; ++j) {
-      if(model == "tf") {
-        runtime += measure_time_taskflow(num_threads).count();
+      if(model == "tf" || model == "tf-compiled") {
+        runtime += measure_time_taskflow(num_threads, num_runs, model == "tf-compiled").count();
       }
       else if(model == "tbb") {
         runtime += measure_time_tbb(num_threads).count();
@@ -60,11 +61,17 @@ int main(int argc, char* argv[]) {
   unsigned num_rounds {1};
   app.add_option("-r,--num_rounds", num_rounds, "number of rounds (default=1)");
 
+  unsigned num_runs {1};
+  app.add_option(
+    "-n,--num_runs", num_runs, 
+    "number of runs of each taskflow graph (default=1)"
+  );
+
   std::string model = "tf";
-  app.add_option("-m,--model", model, "model name tbb|omp|tf (default=tf)")
+  app.add_option("-m,--model", model, "model name tbb|omp|tf|tf-compiled (default=tf)")
      ->check([] (const std::string& m) {
-        if(m != "tbb" && m != "omp" && m != "tf") {
-          return "model name should be \"tbb\", \"omp\", or \"tf\"";
+        if(m != "tbb" && m != "omp" && m != "tf" && m != "tf-compiled") {
+          return "model name should be \"tbb\", \"omp\", \"tf\", or \"tf-compiled\"";
         }
         return "";
      });
@@ -74,9 +81,10 @@ int main(int argc, char* argv[]) {
   std::cout << "model=" << model << ' '
             << "num_threads=" << num_threads << ' '
             << "num_rounds=" << num_rounds << ' '
+            << "num_runs=" << num_runs << ' '
             << std::endl;
 
-  wavefront(model, num_threads, num_rounds);
+  wavefront(model, num_threads, num_rounds, num_runs);
 
   return 0;
 }
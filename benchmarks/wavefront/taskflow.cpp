@@ -2,7 +2,7 @@
 #include <taskflow/taskflow.hpp>
 
 // wavefront computing
-void wavefront_taskflow(unsigned num_threads) {
+void wavefront_taskflow(unsigned num_threads, unsigned num_runs, bool compiled) {
 
   static tf::Executor executor(num_threads);
   tf::Taskflow taskflow;
@@ -29,12 +29,18 @@ void wavefront_taskflow(unsigned num_threads) {
     }
   }
 
-  executor.run(taskflow).get();
+  if(compiled) {
+    taskflow.compile();
+  }
+
+  executor.run_n(taskflow, num_runs).get();
 }
 
-std::chrono::microseconds measure_time_taskflow(unsigned num_threads) {
+std::chrono::microseconds measure_time_taskflow(
+  unsigned num_threads, unsigned num_runs, bool compiled
+) {
   auto beg = std::chrono::high_resolution_clock::now();
-  wavefront_taskflow(num_threads);
+  wavefront_taskflow(num_threads, num_runs, compiled);
   auto end = std::chrono::high_resolution_clock::now();
   return std::chrono::duration_cast<std::chrono::microseconds>(end - beg);
 }
@@ -1,11 +1,87 @@
 #pragma once
 
-#include "executor.hpp"
+#include "coroutine.hpp"
 
 // https://hackmd.io/@sysprog/concurrency-atomics
 
 namespace tf {
 
+// ----------------------------------------------------------------------------
+// Class Definition: AsyncPromise
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief class to carry out the promise of an async task
+
+Under C++20, the promise also resumes the coroutines awaiting the tf::Future
+of the task once it is carried out or broken, such that the future does
+not need to be checked by the executor.
+*/
+template <typename P>
+class AsyncPromise {
+
+  public:
+
+  template <typename T>
+  AsyncPromise(P&& p, [[maybe_unused]] Future<T>& fu) : _p {std::move(p)} {
+#if __cplusplus >= TF_CPP20
+    _awaiters = std::allocate_shared<FutureAwaiters>(FutureAwaitersAllocator());
+    fu._awaiters = _awaiters;
+#endif
+  }
+
+  AsyncPromise(AsyncPromise&&) = default;
+
+#if __cplusplus >= TF_CPP20
+  // an async task that never runs breaks its promise
+  ~AsyncPromise() {
+    if(_awaiters) {
+      _p.reset();
+      Executor::_resume_awaiters(*_awaiters);
+    }
+  }
+#endif
+
+  template <typename... Ts>
+  void operator ()(Ts&&... ts) {
+    _promise()(std::forward<Ts>(ts)...);
+    _resume();
+  }
+
+  template <typename... Ts>
+  void set_value(Ts&&... ts) {
+    _promise().set_value(std::forward<Ts>(ts)...);
+    _resume();
+  }
+
+  void set_exception(std::exception_ptr e) {
+    _promise().set_exception(e);
+    _resume();
+  }
+
+  private:
+
+#if __cplusplus >= TF_CPP20
+  std::optional<P> _p;
+  std::shared_ptr<FutureAwaiters> _awaiters;
+
+  P& _promise() { return *_p; }
+
+  void _resume() {
+    Executor::_resume_awaiters(*_awaiters);
+    _awaiters.reset();
+  }
+#else
+  P _p;
+
+  P& _promise() { return _p; }
+
+  void _resume() {}
+#endif
+};
+
 // ----------------------------------------------------------------------------
 // Async Helper Methods
 // ----------------------------------------------------------------------------
@@ -54,39 +130,81 @@ auto Executor::async(F&& f) {
 // Function: _async
 template <typename P, typename F>
 auto Executor::_async(P&& params, F&& f, Topology* tpg, Node* parent) {
+  auto [node, fu] = _animate_async(std::forward<P>(params), std::forward<F>(f), tpg, parent);
+  _schedule_async_task(node);
+  return std::move(fu);
+}
+
+// Function: _animate_async
+// creates the node of an async task and the future of its result
+template <typename P, typename F>
+auto Executor::_animate_async(P&& params, F&& f, Topology* tpg, Node* parent) {
+
+#if __cplusplus >= TF_CPP20
+  // coroutine task: [] () -> tf::Coro<T> { ... co_return ... }
+  // the wrapping coroutine carries the result of the coroutine to the future
+  if constexpr (is_coroutine_task_v<F>) {
+
+    using R = typename std::invoke_result_t<F>::value_type;
+
+    std::promise<R> p;
+    tf::Future<R> fu(p.get_future(), this);
+
+    auto node = animate(
+      NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), tpg, parent, 0,
+      std::in_place_type_t<Node::Async>{},
+      Node::Coroutine([p=AsyncPromise(std::move(p), fu), f=std::forward<F>(f)]() mutable -> Coro<void> {
+        try {
+          if constexpr (std::is_void_v<R>) {
+            co_await f();
+            p.set_value();
+          }
+          else {
+            p.set_value(co_await f());
+          }
+        }
+        catch(...) {
+          p.set_exception(std::current_exception());
+        }
+      })
+    );
+    return std::make_pair(node, std::move(fu));
+  }
+  else
+#endif
   
   // async task with runtime: [] (tf::Runtime&) -> void {}
   if constexpr (is_runtime_task_v<F>) {
 
     std::promise<void> p;
-    auto fu{p.get_future()};
+    tf::Future<void> fu(p.get_future(), this);
     
-    _schedule_async_task(animate(
+    auto node = animate(
       NSTATE::NONE, ESTATE::ANCHORED, std::forward<P>(params), tpg, parent, 0, 
       std::in_place_type_t<Node::Async>{}, 
-      [p=MoC{std::move(p)}, f=std::forward<F>(f)](Runtime& rt, bool reentered) mutable { 
+      [p=AsyncPromise(std::move(p), fu), f=std::forward<F>(f)](Runtime& rt, bool reentered) mutable { 
         if(!reentered) {
           f(rt);
         }
         else {
           auto& eptr = rt._parent->_exception_ptr;
-          eptr ? p.object.set_exception(eptr) : p.object.set_value();
+          eptr ? p.set_exception(eptr) : p.set_value();
         }
       }
-    ));
-    return fu;
+    );
+    return std::make_pair(node, std::move(fu));
   }
   // async task with closure: [] () -> auto { return ... }
   else if constexpr (std::is_invocable_v<F>){
     using R = std::invoke_result_t<F>;
     std::packaged_task<R()> p(std::forward<F>(f));
-    auto fu{p.get_future()};
-    _schedule_async_task(animate(
+    tf::Future<R> fu(p.get_future(), this);
+    auto node = animate(
       NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), tpg, parent, 0, 
       std::in_place_type_t<Node::Async>{}, 
-      [p=make_moc(std::move(p))]() mutable { p.object(); }
-    ));
-    return fu;
+      [p=AsyncPromise(std::move(p), fu)]() mutable { p(); }
+    );
+    return std::make_pair(node, std::move(fu));
   }
   else {
     static_assert(dependent_false_v<F>, 
@@ -98,6 +216,57 @@ auto Executor::_async(P&& params, F&& f, Topology* tpg, Node* parent) {
 }
 
 
+// ----------------------------------------------------------------------------
+// Timed Async
+// ----------------------------------------------------------------------------
+
+// Function: async_at
+template <typename P, typename C, typename D, typename F>
+auto Executor::async_at(P&& params, const std::chrono::time_point<C, D>& tp, F&& f) {
+  
+  _increment_topology();
+
+  auto [node, fu] = _animate_async(std::forward<P>(params), std::forward<F>(f), nullptr, nullptr);
+  
+  // time points of other clocks are taken relative to now
+  std::chrono::steady_clock::time_point deadline;
+  if constexpr (std::is_same_v<C, std::chrono::steady_clock>) {
+    deadline = _time_after(std::chrono::steady_clock::time_point(), tp.time_since_epoch());
+  }
+  else {
+    deadline = _time_after(std::chrono::steady_clock::now(), tp - C::now());
+  }
+
+  if(deadline <= std::chrono::steady_clock::now()) {
+    _schedule_async_task(node);
+  }
+  else {
+    _insert_timer(_timer_tick(deadline), Timer{node, nullptr});
+  }
+
+  return std::move(fu);
+}
+
+// Function: async_at
+template <typename C, typename D, typename F>
+auto Executor::async_at(const std::chrono::time_point<C, D>& tp, F&& f) {
+  return async_at(DefaultTaskParams{}, tp, std::forward<F>(f));
+}
+
+// Function: async_after
+template <typename P, typename R, typename T, typename F>
+auto Executor::async_after(P&& params, const std::chrono::duration<R, T>& delay, F&& f) {
+  return async_at(
+    std::forward<P>(params), _time_after(std::chrono::steady_clock::now(), delay), std::forward<F>(f)
+  );
+}
+
+// Function: async_after
+template <typename R, typename T, typename F>
+auto Executor::async_after(const std::chrono::duration<R, T>& delay, F&& f) {
+  return async_at(DefaultTaskParams{}, _time_after(std::chrono::steady_clock::now(), delay), std::forward<F>(f));
+}
+
 // ----------------------------------------------------------------------------
 // Silent Async
 // ----------------------------------------------------------------------------
@@ -118,6 +287,18 @@ void Executor::silent_async(F&& f) {
 // Function: _silent_async
 template <typename P, typename F>
 void Executor::_silent_async(P&& params, F&& f, Topology* tpg, Node* parent) {
+
+#if __cplusplus >= TF_CPP20
+  // silent coroutine task
+  if constexpr (is_coroutine_task_v<F>) {
+    _schedule_async_task(animate(
+      NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), tpg, parent, 0,
+      std::in_place_type_t<Node::Async>{}, Node::Coroutine(std::forward<F>(f))
+    ));
+  }
+  else
+#endif
+
   // silent task 
   if constexpr (is_runtime_task_v<F> || std::is_invocable_v<F>) {
     _schedule_async_task(animate(
@@ -135,6 +316,94 @@ void Executor::_silent_async(P&& params, F&& f, Topology* tpg, Node* parent) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// Bulk Silent Async
+// ----------------------------------------------------------------------------
+
+// Function: bulk_silent_async
+template <typename P, typename F>
+void Executor::bulk_silent_async(P&& params, size_t n, F&& f) {
+
+  static_assert(std::is_invocable_v<F, size_t>, 
+    "invalid bulk_silent_async target - must be [] (size_t) -> void {}"
+  );
+
+  if(n == 0) {
+    return;
+  }
+
+  // all tasks share one copy of the callable, and each task captures only
+  // a raw pointer and an index, which fit in the inline buffer of its work;
+  // the copy holds one count for each scheduled task and one for the caller
+  // until all tasks are scheduled, and whoever drops the last count frees it
+  struct Shared {
+    std::decay_t<F> func;
+    std::atomic<size_t> count;
+    Shared(F&& f) : func {std::forward<F>(f)}, count {1} {}
+    void release() {
+      if(count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+      }
+    }
+  };
+
+  auto shared = new Shared(std::forward<F>(f));
+
+  // tasks are created and published in chunks, such that workers run and 
+  // recycle the tasks of one chunk while the next chunk is being created,
+  // which keeps the working set of a large batch small
+  constexpr size_t C = 1024;
+  std::array<Node*, C> nodes;
+
+  auto w = pt::this_worker;
+
+  for(size_t beg=0; beg<n; beg+=C) {
+    size_t end = std::min(beg + C, n);
+    size_t i = beg;
+    // a chunk that fails to be created is not scheduled at all, while
+    // the chunks before it are already accounted for and run as usual
+    try {
+      for(; i<end; ++i) {
+        nodes[i-beg] = animate(
+          NSTATE::NONE, ESTATE::NONE, params, nullptr, nullptr, 0,
+          std::in_place_type_t<Node::Async>{}, 
+          [shared, i]() { 
+            try {
+              shared->func(i);
+            }
+            catch(...) {
+              shared->release();
+              throw;
+            }
+            shared->release();
+          }
+        );
+      }
+    }
+    catch(...) {
+      for(size_t k=beg; k<i; ++k) {
+        recycle(nodes[k-beg]);
+      }
+      shared->release();
+      throw;
+    }
+    // each task of the chunk drops one count of both once it finishes
+    shared->count.fetch_add(end - beg, std::memory_order_relaxed);
+    _increment_topology(end - beg);
+    // one bulk push per chunk, which wakes up at most end-beg idle workers
+    auto last = nodes.begin() + (end - beg);
+    w ? _schedule(*w, nodes.begin(), last) : _schedule(nodes.begin(), last);
+  }
+
+  shared->release();
+}
+
+// Function: bulk_silent_async
+template <typename F>
+void Executor::bulk_silent_async(size_t n, F&& f) {
+  bulk_silent_async(DefaultTaskParams{}, n, std::forward<F>(f));
+}
+
 // ----------------------------------------------------------------------------
 // Silent Dependent Async
 // ----------------------------------------------------------------------------
@@ -185,11 +454,9 @@ tf::AsyncTask Executor::silent_dependent_async(
   AsyncTask task(animate(
     NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), nullptr, nullptr, num_dependents,
     std::in_place_type_t<Node::DependentAsync>{}, std::forward<F>(func)
-  ));
+  ), this);
   
-  for(; first != last; first++) {
-    _process_async_dependent(task._node, *first, num_dependents);
-  }
+  _process_async_dependents(task._node, first, last, num_dependents);
 
   if(num_dependents == 0) {
     _schedule_async_task(task._node);
@@ -243,25 +510,23 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
   if constexpr (is_runtime_task_v<F>) {
 
     std::promise<void> p;
-    auto fu{p.get_future()};
+    tf::Future<void> fu(p.get_future(), this);
 
     AsyncTask task(animate(
       NSTATE::NONE, ESTATE::ANCHORED, std::forward<P>(params), nullptr, nullptr, num_dependents,
       std::in_place_type_t<Node::DependentAsync>{},
-      [p=MoC{std::move(p)}, f=std::forward<F>(func)] (tf::Runtime& rt, bool reentered) mutable { 
+      [p=AsyncPromise(std::move(p), fu), f=std::forward<F>(func)] (tf::Runtime& rt, bool reentered) mutable { 
         if(!reentered) {
           f(rt); 
         }
         else {
           auto& eptr = rt._parent->_exception_ptr;
-          eptr ? p.object.set_exception(eptr) : p.object.set_value();
+          eptr ? p.set_exception(eptr) : p.set_value();
         }
       }
-    ));
+    ), this);
 
-    for(; first != last; first++) {
-      _process_async_dependent(task._node, *first, num_dependents);
-    }
+    _process_async_dependents(task._node, first, last, num_dependents);
 
     if(num_dependents == 0) {
       _schedule_async_task(task._node);
@@ -274,17 +539,15 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
 
     using R = std::invoke_result_t<F>;
     std::packaged_task<R()> p(std::forward<F>(func));
-    auto fu{p.get_future()};
+    tf::Future<R> fu(p.get_future(), this);
 
     AsyncTask task(animate(
       NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), nullptr, nullptr, num_dependents,
       std::in_place_type_t<Node::DependentAsync>{},
-      [p=make_moc(std::move(p))] () mutable { p.object(); }
-    ));
+      [p=AsyncPromise(std::move(p), fu)] () mutable { p(); }
+    ), this);
 
-    for(; first != last; first++) {
-      _process_async_dependent(task._node, *first, num_dependents);
-    }
+    _process_async_dependents(task._node, first, last, num_dependents);
 
     if(num_dependents == 0) {
       _schedule_async_task(task._node);
@@ -297,38 +560,204 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
   }
 }
 
+// ----------------------------------------------------------------------------
+// When All / When Any
+// ----------------------------------------------------------------------------
+
+// Function: when_all
+template <typename I>
+auto Executor::when_all(I first, I last) {
+
+  using E = std::decay_t<decltype(*first)>;
+
+  if constexpr (std::is_same_v<E, AsyncTask>) {
+    return dependent_async([](){}, first, last);
+  }
+  else {
+    using F = typename E::second_type;
+    using T = decltype(std::declval<F&>().get());
+
+    std::vector<AsyncTask> tasks;
+    std::vector<F> futures;
+    tasks.reserve(std::distance(first, last));
+    futures.reserve(tasks.capacity());
+
+    for(; first != last; ++first) {
+      tasks.push_back(first->first);
+      futures.push_back(std::move(first->second));
+    }
+    
+    // all futures are ready once the combined task runs
+    return dependent_async([futures=std::move(futures)] () mutable {
+      if constexpr (std::is_void_v<T>) {
+        for(auto& fu : futures) {
+          fu.get();
+        }
+      }
+      else {
+        std::vector<T> results;
+        results.reserve(futures.size());
+        for(auto& fu : futures) {
+          results.push_back(fu.get());
+        }
+        return results;
+      }
+    }, tasks.begin(), tasks.end());
+  }
+}
+
+// Function: when_any
+template <typename I>
+auto Executor::when_any(I first, I last) {
+
+  using E = std::decay_t<decltype(*first)>;
+
+  if constexpr (std::is_same_v<E, AsyncTask>) {
+    return _when_any(std::vector<AsyncTask>(first, last), [](size_t i){ return i; });
+  }
+  else {
+    using F = typename E::second_type;
+    using T = decltype(std::declval<F&>().get());
+
+    std::vector<AsyncTask> tasks;
+    std::vector<F> futures;
+    tasks.reserve(std::distance(first, last));
+    futures.reserve(tasks.capacity());
+
+    for(; first != last; ++first) {
+      tasks.push_back(first->first);
+      futures.push_back(std::move(first->second));
+    }
+
+    return _when_any(std::move(tasks), [futures=std::move(futures)] (size_t i) mutable {
+      if constexpr (std::is_void_v<T>) {
+        futures[i].get();
+        return i;
+      }
+      else {
+        return std::make_pair(i, futures[i].get());
+      }
+    });
+  }
+}
+
+// Function: _when_any
+template <typename C>
+auto Executor::_when_any(std::vector<AsyncTask> tasks, C&& c) {
+
+  using R = std::invoke_result_t<C, size_t>;
+
+  if(tasks.empty()) {
+    TF_THROW("when_any requires at least one task");
+  }
+
+  _increment_topology();
+
+  size_t num_tasks = tasks.size();
+  
+  // moving the vector into the callable keeps its elements in place
+  auto data = tasks.data();
+  
+  // the combined task runs once any task finishes, and picks a finished one
+  std::packaged_task<R()> p([tasks=std::move(tasks), c=std::forward<C>(c)] () mutable {
+    size_t i = 0;
+    while(i+1 < tasks.size() && 
+          std::get<Node::DependentAsync>(tasks[i]._node->_handle).successors.load(
+            std::memory_order_acquire
+          ) != &Node::DependentAsync::FINISHED) {
+      ++i;
+    }
+    return c(i);
+  });
+  tf::Future<R> fu(p.get_future(), this);
+
+  AsyncTask task(animate(
+    NSTATE::NONE, ESTATE::NONE, DefaultTaskParams{}, nullptr, nullptr, 1,
+    std::in_place_type_t<Node::DependentAsync>{},
+    [p=AsyncPromise(std::move(p), fu)] () mutable { p(); }
+  ), this);
+
+  auto node = task._node;
+  auto& handle = std::get<Node::DependentAsync>(node->_handle);
+
+  // each link retains the combined task until its task finishes
+  handle.use_count.fetch_add(num_tasks, std::memory_order_relaxed);
+  handle.links.resize(num_tasks);
+
+  for(size_t i=0; i<num_tasks; ++i) {
+    auto& link = handle.links[i];
+    link.node = node;
+    link.any = true;
+    if(!_link_async_successor(data[i], link)) {
+      if(_release_any(node)) {
+        _schedule_async_task(node);
+      }
+      // the returned handle still retains the combined task
+      handle.use_count.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  return std::make_pair(std::move(task), std::move(fu));
+}
+
 // ----------------------------------------------------------------------------
 // Dependent Async Helper Functions
 // ----------------------------------------------------------------------------
 
+// Procedure: _process_async_dependents
+template <typename I>
+void Executor::_process_async_dependents(Node* node, I first, I last, size_t& num_dependents) {
+
+  // one entry per dependent, which must not move once linked
+  auto& links = std::get_if<Node::DependentAsync>(&(node->_handle))->links;
+  links.resize(num_dependents);
+
+  for(size_t i=0; first != last; ++first, ++i) {
+    _process_async_dependent(node, *first, links[i], num_dependents);
+  }
+}
+
 // Procedure: _process_async_dependent
 inline void Executor::_process_async_dependent(
-  Node* node, tf::AsyncTask& task, size_t& num_dependents
+  Node* node, tf::AsyncTask& task, Node::AsyncLink& link, size_t& num_dependents
 ) {
+  link.node = node;
 
-  auto& state = std::get_if<Node::DependentAsync>(&(task._node->_handle))->state;
+  // already finished, decrement the join counter
+  if(!_link_async_successor(task, link)) {
+    num_dependents = node->_join_counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
+  }
+}
 
-  while (true) {
+// Function: _link_async_successor
+// pushes the link to the successor list of the task unless the task has finished
+inline bool Executor::_link_async_successor(tf::AsyncTask& task, Node::AsyncLink& link) {
 
-    auto target = ASTATE::UNFINISHED;
+  auto& successors = std::get_if<Node::DependentAsync>(&(task._node->_handle))->successors;
 
-    // Try to acquire the lock
-    if (state.compare_exchange_strong(target, ASTATE::LOCKED, 
-                                      std::memory_order_acq_rel,
-                                      std::memory_order_acquire)) {
-      task._node->_edges.push_back(node);
-      state.store(ASTATE::UNFINISHED, std::memory_order_release);
-      break;
-    }
+  auto head = successors.load(std::memory_order_acquire);
 
-    // If already finished, decrement the join counter
-    if (target == ASTATE::FINISHED) {
-      num_dependents = node->_join_counter.fetch_sub(1, std::memory_order_acq_rel) - 1;
-      break;
+  while(head != &Node::DependentAsync::FINISHED) {
+    link.next = head;
+    if(successors.compare_exchange_weak(head, &link,
+                                        std::memory_order_release,
+                                        std::memory_order_acquire)) {
+      return true;
     }
-
-    // If locked by another worker, retry
   }
+
+  return false;
+}
+
+// Function: _release_any
+// Only the first of the tasks of a when_any successor brings its counter
+// from one to zero, and the others leave the counter untouched, such that
+// the counter never drops below zero.
+TF_FORCE_INLINE bool Executor::_release_any(Node* node) {
+  size_t one = 1;
+  return node->_join_counter.compare_exchange_strong(
+    one, 0, std::memory_order_acq_rel, std::memory_order_relaxed
+  );
 }
 
 // Procedure: _tear_down_dependent_async
@@ -336,22 +765,36 @@ inline void Executor::_tear_down_dependent_async(Worker& worker, Node* node, Nod
 
   auto handle = std::get_if<Node::DependentAsync>(&(node->_handle));
 
-  // this async task comes from Executor
-  auto target = ASTATE::UNFINISHED;
+  // close the successor list and take over the successors linked so far
+  auto link = handle->successors.exchange(
+    &Node::DependentAsync::FINISHED, std::memory_order_acq_rel
+  );
 
-  while(!handle->state.compare_exchange_weak(target, ASTATE::FINISHED,
-                                             std::memory_order_acq_rel,
-                                             std::memory_order_relaxed)) {
-    target = ASTATE::UNFINISHED;
-  }
+#if __cplusplus >= TF_CPP20
+  // wake up non-worker threads waiting on this task
+  handle->successors.notify_all();
+#endif
   
   // spawn successors whenever their dependencies are resolved
-  for(size_t i=0; i<node->_edges.size(); ++i) {
-    if(auto s = node->_edges[i]; 
-      s->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1
-    ) {
+  while(link) {
+    // the link lives in the successor, which can finish once its counter drops
+    auto next = link->next;
+    auto s = link->node;
+    if(link->any) {
+      if(_release_any(s)) {
+        _update_cache(worker, cache, s);
+      }
+      // the link no longer retains the successor
+      if(std::get_if<Node::DependentAsync>(&(s->_handle))->use_count.fetch_sub(
+        1, std::memory_order_acq_rel) == 1
+      ) {
+        recycle(s);
+      }
+    }
+    else if(s->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1) {
       _update_cache(worker, cache, s);
     }
+    link = next;
   }
   
   // now the executor no longer needs to retain ownership
@@ -106,18 +106,37 @@ class AsyncTask {
     */
     bool is_done() const; 
 
+    /**
+    @brief waits until the async task finishes
+
+    When the caller is a worker of the executor that created the async task,
+    the worker keeps running other tasks of the executor until the async task
+    finishes, instead of blocking its thread.
+    Otherwise, the caller blocks until the async task finishes.
+
+    @code{.cpp}
+    executor.silent_async([&](){
+      tf::AsyncTask A = executor.silent_dependent_async([](){});
+      A.wait();  // the worker runs other tasks until A finishes
+    });
+    @endcode
+    */
+    void wait() const;
+
   private:
 
-    explicit AsyncTask(Node*);
+    AsyncTask(Node*, Executor*);
 
     Node* _node {nullptr};
+    Executor* _executor {nullptr};
 
     void _incref();
     void _decref();
 };
 
 // Constructor
-inline AsyncTask::AsyncTask(Node* ptr) : _node{ptr} {
+inline AsyncTask::AsyncTask(Node* ptr, Executor* executor) : 
+  _node {ptr}, _executor {executor} {
   _incref();
 }
 
@@ -141,13 +160,13 @@ inline void AsyncTask::_decref() {
 
 // Copy Constructor
 inline AsyncTask::AsyncTask(const AsyncTask& rhs) : 
-  _node{rhs._node} {
+  _node {rhs._node}, _executor {rhs._executor} {
   _incref();
 }
 
 // Move Constructor
 inline AsyncTask::AsyncTask(AsyncTask&& rhs) :
-  _node {rhs._node} {
+  _node {rhs._node}, _executor {rhs._executor} {
   rhs._node = nullptr;
 }
 
@@ -160,6 +179,7 @@ inline AsyncTask::~AsyncTask() {
 inline AsyncTask& AsyncTask::operator = (const AsyncTask& rhs) {
   _decref();
   _node = rhs._node;
+  _executor = rhs._executor;
   _incref();
   return *this;
 }
@@ -168,6 +188,7 @@ inline AsyncTask& AsyncTask::operator = (const AsyncTask& rhs) {
 inline AsyncTask& AsyncTask::operator = (AsyncTask&& rhs) {
   _decref();
   _node = rhs._node;
+  _executor = rhs._executor;
   rhs._node = nullptr;
   return *this;
 }
@@ -198,9 +219,9 @@ inline size_t AsyncTask::use_count() const {
 
 // Function: is_done
 inline bool AsyncTask::is_done() const {
-  return std::get_if<Node::DependentAsync>(&(_node->_handle))->state.load(
+  return std::get_if<Node::DependentAsync>(&(_node->_handle))->successors.load(
     std::memory_order_acquire
-  ) == ASTATE::FINISHED;
+  ) == &Node::DependentAsync::FINISHED;
 }
 
 }  // end of namespace tf ----------------------------------------------------
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <atomic>
+#include <bit>
 #include <thread>
 #include <vector>
 
@@ -18,20 +19,28 @@ class AtomicNotifier {
   
   struct Waiter {
     alignas (2*TF_CACHELINE_SIZE) uint32_t epoch;
+    // every notification that picks this waiter bumps its signal, on
+    // which the waiter blocks in commit_wait
+    uint32_t signal_seen;
+    std::atomic<uint32_t> signal {0};
   };
 
-  AtomicNotifier(size_t N) noexcept : _state(0), _waiters(N) {}
+  AtomicNotifier(size_t N) noexcept : 
+    _state(0), _waiters(N), _parked((N + 63) / 64) {
+  }
   ~AtomicNotifier() { assert((_state.load() & WAITER_MASK) == 0); } 
 
   void notify_one() noexcept;
   void notify_all() noexcept;
   void notify_n(size_t n) noexcept;
+  void notify(Waiter*) noexcept;
   void prepare_wait(Waiter*) noexcept;
   void cancel_wait(Waiter*) noexcept;
   void commit_wait(Waiter*) noexcept;
 
   size_t size() const noexcept;
   size_t num_waiters() const noexcept;
+  Waiter* waiter(size_t i) noexcept;
 
  private:
 
@@ -51,6 +60,14 @@ class AtomicNotifier {
   std::atomic<uint64_t> _state;
   std::vector<Waiter> _waiters;
 
+  // _parked stores one bit per waiter, which is set while the waiter 
+  // blocks in commit_wait and cleared by whoever wakes it up
+  std::vector<std::atomic<uint64_t>> _parked;
+
+  void _wake(size_t) noexcept;
+  void _wake_one() noexcept;
+  void _wake_all() noexcept;
+
   static constexpr uint64_t WAITER_INC  {1};
   static constexpr uint64_t EPOCH_SHIFT {32};
   static constexpr uint64_t EPOCH_INC   {uint64_t(1) << EPOCH_SHIFT};
@@ -65,16 +82,16 @@ inline size_t AtomicNotifier::num_waiters() const noexcept {
   return _state.load(std::memory_order_relaxed) & WAITER_MASK;
 }
 
+inline AtomicNotifier::Waiter* AtomicNotifier::waiter(size_t i) noexcept {
+  return &_waiters[i];
+}
+
 inline void AtomicNotifier::notify_one() noexcept {
   std::atomic_thread_fence(std::memory_order_seq_cst);
-  //if((_state.load(std::memory_order_acquire) & WAITER_MASK) != 0) {
-  //  _state.fetch_add(EPOCH_INC, std::memory_order_relaxed);
-  //  _state.notify_one(); 
-  //}
-
   for(uint64_t state = _state.load(std::memory_order_acquire); state & WAITER_MASK;) {
-    if(_state.compare_exchange_weak(state, state + EPOCH_INC, std::memory_order_acquire)) {
-      _state.notify_one(); 
+    if(_state.compare_exchange_weak(state, state + EPOCH_INC, std::memory_order_seq_cst)) {
+      // waiters that have not blocked yet observe the new epoch
+      _wake_one();
       break;
     }
   }
@@ -82,13 +99,9 @@ inline void AtomicNotifier::notify_one() noexcept {
 
 inline void AtomicNotifier::notify_all() noexcept {
   std::atomic_thread_fence(std::memory_order_seq_cst);
-  //if((_state.load(std::memory_order_acquire) & WAITER_MASK) != 0) {
-  //  _state.fetch_add(EPOCH_INC, std::memory_order_relaxed);
-  //  _state.notify_all(); 
-  //}
   for(uint64_t state = _state.load(std::memory_order_acquire); state & WAITER_MASK;) {
-    if(_state.compare_exchange_weak(state, state + EPOCH_INC, std::memory_order_acquire)) {
-      _state.notify_all(); 
+    if(_state.compare_exchange_weak(state, state + EPOCH_INC, std::memory_order_seq_cst)) {
+      _wake_all();
       break;
     }
   }
@@ -105,9 +118,23 @@ inline void AtomicNotifier::notify_n(size_t n) noexcept {
   }
 }
 
+// Wakes up the given waiter only. A waiter that has not blocked yet
+// observes the new signal in commit_wait and returns right away, and 
+// other waiters stay asleep since the epoch does not change.
+inline void AtomicNotifier::notify(Waiter* waiter) noexcept {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  waiter->signal.fetch_add(1, std::memory_order_seq_cst);
+  size_t i = static_cast<size_t>(waiter - _waiters.data());
+  uint64_t bit = uint64_t(1) << (i % 64);
+  if(_parked[i / 64].fetch_and(~bit, std::memory_order_seq_cst) & bit) {
+    waiter->signal.notify_one();
+  }
+}
+
 inline void AtomicNotifier::prepare_wait(Waiter* waiter) noexcept {
   auto prev = _state.fetch_add(WAITER_INC, std::memory_order_relaxed);
   waiter->epoch = (prev >> EPOCH_SHIFT);
+  waiter->signal_seen = waiter->signal.load(std::memory_order_relaxed);
   std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
@@ -116,18 +143,47 @@ inline void AtomicNotifier::cancel_wait(Waiter*) noexcept {
 }
 
 inline void AtomicNotifier::commit_wait(Waiter* waiter) noexcept {
-  uint64_t prev = _state.load(std::memory_order_acquire);
-  while((prev >> EPOCH_SHIFT) == waiter->epoch) {
-    _state.wait(prev, std::memory_order_acquire); 
-    prev = _state.load(std::memory_order_acquire);
+  size_t i = static_cast<size_t>(waiter - _waiters.data());
+  uint64_t bit = uint64_t(1) << (i % 64);
+  // publish the bit before checking the epoch so that a notifier bumping 
+  // the epoch afterwards is guaranteed to find this waiter
+  _parked[i / 64].fetch_or(bit, std::memory_order_seq_cst);
+  if((_state.load(std::memory_order_seq_cst) >> EPOCH_SHIFT) == waiter->epoch) {
+    waiter->signal.wait(waiter->signal_seen, std::memory_order_acquire);
   }
+  _parked[i / 64].fetch_and(~bit, std::memory_order_relaxed);
   // memory_order_relaxed would suffice for correctness, but the faster
   // #waiters gets to 0, the less likely it is that we'll do spurious wakeups
   // (and thus system calls)
   _state.fetch_sub(WAITER_INC, std::memory_order_seq_cst);
 }
 
+inline void AtomicNotifier::_wake(size_t i) noexcept {
+  _waiters[i].signal.fetch_add(1, std::memory_order_release);
+  _waiters[i].signal.notify_one();
+}
 
+inline void AtomicNotifier::_wake_one() noexcept {
+  for(size_t w=0; w<_parked.size(); ++w) {
+    uint64_t bits = _parked[w].load(std::memory_order_seq_cst);
+    while(bits) {
+      if(_parked[w].compare_exchange_weak(bits, bits & (bits - 1), 
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_seq_cst)) {
+        _wake(w*64 + static_cast<size_t>(std::countr_zero(bits)));
+        return;
+      }
+    }
+  }
+}
+
+inline void AtomicNotifier::_wake_all() noexcept {
+  for(size_t w=0; w<_parked.size(); ++w) {
+    for(uint64_t bits = _parked[w].exchange(0, std::memory_order_seq_cst); bits; bits &= bits - 1) {
+      _wake(w*64 + static_cast<size_t>(std::countr_zero(bits)));
+    }
+  }
+}
 
 } // namespace taskflow -------------------------------------------------------
 
@@ -0,0 +1,614 @@
+#pragma once
+
+#include "executor.hpp"
+
+/**
+@file coroutine.hpp
+@brief coroutine include file
+*/
+
+#if __cplusplus >= TF_CPP20
+
+namespace tf {
+
+template <typename T>
+class CoroPromise;
+
+// ----------------------------------------------------------------------------
+// Class Definition: CorunAwaitable
+// ----------------------------------------------------------------------------
+
+/**
+@class CorunAwaitable
+
+@brief class to create an awaitable that coruns a graph target in a coroutine task
+
+An object of this class is returned by tf::corun and can only be awaited
+in a tf::Coro.
+*/
+class CorunAwaitable {
+
+  friend class CoroPromiseBase;
+
+  template <typename T>
+  friend CorunAwaitable corun(T&);
+
+  public:
+
+  CorunAwaitable(const CorunAwaitable&) = delete;
+  CorunAwaitable& operator = (const CorunAwaitable&) = delete;
+
+  private:
+
+  explicit CorunAwaitable(Graph& graph) : _graph {graph} {}
+
+  Graph& _graph;
+};
+
+/**
+@brief creates an awaitable that coruns the given target as the children
+       of the awaiting coroutine task
+
+@tparam T target type which has `tf::Graph& T::graph()` defined
+@param target the target to corun
+
+The coroutine suspends until all tasks of the target finish, while
+the worker that ran the coroutine runs other tasks.
+An exception thrown by a task of the target is rethrown at the @c co_await.
+This is the counterpart of tf::Runtime::corun for a coroutine task.
+
+@code{.cpp}
+tf::Taskflow child;
+child.emplace([](){ std::cout << "child\n"; });
+
+taskflow.emplace([&]() -> tf::Coro<void> {
+  co_await tf::corun(child);
+  std::cout << "after child\n";
+});
+@endcode
+
+The target must outlive the @c co_await, and it must not be run by
+any other task or executor during that time.
+*/
+template <typename T>
+CorunAwaitable corun(T& target) {
+  static_assert(has_graph_v<T>, "target must define a member function 'Graph& graph()'");
+  return CorunAwaitable(target.graph());
+}
+
+// ----------------------------------------------------------------------------
+// Class Definition: CoroPromiseBase
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief base class of the promise of a tf::Coro
+
+The promise records the executor and the node of the task the coroutine
+runs in, and the coroutine at the root of a chain of nested coroutines
+records the innermost frame the executor resumes next.
+Only the awaitables listed by the @c await_transform overloads can be
+awaited, since any other awaitable would resume the coroutine outside
+of the executor.
+*/
+class CoroPromiseBase {
+
+  friend class Executor;
+
+  template <typename T>
+  friend class Coro;
+
+  template <typename T>
+  friend class CoroPromise;
+
+  // awaiter of the final suspension point that transfers the control to
+  // the awaiting coroutine or, for the root, back to the executor
+  struct FinalAwaiter {
+
+    bool await_ready() const noexcept { return false; }
+
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) const noexcept {
+      auto c = h.promise()._continuation;
+      return c ? c : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  // awaiter that suspends the coroutine until an async task finishes
+  class AsyncTaskAwaiter {
+
+    public:
+
+    AsyncTaskAwaiter(CoroPromiseBase* promise, AsyncTask task) :
+      _promise {promise}, _task {std::move(task)} {
+    }
+
+    bool await_ready() const {
+      return _task.empty() || _task.is_done();
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+      _promise->_root->_resume = h;
+      _promise->_executor->_await_async_task(_promise, _task);
+    }
+
+    void await_resume() const noexcept {}
+
+    private:
+
+    CoroPromiseBase* _promise;
+    AsyncTask _task;
+  };
+
+  // awaiter that suspends the coroutine until a future is ready, where
+  // the run or the async task of the future resumes the coroutine as it
+  // carries out its promise
+  template <typename T>
+  class FutureAwaiter {
+
+    public:
+
+    FutureAwaiter(CoroPromiseBase* promise, Future<T>& future) :
+      _promise {promise}, _future {future} {
+    }
+
+    bool await_ready() const {
+      return _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    bool await_suspend(std::coroutine_handle<> h) {
+      _promise->_root->_resume = h;
+      // the topology is gone after the promise is carried out
+      if(auto tpg = _future._topology.lock(); tpg) {
+        return _promise->_executor->_await_future(_promise, tpg->_awaiters);
+      }
+      if(_future._awaiters) {
+        return _promise->_executor->_await_future(_promise, *_future._awaiters);
+      }
+      // any other future is either ready or invalid
+      return false;
+    }
+
+    T await_resume() {
+      return _future.get();
+    }
+
+    private:
+
+    CoroPromiseBase* _promise;
+    Future<T>& _future;
+  };
+
+  // awaiter that suspends the coroutine until a graph coruns as its children
+  class CorunAwaiter {
+
+    public:
+
+    CorunAwaiter(CoroPromiseBase* promise, Graph& graph) :
+      _promise {promise}, _graph {graph} {
+    }
+
+    bool await_ready() const noexcept {
+      return _graph.empty();
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+      _promise->_root->_resume = h;
+      _promise->_executor->_await_graph(_promise, _graph);
+    }
+
+    void await_resume() {
+      auto node = _promise->_node;
+      node->_estate.fetch_and(~ESTATE::ANCHORED, std::memory_order_relaxed);
+      node->_rethrow_exception();
+    }
+
+    private:
+
+    CoroPromiseBase* _promise;
+    Graph& _graph;
+  };
+
+  // awaiter that runs a nested coroutine through symmetric transfer
+  template <typename T>
+  class CoroAwaiter {
+
+    public:
+
+    CoroAwaiter(CoroPromiseBase* promise, std::coroutine_handle<CoroPromise<T>> child) :
+      _promise {promise}, _child {child} {
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> h) noexcept {
+      auto& c = _child.promise();
+      c._executor = _promise->_executor;
+      c._node = _promise->_node;
+      c._root = _promise->_root;
+      c._continuation = h;
+      return _child;
+    }
+
+    T await_resume() {
+      return _child.promise()._result();
+    }
+
+    private:
+
+    CoroPromiseBase* _promise;
+    std::coroutine_handle<CoroPromise<T>> _child;
+  };
+
+  public:
+
+  /**
+  @brief suspends the coroutine at its creation until a worker runs it
+  */
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  /**
+  @brief transfers the control to the awaiting coroutine at completion
+  */
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  /**
+  @brief stores the exception escaping the coroutine
+  */
+  void unhandled_exception() noexcept { _exception_ptr = std::current_exception(); }
+
+  /**
+  @brief awaits the completion of an async task
+  */
+  AsyncTaskAwaiter await_transform(AsyncTask task) {
+    return AsyncTaskAwaiter(this, std::move(task));
+  }
+
+  /**
+  @brief awaits the result of a future
+  */
+  template <typename T>
+  FutureAwaiter<T> await_transform(Future<T>& future) {
+    return FutureAwaiter<T>(this, future);
+  }
+
+  /**
+  @brief awaits the result of a future
+  */
+  template <typename T>
+  FutureAwaiter<T> await_transform(Future<T>&& future) {
+    return FutureAwaiter<T>(this, future);
+  }
+
+  /**
+  @brief awaits the completion of a target corun by tf::corun
+  */
+  CorunAwaiter await_transform(const CorunAwaitable& awaitable) {
+    return CorunAwaiter(this, awaitable._graph);
+  }
+
+  /**
+  @brief awaits the result of a nested coroutine
+  */
+  template <typename T>
+  CoroAwaiter<T> await_transform(Coro<T>&& coro) {
+    return CoroAwaiter<T>(this, coro._handle);
+  }
+
+  private:
+
+  Executor* _executor {nullptr};
+  Node* _node {nullptr};
+
+  // the root coroutine of a chain of nested coroutines and, for the root,
+  // the innermost frame to resume next
+  CoroPromiseBase* _root {this};
+  std::coroutine_handle<> _resume;
+
+  std::coroutine_handle<> _handle;
+  std::coroutine_handle<> _continuation;
+  std::exception_ptr _exception_ptr {nullptr};
+
+  // entry in the successor list of the async task being awaited
+  Node::AsyncLink _link;
+
+  void _rethrow_exception() {
+    if(_exception_ptr) {
+      std::rethrow_exception(std::exchange(_exception_ptr, nullptr));
+    }
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: CoroPromise
+// ----------------------------------------------------------------------------
+
+/**
+@private
+*/
+template <typename T>
+class CoroPromise : public CoroPromiseBase {
+
+  friend class CoroPromiseBase;
+
+  public:
+
+  Coro<T> get_return_object() {
+    _handle = std::coroutine_handle<CoroPromise>::from_promise(*this);
+    return Coro<T>(std::coroutine_handle<CoroPromise>::from_promise(*this));
+  }
+
+  template <typename U>
+  void return_value(U&& value) {
+    _value.emplace(std::forward<U>(value));
+  }
+
+  private:
+
+  std::optional<T> _value;
+
+  T _result() {
+    _rethrow_exception();
+    return std::move(*_value);
+  }
+};
+
+/**
+@private
+*/
+template <>
+class CoroPromise<void> : public CoroPromiseBase {
+
+  friend class CoroPromiseBase;
+
+  public:
+
+  Coro<void> get_return_object();
+
+  void return_void() const noexcept {}
+
+  private:
+
+  void _result() {
+    _rethrow_exception();
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: Coro
+// ----------------------------------------------------------------------------
+
+/**
+@class Coro
+
+@brief class to create the return object of a coroutine task (C++20 only)
+
+@tparam T result type of the coroutine
+
+A callable that takes no arguments and returns a tf::Coro is
+a coroutine task, which tf::FlowBuilder::emplace, tf::Executor::async,
+and tf::Executor::silent_async accept.
+Inside the coroutine, @c co_await on a tf::AsyncTask, a tf::Future,
+an awaitable created by tf::corun, or another tf::Coro suspends
+the coroutine without blocking the worker that runs it.
+The worker goes on to run other tasks, and the executor schedules
+the coroutine again once the awaited operation completes,
+possibly on another worker.
+The run or the async task behind a tf::Future, of this or another
+executor, resumes the coroutine as it carries out its promise.
+
+@code{.cpp}
+tf::Executor executor;
+
+// a coroutine that awaits a nested coroutine
+auto square = [](int x) -> tf::Coro<int> { co_return x * x; };
+
+std::future<int> fu = executor.async([&]() -> tf::Coro<int> {
+
+  // await an async task
+  auto task = executor.silent_dependent_async([](){ std::cout << "hello\n"; });
+  co_await task;
+
+  // await a nested coroutine
+  int y = co_await square(2);
+  co_return y + 1;
+});
+
+assert(fu.get() == 5);
+@endcode
+
+A coroutine only references objects that outlive it, as any other task.
+In particular, a lambda coroutine must not be a temporary,
+which is why the executor keeps the callable of a coroutine task
+alive until the coroutine finishes, and a nested coroutine
+should take its arguments by value.
+A tf::Runtime object is bound to the worker that runs the task
+and is therefore not available in a coroutine task.
+*/
+template <typename T = void>
+class Coro {
+
+  friend class Node;
+  friend class CoroPromiseBase;
+  friend class CoroPromise<T>;
+
+  public:
+
+  /**
+  @brief promise type of the coroutine
+  */
+  using promise_type = CoroPromise<T>;
+
+  /**
+  @brief result type of the coroutine
+  */
+  using value_type = T;
+
+  /**
+  @brief move constructor
+  */
+  Coro(Coro&& rhs) noexcept : _handle {std::exchange(rhs._handle, nullptr)} {
+  }
+
+  /**
+  @brief disabled copy constructor
+  */
+  Coro(const Coro&) = delete;
+
+  /**
+  @brief move assignment
+  */
+  Coro& operator = (Coro&& rhs) noexcept {
+    if(this != &rhs) {
+      if(_handle) {
+        _handle.destroy();
+      }
+      _handle = std::exchange(rhs._handle, nullptr);
+    }
+    return *this;
+  }
+
+  /**
+  @brief disabled copy assignment
+  */
+  Coro& operator = (const Coro&) = delete;
+
+  /**
+  @brief destroys the coroutine frame owned by this object
+  */
+  ~Coro() {
+    if(_handle) {
+      _handle.destroy();
+    }
+  }
+
+  private:
+
+  std::coroutine_handle<promise_type> _handle;
+
+  explicit Coro(std::coroutine_handle<promise_type> handle) : _handle {handle} {}
+
+  // hands the frame over to a node
+  CoroPromiseBase* _release() {
+    return &std::exchange(_handle, nullptr).promise();
+  }
+};
+
+// Function: get_return_object
+inline Coro<void> CoroPromise<void>::get_return_object() {
+  _handle = std::coroutine_handle<CoroPromise>::from_promise(*this);
+  return Coro<void>(std::coroutine_handle<CoroPromise>::from_promise(*this));
+}
+
+// ----------------------------------------------------------------------------
+// Executor Forward Declaration
+// ----------------------------------------------------------------------------
+
+// Procedure: _invoke_coroutine_task
+// The invocation holds an extra count on the join counter of the node
+// while it resumes the coroutine, as tf::PreemptionGuard does for a runtime.
+// An awaited operation that completes before the coroutine returns to
+// the invocation leaves the count to this worker, which then resumes the
+// coroutine right away, and otherwise the operation that brings the counter
+// to zero schedules the node again.
+inline bool Executor::_invoke_coroutine_task(Worker& worker, Node* node, Node::Coroutine& h) {
+
+  // create the coroutine at the first invocation
+  if(h.frame == nullptr) {
+    TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
+      h.promise = h.work();
+    });
+    if(h.promise == nullptr) {
+      return false;
+    }
+    h.frame = h.promise->_handle;
+    h.promise->_executor = this;
+    h.promise->_node = node;
+    h.promise->_resume = h.frame;
+    node->_nstate |= NSTATE::PREEMPTED;
+  }
+
+  while(true) {
+    node->_join_counter.fetch_add(1, std::memory_order_release);
+    if(!h.frame.done()) {
+      _observer_prologue(worker, node);
+      h.promise->_resume.resume();
+      _observer_epilogue(worker, node);
+    }
+    if(node->_join_counter.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return true;
+    }
+    if(h.frame.done()) {
+      break;
+    }
+  }
+
+  // the coroutine has finished
+  node->_nstate &= ~NSTATE::PREEMPTED;
+
+  auto eptr = std::exchange(h.promise->_exception_ptr, nullptr);
+  std::exchange(h.frame, nullptr).destroy();
+  h.promise = nullptr;
+
+  if(eptr) {
+    TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
+      std::rethrow_exception(eptr);
+    });
+  }
+
+  return false;
+}
+
+// Procedure: _await_async_task
+inline void Executor::_await_async_task(CoroPromiseBase* promise, AsyncTask& task) {
+  auto node = promise->_node;
+  size_t num_dependents = 1;
+  node->_join_counter.fetch_add(1, std::memory_order_relaxed);
+  _process_async_dependent(node, task, promise->_link, num_dependents);
+}
+
+// Function: _await_future
+inline bool Executor::_await_future(CoroPromiseBase* promise, FutureAwaiters& awaiters) {
+  std::lock_guard<std::mutex> lock(awaiters._mutex);
+  if(!awaiters._awaitable) {
+    return false;
+  }
+  promise->_node->_join_counter.fetch_add(1, std::memory_order_relaxed);
+  awaiters._promises.push_back(promise);
+  return true;
+}
+
+// Procedure: _await_graph
+inline void Executor::_await_graph(CoroPromiseBase* promise, Graph& graph) {
+  auto node = promise->_node;
+  node->_estate.fetch_or(ESTATE::ANCHORED, std::memory_order_relaxed);
+  _schedule_graph_with_parent(*pt::this_worker, graph.begin(), graph.end(), node);
+}
+
+// Procedure: _resume_awaiters
+inline void Executor::_resume_awaiters(FutureAwaiters& awaiters) {
+
+  std::vector<CoroPromiseBase*> promises;
+  {
+    std::lock_guard<std::mutex> lock(awaiters._mutex);
+    awaiters._awaitable = false;
+    promises.swap(awaiters._promises);
+  }
+
+  for(auto promise : promises) {
+    // the promise may be gone once the counter drops
+    if(auto node = promise->_node;
+       node->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      promise->_executor->_schedule_async_task(node);
+    }
+  }
+}
+
+}  // end of namespace tf -----------------------------------------------------
+
+#endif
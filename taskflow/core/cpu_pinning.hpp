@@ -0,0 +1,234 @@
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+
+#include "worker.hpp"
+#include "error.hpp"
+#include "../utility/cpu_topology.hpp"
+#include "../utility/os.hpp"
+
+/**
+@file cpu_pinning.hpp
+@brief CPU pinning include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: CPUPinning
+// ----------------------------------------------------------------------------
+
+/**
+@class CPUPinning
+
+@brief class to create a worker interface that pins workers to an explicit list of CPUs
+
+Worker @c i is pinned to the logical CPU <tt>cpus()[i % cpus().size()]</tt>
+before it enters the scheduling loop.
+The constructor drops the CPUs outside the cpuset of the process
+(see tf::available_cpus), such that pinning also works in containers
+with restricted cpusets, and throws an exception if no CPU remains.
+
+@code{.cpp}
+// pin four workers to the CPUs 2, 3, 6, and 7
+auto pinning = std::make_shared<tf::CPUPinning>(std::vector<size_t>{2, 3, 6, 7});
+tf::Executor executor(4, pinning->topology(), pinning);
+@endcode
+
+Passing tf::CPUPinning::topology to the executor makes the work-stealing
+victim selection follow the CPUs the workers are pinned to
+rather than the worker ids.
+Pinning is supported on Linux; on other systems, the workers are not pinned.
+The class tf::CompactCPUPinning and tf::ScatterCPUPinning derive
+the list of CPUs from the CPU topology.
+*/
+class CPUPinning : public WorkerInterface {
+
+  public:
+
+  /**
+  @brief constructs a pinning to the given CPUs in the order of the list
+  */
+  explicit CPUPinning(const std::vector<size_t>& cpus) {
+    auto available = available_cpus();
+    for(auto c : cpus) {
+      if(std::find(available.begin(), available.end(), c) != available.end()) {
+        _cpus.push_back(c);
+      }
+    }
+    if(_cpus.empty()) {
+      TF_THROW("none of the ", cpus.size(), " CPUs to pin is available to the process");
+    }
+  }
+
+  /**
+  @brief queries the CPUs workers are pinned to
+  */
+  const std::vector<size_t>& cpus() const { return _cpus; }
+
+  /**
+  @brief queries the CPU the worker of the given id is pinned to
+  */
+  size_t cpu(size_t worker_id) const { return _cpus[worker_id % _cpus.size()]; }
+
+  /**
+  @brief queries the topology of the CPUs in the order of the workers
+
+  @param topology topology of the machine (default tf::CPUTopology::system)
+
+  Entry @c i of the returned topology describes the domains of
+  the CPU worker @c i is pinned to.
+  */
+  CPUTopology topology(const CPUTopology& topology = CPUTopology::system()) const {
+    std::vector<CPUTopology::CPU> cpus;
+    cpus.reserve(_cpus.size());
+    for(auto c : _cpus) {
+      cpus.push_back(_domains(topology, c));
+    }
+    return CPUTopology(std::move(cpus));
+  }
+
+  /**
+  @brief pins the calling worker to its CPU
+  */
+  void scheduler_prologue(Worker& worker) override {
+    pin_this_thread(cpu(worker.id()));
+  }
+
+  /**
+  @brief does nothing
+  */
+  void scheduler_epilogue(Worker&, std::exception_ptr) override {}
+
+  protected:
+
+  /**
+  @private
+  */
+  std::vector<size_t> _cpus;
+
+  /**
+  @private
+  */
+  CPUPinning() = default;
+
+  /**
+  @private
+  */
+  static CPUTopology::CPU _domains(const CPUTopology& topology, size_t c) {
+    return topology.empty() ? CPUTopology::CPU{} : topology[c % topology.num_cpus()];
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: CompactCPUPinning
+// ----------------------------------------------------------------------------
+
+/**
+@class CompactCPUPinning
+
+@brief class to create a worker interface that packs workers onto as few
+       cache domains as possible
+
+The available CPUs (see tf::available_cpus) are ordered by their NUMA node,
+then by their L3 domain, and then by their id, such that consecutive
+workers share the same L3 cache and a NUMA node fills up before the next one.
+Compact placement suits workloads whose tasks share data.
+
+@code{.cpp}
+auto pinning = std::make_shared<tf::CompactCPUPinning>();
+tf::Executor executor(pinning->cpus().size(), pinning->topology(), pinning);
+@endcode
+*/
+class CompactCPUPinning : public CPUPinning {
+
+  public:
+
+  /**
+  @brief constructs a compact pinning of the available CPUs
+
+  @param topology topology of the machine (default tf::CPUTopology::system)
+  */
+  explicit CompactCPUPinning(const CPUTopology& topology = CPUTopology::system()) {
+    _cpus = available_cpus();
+    std::stable_sort(_cpus.begin(), _cpus.end(), [&](size_t a, size_t b){
+      auto x = _domains(topology, a);
+      auto y = _domains(topology, b);
+      return std::tie(x.numa, x.l3) < std::tie(y.numa, y.l3);
+    });
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: ScatterCPUPinning
+// ----------------------------------------------------------------------------
+
+/**
+@class ScatterCPUPinning
+
+@brief class to create a worker interface that spreads workers across
+       cache domains
+
+The available CPUs (see tf::available_cpus) are dealt round-robin
+across the L3 domains, which are interleaved across the NUMA nodes,
+such that consecutive workers use different NUMA nodes and L3 caches.
+Scatter placement suits memory-bound workloads that benefit from
+the aggregate cache capacity and memory bandwidth, especially when
+the executor has fewer workers than CPUs.
+
+@code{.cpp}
+// four workers on a two-socket machine use both sockets
+auto pinning = std::make_shared<tf::ScatterCPUPinning>();
+tf::Executor executor(4, pinning->topology(), pinning);
+@endcode
+*/
+class ScatterCPUPinning : public CPUPinning {
+
+  public:
+
+  /**
+  @brief constructs a scatter pinning of the available CPUs
+
+  @param topology topology of the machine (default tf::CPUTopology::system)
+  */
+  explicit ScatterCPUPinning(const CPUTopology& topology = CPUTopology::system()) {
+
+    // group the CPUs by their L3 domain, ordered by NUMA node
+    auto cpus = available_cpus();
+    std::stable_sort(cpus.begin(), cpus.end(), [&](size_t a, size_t b){
+      auto x = _domains(topology, a);
+      auto y = _domains(topology, b);
+      return std::tie(x.numa, x.l3) < std::tie(y.numa, y.l3);
+    });
+
+    // (rank of the domain within its NUMA node, NUMA node, CPUs)
+    std::vector<std::tuple<size_t, size_t, std::vector<size_t>>> domains;
+    for(size_t i=0; i<cpus.size(); ++i) {
+      auto d = _domains(topology, cpus[i]);
+      if(i == 0 || d.l3 != _domains(topology, cpus[i-1]).l3 ||
+                   d.numa != _domains(topology, cpus[i-1]).numa) {
+        size_t rank = (!domains.empty() && std::get<1>(domains.back()) == d.numa) ?
+                      std::get<0>(domains.back()) + 1 : 0;
+        domains.emplace_back(rank, d.numa, std::vector<size_t>{});
+      }
+      std::get<2>(domains.back()).push_back(cpus[i]);
+    }
+
+    // interleave the NUMA nodes: the first domain of each node,
+    // then the second domain of each node, and so on
+    std::stable_sort(domains.begin(), domains.end(), [](const auto& x, const auto& y){
+      return std::tie(std::get<0>(x), std::get<1>(x)) < std::tie(std::get<0>(y), std::get<1>(y));
+    });
+
+    for(size_t k=0; _cpus.size() < cpus.size(); ++k) {
+      for(auto& d : domains) {
+        if(k < std::get<2>(d).size()) {
+          _cpus.push_back(std::get<2>(d)[k]);
+        }
+      }
+    }
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------
@@ -26,12 +26,24 @@ class ChromeTracingObserver;
 class TFProfObserver;
 class TFProfManager;
 
+class RunHandle;
+
 template <typename T>
 class Future;
 
+class FutureAwaiters;
+
+template <typename P>
+class AsyncPromise;
+
 template <typename...Fs>
 class Pipeline;
 
+template <typename T>
+class Coro;
+
+class CoroPromiseBase;
+
 // ----------------------------------------------------------------------------
 // cudaFlow
 // ----------------------------------------------------------------------------
@@ -18,9 +18,10 @@ struct NSTATE {
   constexpr static underlying_type PREEMPTED      = 0x20000000;  
   constexpr static underlying_type RETAIN_SUBFLOW = 0x40000000;
   constexpr static underlying_type JOINED_SUBFLOW = 0x80000000;
+  constexpr static underlying_type DIRTY          = 0x08000000;  // modified since compile
 
   // mask to isolate state bits - non-state bits store # weak dependents
-  constexpr static underlying_type MASK        = 0xF0000000;
+  constexpr static underlying_type MASK        = 0xF8000000;
 };
 
 using nstate_t = NSTATE::underlying_type;
@@ -38,18 +39,6 @@ struct ESTATE {
 
 using estate_t = ESTATE::underlying_type;
 
-// async-specific states
-struct ASTATE {
-  
-  using underlying_type = int;
-
-  constexpr static underlying_type UNFINISHED = 0;
-  constexpr static underlying_type LOCKED     = 1;
-  constexpr static underlying_type FINISHED   = 2;
-};
-
-using astate_t = ASTATE::underlying_type;
-
 // Procedure: throw_re
 // Throws runtime error under a given error code.
 template <typename... ArgsT>
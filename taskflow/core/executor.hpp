@@ -4,14 +4,200 @@
 #include "taskflow.hpp"
 #include "async_task.hpp"
 #include "freelist.hpp"
+#include "spin_policy.hpp"
+#include "cpu_pinning.hpp"
+#include "timer_wheel.hpp"
 
 /**
 @file executor.hpp
 @brief executor include file
 */
 
+#ifndef TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE
+  /**
+  @def TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE
+
+  This macro defines the minimum number of tasks each worker resets
+  when the executor spreads the set-up of a repeated run
+  (e.g., tf::Executor::run_n) across the workers.
+  Graphs smaller than twice this size are set up by a single worker.
+  */
+  #define TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE 16384
+#endif
+
+#ifndef TF_DEFAULT_AFFINITY_THRESHOLD
+  /**
+  @def TF_DEFAULT_AFFINITY_THRESHOLD
+
+  This macro defines the default time in nanoseconds a task delivered 
+  to the mailbox of its preferred worker (see tf::Task::affinity) waits
+  for that worker before other workers may steal it.
+  */
+  #define TF_DEFAULT_AFFINITY_THRESHOLD 100000
+#endif
+
+#ifndef TF_DEFAULT_TIMER_RESOLUTION
+  /**
+  @def TF_DEFAULT_TIMER_RESOLUTION
+
+  This macro defines the length in nanoseconds of a tick of the timer wheel
+  behind tf::Executor::async_at, tf::Executor::async_after, and
+  tf::Executor::run_every.
+  Timers expire at the first tick at or after their deadline.
+  */
+  #define TF_DEFAULT_TIMER_RESOLUTION 100000
+#endif
+
 namespace tf {
 
+// ----------------------------------------------------------------------------
+// ArenaParams
+// ----------------------------------------------------------------------------
+
+/**
+@struct ArenaParams
+
+@brief struct to describe an arena of workers in an executor
+
+An executor constructed with a list of arenas divides its workers into
+disjoint groups in the order of the list.
+Each arena has its own queues for the tasks submitted to it, 
+and its workers run only the tasks of the arena,
+such that a flood of tasks in one arena (e.g., background work) 
+does not delay the tasks of another (e.g., interactive requests).
+The number of workers of an arena bounds the concurrency of its tasks.
+
+@code{.cpp}
+tf::Executor executor({
+  {"interactive", 2},
+  {"background", 6, true}   // idle background workers help interactive tasks
+});
+
+tf::TaskParams params;
+params.arena = executor.arena_id("background");
+executor.silent_async(params, [](){ compact_database(); });
+
+taskflow.arena(executor.arena_id("interactive"));
+executor.run(taskflow).wait();
+@endcode
+
+Taskflows choose an arena through tf::Taskflow::arena and asynchronous tasks 
+through tf::TaskParams::arena. 
+Tasks without an arena run in the arena of the worker that schedules them, 
+or in the first arena if scheduled from a thread outside the executor.
+*/
+struct ArenaParams {
+
+  /**
+  @brief name of the arena
+  */
+  std::string name;
+
+  /**
+  @brief number of workers in the arena
+  */
+  size_t num_workers {1};
+
+  /**
+  @brief whether the workers of the arena steal tasks from other arenas
+         when they run out of tasks
+
+  Workers that steal from other arenas look for tasks in all arenas
+  before going to sleep, but they are only woken up by 
+  the tasks of their own arena.
+  */
+  bool steal {false};
+};
+
+// ----------------------------------------------------------------------------
+// PeriodicRun
+// ----------------------------------------------------------------------------
+
+/**
+@class PeriodicRun
+
+@brief class to cancel the periodic run of a taskflow
+
+A tf::PeriodicRun is returned by tf::Executor::run_every.
+The executor keeps running the taskflow periodically until the run is
+cancelled or the executor is destroyed, regardless of whether the handle
+is kept.
+
+@code{.cpp}
+tf::PeriodicRun heartbeat = executor.run_every(std::chrono::milliseconds(100), taskflow);
+
+// do something else
+
+heartbeat.cancel();       // no more runs start after this call
+executor.wait_for_all();  // waits for the run in flight, if any
+@endcode
+*/
+class PeriodicRun {
+
+  friend class Executor;
+
+  public:
+
+    /**
+    @brief constructs a handle that refers to no periodic run
+    
+    An empty handle counts as cancelled.
+    */
+    PeriodicRun() = default;
+
+    /**
+    @brief cancels the periodic run
+
+    No run of the taskflow starts after this call returns,
+    and a run that is already in flight continues to finish.
+    The taskflow must remain alive until that run completes
+    (e.g., by calling tf::Executor::wait_for_all).
+    */
+    void cancel() {
+      if(_state) {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->cancelled = true;
+        _state->cv.wait(lock, [this](){ return !_state->starting; });
+      }
+    }
+
+    /**
+    @brief queries if the periodic run is cancelled
+    */
+    bool cancelled() const {
+      if(_state) {
+        std::lock_guard<std::mutex> lock(_state->mutex);
+        return _state->cancelled;
+      }
+      return true;
+    }
+
+  private:
+
+    // the timer thread marks a run as starting under the mutex and starts
+    // it outside the mutex, and cancel waits for a run that is starting,
+    // such that no run starts once cancel returns
+    struct State {
+
+      State(Taskflow& f, uint64_t p, uint64_t t) : taskflow {f}, period {p}, tick {t} {
+      }
+
+      mutable std::mutex mutex;
+      std::condition_variable cv;
+      bool cancelled {false};
+      bool starting {false};
+      Taskflow& taskflow;
+      uint64_t period;
+      uint64_t tick;
+      std::atomic<bool> running {false};
+    };
+
+    std::shared_ptr<State> _state;
+
+    explicit PeriodicRun(std::shared_ptr<State> s) : _state {std::move(s)} {
+    }
+};
+
 // ----------------------------------------------------------------------------
 // Executor Definition
 // ----------------------------------------------------------------------------
@@ -56,27 +242,142 @@ class Executor {
   friend class Subflow;
   friend class Runtime;
   friend class Algorithm;
+  friend class CoroPromiseBase;
+  friend class AsyncTask;
+  
+  template <typename T>
+  friend class Future;
+
+  template <typename P>
+  friend class AsyncPromise;
 
   public:
 
   /**
   @brief constructs the executor with @c N worker threads
 
-  @param N number of workers (default std::thread::hardware_concurrency)
+  @param N number of workers (default tf::available_concurrency)
   @param wix interface class instance to configure workers' behaviors
+  @param spin policy to decide how long idle workers spin before sleeping
 
   The constructor spawns @c N worker threads to run tasks in a
   work-stealing loop. The number of workers must be greater than zero
   or an exception will be thrown.
-  By default, the number of worker threads is equal to the maximum
-  hardware concurrency returned by std::thread::hardware_concurrency.
+  By default, the number of worker threads is equal to the number of
+  logical CPUs the process may run on, returned by tf::available_concurrency,
+  which respects the cpuset of a container unlike std::thread::hardware_concurrency.
+
+  Users can alter the worker behavior, such as pinning workers to CPUs
+  (see tf::CPUPinning, tf::CompactCPUPinning, and tf::ScatterCPUPinning),
+  via deriving an instance from tf::WorkerInterface, 
+  and trade the wake-up latency of idle workers for CPU time
+  via deriving an instance from tf::SpinPolicy.
+  */
+  explicit Executor(
+    size_t N = available_concurrency(),
+    std::shared_ptr<WorkerInterface> wix = nullptr,
+    std::shared_ptr<SpinPolicy> spin = nullptr
+  );
+  
+  /**
+  @brief constructs the executor with @c N worker threads and the given CPU topology
+
+  @param N number of workers
+  @param topology CPU topology to guide the victim selection of work stealing
+  @param wix interface class instance to configure workers' behaviors
+  @param spin policy to decide how long idle workers spin before sleeping
+
+  Worker @c i is associated with the logical CPU at index <tt>i % topology.num_cpus()</tt>.
+  When running out of tasks, a worker first steals from workers that share
+  the same L3 cache, then from workers on the same NUMA node, and 
+  finally from any worker.
+  The constructor without a topology uses tf::CPUTopology::system.
+  
+  @code{.cpp}
+  // emulate a two-socket machine of four CPUs on any machine
+  tf::Executor executor(4, tf::CPUTopology({{0, 0}, {0, 0}, {1, 1}, {1, 1}}));
+  @endcode
+
+  Users can pin worker @c i to the corresponding CPU via tf::WorkerInterface 
+  to make the victim selection reflect the actual cache and memory locality.
+  */
+  Executor(
+    size_t N,
+    const CPUTopology& topology,
+    std::shared_ptr<WorkerInterface> wix = nullptr,
+    std::shared_ptr<SpinPolicy> spin = nullptr
+  );
+  
+  /**
+  @brief constructs an elastic executor that starts with @c N worker threads
+         and can grow up to @c M worker threads
+
+  @param N initial number of workers
+  @param M maximum number of workers
+  @param wix interface class instance to configure workers' behaviors
+  @param spin policy to decide how long idle workers spin before sleeping
 
-  Users can alter the worker behavior, such as changing thread affinity,
-  via deriving an instance from tf::WorkerInterface.
+  The executor reserves the queues and the notification slots of @c M workers
+  upfront but only spawns @c N of them.
+  You can change the number of running workers between @c 1 and @c M 
+  at any time using tf::Executor::resize.
+  Since workers steal from all @c M queues, 
+  a large gap between @c N and @c M trades some stealing efficiency for elasticity.
+
+  @code{.cpp}
+  tf::Executor executor(4, 32);    // 4 running workers, up to 32
+  executor.resize(32);             // grows to 32 workers during the peak hours
+  executor.resize(2);              // shrinks to 2 workers afterwards
+  @endcode
+  */
+  Executor(
+    size_t N, 
+    size_t M, 
+    std::shared_ptr<WorkerInterface> wix = nullptr,
+    std::shared_ptr<SpinPolicy> spin = nullptr
+  );
+  
+  /**
+  @brief constructs an elastic executor that starts with @c N worker threads,
+         can grow up to @c M worker threads, and uses the given CPU topology
+
+  @param N initial number of workers
+  @param M maximum number of workers
+  @param topology CPU topology to guide the victim selection of work stealing
+  @param wix interface class instance to configure workers' behaviors
+  @param spin policy to decide how long idle workers spin before sleeping
+  */
+  Executor(
+    size_t N, 
+    size_t M, 
+    const CPUTopology& topology,
+    std::shared_ptr<WorkerInterface> wix = nullptr,
+    std::shared_ptr<SpinPolicy> spin = nullptr
+  );
+
+  /**
+  @brief constructs an executor whose workers are divided into arenas
+
+  @param arenas parameters of the arenas (see tf::ArenaParams)
+  @param wix interface class instance to configure workers' behaviors
+  @param spin policy to decide how long idle workers spin before sleeping
+
+  The constructor spawns the workers of all arenas, where the workers of 
+  arena @c i take the ids following the workers of arena <tt>i-1</tt>.
+  Each arena must have at least one worker or an exception will be thrown.
+  The number of workers of an executor with multiple arenas is fixed,
+  and calling tf::Executor::resize throws an exception.
+
+  @code{.cpp}
+  tf::Executor executor({{"interactive", 2}, {"background", 6}});
+  executor.num_workers();               // 8
+  executor.arena_id("background");      // 1
+  @endcode
   */
   explicit Executor(
-    size_t N = std::thread::hardware_concurrency(),
-    std::shared_ptr<WorkerInterface> wix = nullptr
+    const std::vector<ArenaParams>& arenas,
+    std::shared_ptr<WorkerInterface> wix = nullptr,
+    std::shared_ptr<SpinPolicy> spin = nullptr
   );
 
   /**
@@ -419,6 +720,96 @@ class Executor {
   template<typename P, typename C>
   tf::Future<void> run_until(Taskflow&& taskflow, P&& pred, C&& callable);
 
+  /**
+  @brief runs a taskflow once and returns a lightweight completion handle
+
+  @param taskflow a tf::Taskflow object
+
+  @return a tf::RunHandle to wait for the execution
+
+  This member function behaves like tf::Executor::run but returns
+  a tf::RunHandle instead of a tf::Future.
+  A tf::RunHandle completes through an atomic flag in the topology
+  of the run rather than the shared state of a std::promise,
+  which saves the allocations and the synchronization of the promise
+  when submitting many small taskflows at a high rate.
+
+  @code{.cpp}
+  tf::RunHandle handle = executor.submit(taskflow);
+  // do something else
+  handle.wait();
+  @endcode
+
+  This member function is thread-safe.
+
+  @attention
+  The executor does not own the given taskflow. It is your responsibility to
+  ensure the taskflow remains alive during its execution.
+  */
+  tf::RunHandle submit(Taskflow& taskflow);
+
+  /**
+  @brief runs a taskflow for @c N times and returns a lightweight completion handle
+
+  @param taskflow a tf::Taskflow object
+  @param N number of runs
+
+  @return a tf::RunHandle to wait for the execution
+
+  This member function behaves like tf::Executor::run_n but returns
+  a tf::RunHandle instead of a tf::Future.
+
+  This member function is thread-safe.
+
+  @attention
+  The executor does not own the given taskflow. It is your responsibility to
+  ensure the taskflow remains alive during its execution.
+  */
+  tf::RunHandle submit_n(Taskflow& taskflow, size_t N);
+
+  /**
+  @brief runs a taskflow multiple times until the predicate becomes true,
+         then invokes a callback, and returns a lightweight completion handle
+
+  @param taskflow a tf::Taskflow object
+  @param pred a boolean predicate to return @c true for stop
+  @param callable a callable object to be invoked after this run completes
+
+  @return a tf::RunHandle to wait for the execution
+
+  This member function behaves like tf::Executor::run_until but returns
+  a tf::RunHandle instead of a tf::Future.
+
+  This member function is thread-safe.
+
+  @attention
+  The executor does not own the given taskflow. It is your responsibility to
+  ensure the taskflow remains alive during its execution.
+  */
+  template<typename P, typename C>
+  tf::RunHandle submit_until(Taskflow& taskflow, P&& pred, C&& callable);
+
+  /**
+  @brief runs a taskflow multiple times until the predicate becomes true
+         and returns a lightweight completion handle
+
+  @param taskflow a tf::Taskflow object
+  @param pred a boolean predicate to return @c true for stop
+
+  @return a tf::RunHandle to wait for the execution
+
+  This member function behaves like tf::Executor::run_until but returns
+  a tf::RunHandle instead of a tf::Future.
+
+  This member function is thread-safe.
+
+  @attention
+  The executor does not own the given taskflow. It is your responsibility to
+  ensure the taskflow remains alive during its execution.
+  */
+  template<typename P>
+  tf::RunHandle submit_until(Taskflow& taskflow, P&& pred);
+
   /**
   @brief runs a target graph and waits until it completes using 
          an internal worker of this executor
@@ -508,7 +899,7 @@ class Executor {
   @brief queries the number of worker threads
 
   Each worker represents one unique thread spawned by an executor
-  upon its construction time.
+  upon its construction time or by tf::Executor::resize.
 
   @code{.cpp}
   tf::Executor executor(4);
@@ -517,6 +908,117 @@ class Executor {
   */
   size_t num_workers() const noexcept;
   
+  /**
+  @brief queries the maximum number of worker threads
+
+  The maximum number of workers is fixed at the construction time of the
+  executor and bounds the number of workers tf::Executor::resize can spawn.
+
+  @code{.cpp}
+  tf::Executor executor(4, 8);
+  std::cout << executor.max_num_workers();    // 8
+  @endcode
+  */
+  size_t max_num_workers() const noexcept;
+
+  /**
+  @brief changes the number of running worker threads
+
+  @param N number of workers in the range <tt>[1, max_num_workers()]</tt>
+
+  When growing the pool, the executor spawns new worker threads that
+  immediately participate in the work-stealing loop.
+  When shrinking the pool, the executor retires the workers 
+  of the largest ids: each retiring worker finishes its current task,
+  leaves the work-stealing loop once it fails to steal,
+  and joins its thread.
+  Running topologies are not drained and the remaining
+  workers continue to run their tasks, including those left 
+  in the queues of the retired workers.
+  Worker interfaces, if any, invoke tf::WorkerInterface::scheduler_prologue
+  and tf::WorkerInterface::scheduler_epilogue for each spawned and retired worker.
+
+  @code{.cpp}
+  tf::Executor executor(8, 8);
+  executor.silent_async([](){ std::cout << "runs during the resize\n"; });
+  executor.resize(2);
+  std::cout << executor.num_workers();    // 2
+  @endcode
+
+  This member function is thread-safe but must not be called by a 
+  worker of the same executor, or an exception will be thrown.
+  */
+  void resize(size_t N);
+
+  /**
+  @brief acquires a snapshot of the scheduling metrics of all workers
+
+  The executor counts scheduling events on the hot paths of its workers,
+  including successful and failed steals, yields, sleeps, wake-up notifications,
+  spills of full worker queues into the shared buffers, executed tasks,
+  and the busy and idle time of each worker.
+  The counters are compiled in only when the macro 
+  @c TF_ENABLE_SCHEDULER_METRICS is defined; otherwise, 
+  they cost nothing and the returned snapshot is all zero.
+
+  @code{.cpp}
+  #define TF_ENABLE_SCHEDULER_METRICS
+  #include <taskflow/taskflow.hpp>
+
+  tf::Executor executor(4);
+  executor.run(taskflow).wait();
+  tf::ExecutorMetrics metrics = executor.metrics();
+  for(size_t w=0; w<metrics.workers.size(); w++) {
+    std::cout << "worker " << w << " ran " 
+              << metrics.workers[w].num_executed_tasks << " tasks\n";
+  }
+  @endcode
+
+  This member function is thread-safe.
+  */
+  ExecutorMetrics metrics() const;
+
+  /**
+  @brief sets how long a task with an affinity waits for its preferred worker
+
+  @param threshold time after which other workers may steal the task
+
+  A task with an affinity (see tf::Task::affinity) is delivered to 
+  the mailbox of its preferred worker, which checks the mailbox before
+  stealing tasks from others.
+  If the worker stays busy for longer than the threshold, idle workers
+  fall back to stealing the task from the mailbox.
+  A zero threshold lets idle workers steal tasks right away,
+  and a large threshold binds tasks to their preferred workers.
+  The default threshold is @c TF_DEFAULT_AFFINITY_THRESHOLD nanoseconds.
+
+  @code{.cpp}
+  executor.affinity_threshold(std::chrono::microseconds(500));
+  @endcode
+
+  This member function is thread-safe.
+  */
+  void affinity_threshold(std::chrono::nanoseconds threshold);
+
+  /**
+  @brief queries how long a task with an affinity waits for its preferred worker
+  */
+  std::chrono::nanoseconds affinity_threshold() const;
+  
+  /**
+  @brief queries the number of arenas of the executor
+
+  An executor constructed without arenas has one arena of all workers.
+  */
+  size_t num_arenas() const noexcept;
+
+  /**
+  @brief queries the id of the arena of the given name
+
+  Throws an exception if the executor has no arena of the name.
+  */
+  size_t arena_id(const std::string& name) const;
+
   /**
   @brief queries the number of workers that are currently not making any stealing attempts
   */
@@ -621,14 +1123,14 @@ class Executor {
   @param params task parameters
   @param func callable object
 
-  @return a @std_future that will hold the result of the execution
+  @return a tf::Future that will hold the result of the execution
   
   The method creates a parameterized asynchronous task 
-  to run the given function and return a @std_future object 
+  to run the given function and return a tf::Future object 
   that eventually will hold the result of the execution.
 
   @code{.cpp}
-  std::future<int> future = executor.async("name", [](){
+  tf::Future<int> future = executor.async("name", [](){
     std::cout << "create an asynchronous task with a name and returns 1\n";
     return 1;
   });
@@ -647,14 +1149,14 @@ class Executor {
 
   @param func callable object
 
-  @return a @std_future that will hold the result of the execution
+  @return a tf::Future that will hold the result of the execution
 
   The method creates an asynchronous task to run the given function
-  and return a @std_future object that eventually will hold the result
+  and return a tf::Future object that eventually will hold the result
   of the return value.
 
   @code{.cpp}
-  std::future<int> future = executor.async([](){
+  tf::Future<int> future = executor.async([](){
     std::cout << "create an asynchronous task and returns 1\n";
     return 1;
   });
@@ -717,45 +1219,111 @@ class Executor {
   template <typename F>
   void silent_async(F&& func);
 
-  // --------------------------------------------------------------------------
-  // Silent Dependent Async Methods
-  // --------------------------------------------------------------------------
-  
   /**
-  @brief runs the given function asynchronously 
-         when the given predecessors finish
+  @brief runs the given function asynchronously for each index in <tt>[0, n)</tt>
+         without returning any future object
 
+  @tparam P task parameters type
   @tparam F callable type
-  @tparam Tasks task types convertible to tf::AsyncTask
 
-  @param func callable object
-  @param tasks asynchronous tasks on which this execution depends
-  
-  @return a tf::AsyncTask handle 
-  
-  This member function is more efficient than tf::Executor::dependent_async
-  and is encouraged to use when you do not want a @std_future to
-  acquire the result or synchronize the execution.
-  The example below creates three asynchronous tasks, @c A, @c B, and @c C,
-  in which task @c C runs after task @c A and task @c B.
+  @param params task parameters shared by all tasks
+  @param n number of tasks
+  @param func callable object invocable with a @c size_t index
+
+  The method creates @c n parameterized asynchronous tasks,
+  where the @c i-th task calls <tt>func(i)</tt>.
+  Compared to @c n calls of tf::Executor::silent_async,
+  all tasks share one copy of @c func, which the last task to finish destroys,
+  and each chunk of tasks accounts for the executor in one update and
+  is published to the queues using one bulk push that wakes up at most
+  as many idle workers as it has tasks.
+  The method is encouraged to use when applications submit many independent
+  tasks at once, for instance, a batch of requests from an external thread.
 
   @code{.cpp}
-  tf::AsyncTask A = executor.silent_dependent_async([](){ printf("A\n"); });
-  tf::AsyncTask B = executor.silent_dependent_async([](){ printf("B\n"); });
-  executor.silent_dependent_async([](){ printf("C runs after A and B\n"); }, A, B);
+  std::vector<Request> requests = receive_batch();
+  tf::TaskParams params;
+  params.name = "serve";
+  executor.bulk_silent_async(params, requests.size(), [&](size_t i){
+    serve(requests[i]);
+  });
   executor.wait_for_all();
   @endcode
 
   This member function is thread-safe.
   */
-  template <typename F, typename... Tasks,
-    std::enable_if_t<all_same_v<AsyncTask, std::decay_t<Tasks>...>, void>* = nullptr
-  >
-  tf::AsyncTask silent_dependent_async(F&& func, Tasks&&... tasks);
+  template <typename P, typename F>
+  void bulk_silent_async(P&& params, size_t n, F&& func);
   
   /**
-  @brief runs the given function asynchronously 
-         when the given predecessors finish
+  @brief runs the given function asynchronously for each index in <tt>[0, n)</tt>
+         without returning any future object
+
+  @tparam F callable type
+
+  @param n number of tasks
+  @param func callable object invocable with a @c size_t index
+
+  The method creates @c n asynchronous tasks,
+  where the @c i-th task calls <tt>func(i)</tt>.
+  Compared to @c n calls of tf::Executor::silent_async,
+  all tasks share one copy of @c func, which the last task to finish destroys,
+  and each chunk of tasks accounts for the executor in one update and
+  is published to the queues using one bulk push that wakes up at most
+  as many idle workers as it has tasks.
+
+  @code{.cpp}
+  std::vector<int> data(10000);
+  executor.bulk_silent_async(data.size(), [&](size_t i){
+    data[i] = static_cast<int>(i);
+  });
+  executor.wait_for_all();
+  @endcode
+
+  This member function is thread-safe.
+  */
+  template <typename F>
+  void bulk_silent_async(size_t n, F&& func);
+
+  // --------------------------------------------------------------------------
+  // Silent Dependent Async Methods
+  // --------------------------------------------------------------------------
+  
+  /**
+  @brief runs the given function asynchronously 
+         when the given predecessors finish
+
+  @tparam F callable type
+  @tparam Tasks task types convertible to tf::AsyncTask
+
+  @param func callable object
+  @param tasks asynchronous tasks on which this execution depends
+  
+  @return a tf::AsyncTask handle 
+  
+  This member function is more efficient than tf::Executor::dependent_async
+  and is encouraged to use when you do not want a @std_future to
+  acquire the result or synchronize the execution.
+  The example below creates three asynchronous tasks, @c A, @c B, and @c C,
+  in which task @c C runs after task @c A and task @c B.
+
+  @code{.cpp}
+  tf::AsyncTask A = executor.silent_dependent_async([](){ printf("A\n"); });
+  tf::AsyncTask B = executor.silent_dependent_async([](){ printf("B\n"); });
+  executor.silent_dependent_async([](){ printf("C runs after A and B\n"); }, A, B);
+  executor.wait_for_all();
+  @endcode
+
+  This member function is thread-safe.
+  */
+  template <typename F, typename... Tasks,
+    std::enable_if_t<all_same_v<AsyncTask, std::decay_t<Tasks>...>, void>* = nullptr
+  >
+  tf::AsyncTask silent_dependent_async(F&& func, Tasks&&... tasks);
+  
+  /**
+  @brief runs the given function asynchronously 
+         when the given predecessors finish
   
   @tparam F callable type
   @tparam Tasks task types convertible to tf::AsyncTask
@@ -880,11 +1448,11 @@ class Executor {
   @param tasks asynchronous tasks on which this execution depends
   
   @return a pair of a tf::AsyncTask handle and 
-                    a @std_future that holds the result of the execution
+                    a tf::Future that holds the result of the execution
   
   The example below creates three asynchronous tasks, @c A, @c B, and @c C,
   in which task @c C runs after task @c A and task @c B.
-  Task @c C returns a pair of its tf::AsyncTask handle and a std::future<int>
+  Task @c C returns a pair of its tf::AsyncTask handle and a tf::Future<int>
   that eventually will hold the result of the execution.
 
   @code{.cpp}
@@ -924,11 +1492,11 @@ class Executor {
   @param tasks asynchronous tasks on which this execution depends
   
   @return a pair of a tf::AsyncTask handle and 
-                    a @std_future that holds the result of the execution
+                    a tf::Future that holds the result of the execution
   
   The example below creates three named asynchronous tasks, @c A, @c B, and @c C,
   in which task @c C runs after task @c A and task @c B.
-  Task @c C returns a pair of its tf::AsyncTask handle and a std::future<int>
+  Task @c C returns a pair of its tf::AsyncTask handle and a tf::Future<int>
   that eventually will hold the result of the execution.
   Assigned task names will appear in the observers of the executor.
 
@@ -969,11 +1537,11 @@ class Executor {
   @param last iterator to the end (exclusive)
   
   @return a pair of a tf::AsyncTask handle and 
-                    a @std_future that holds the result of the execution
+                    a tf::Future that holds the result of the execution
   
   The example below creates three asynchronous tasks, @c A, @c B, and @c C,
   in which task @c C runs after task @c A and task @c B.
-  Task @c C returns a pair of its tf::AsyncTask handle and a std::future<int>
+  Task @c C returns a pair of its tf::AsyncTask handle and a tf::Future<int>
   that eventually will hold the result of the execution.
 
   @code{.cpp}
@@ -1016,11 +1584,11 @@ class Executor {
   @param last iterator to the end (exclusive)
   
   @return a pair of a tf::AsyncTask handle and 
-                    a @std_future that holds the result of the execution
+                    a tf::Future that holds the result of the execution
   
   The example below creates three named asynchronous tasks, @c A, @c B, and @c C,
   in which task @c C runs after task @c A and task @c B.
-  Task @c C returns a pair of its tf::AsyncTask handle and a std::future<int>
+  Task @c C returns a pair of its tf::AsyncTask handle and a tf::Future<int>
   that eventually will hold the result of the execution.
   Assigned task names will appear in the observers of the executor.
 
@@ -1050,13 +1618,302 @@ class Executor {
     std::enable_if_t<is_task_params_v<P> && !std::is_same_v<std::decay_t<I>, AsyncTask>, void>* = nullptr
   >
   auto dependent_async(P&& params, F&& func, I first, I last);
+  
+  // --------------------------------------------------------------------------
+  // Combinators
+  // --------------------------------------------------------------------------
+
+  /**
+  @brief creates an asynchronous task that finishes when all tasks
+         in the given range finish
+
+  @tparam I iterator type
+
+  @param first iterator to the beginning (inclusive)
+  @param last iterator to the end (exclusive)
+
+  @return a pair of a tf::AsyncTask handle and 
+                    a tf::Future that holds the combined results
+
+  The range holds either tf::AsyncTask handles or the pairs of a tf::AsyncTask 
+  handle and a tf::Future returned by tf::Executor::dependent_async.
+  For tf::AsyncTask handles, the returned future is a tf::Future<void>.
+  For pairs, the futures are moved out of the range, and the returned future 
+  holds a std::vector of their results in the order of the range,
+  or is a tf::Future<void> if the results are @c void.
+  If any of the tasks throws, the returned future rethrows 
+  the exception of the first such task in the range.
+
+  @code{.cpp}
+  std::vector<std::pair<tf::AsyncTask, tf::Future<int>>> tasks;
+  for(int i=0; i<10; i++) {
+    tasks.push_back(executor.dependent_async([i](){ return i; }));
+  }
+  auto [all, fu] = executor.when_all(tasks.begin(), tasks.end());
+  std::vector<int> results = fu.get();  // 0, 1, 2, ..., 9
+  @endcode
+
+  The combined task is a dependent async task that depends on all tasks
+  in the range, so you can also use its tf::AsyncTask handle 
+  as a dependency of other dependent async tasks.
+
+  This member function is thread-safe.
+  */
+  template <typename I>
+  auto when_all(I first, I last);
+  
+  /**
+  @brief creates an asynchronous task that finishes when any task
+         in the given range finishes
+
+  @tparam I iterator type
+
+  @param first iterator to the beginning (inclusive)
+  @param last iterator to the end (exclusive)
+
+  @return a pair of a tf::AsyncTask handle and 
+                    a tf::Future that holds the result of a finished task
+
+  The range holds either tf::AsyncTask handles or the pairs of a tf::AsyncTask 
+  handle and a tf::Future returned by tf::Executor::dependent_async,
+  and must not be empty.
+  For tf::AsyncTask handles, the returned future holds the index of a task 
+  that has finished.
+  For pairs, the futures are moved out of the range, and the returned future 
+  holds a @std_pair of the index of a task that has finished and its result,
+  or the index alone if the results are @c void.
+  If that task throws, the returned future rethrows its exception.
+
+  The combined task runs as soon as the first task in the range finishes.
+  The other tasks keep running until they finish, and their results are ignored.
+  This suits speculative execution, such as hedging a query across 
+  multiple replicas and taking the fastest answer:
+
+  @code{.cpp}
+  std::atomic<bool> answered {false};
+  std::vector<std::pair<tf::AsyncTask, tf::Future<int>>> replicas;
+  for(int r=0; r<3; r++) {
+    replicas.push_back(executor.dependent_async([r, &answered](){ 
+      return query(r, answered);  // may return early once answered is set
+    }));
+  }
+  auto [any, fu] = executor.when_any(replicas.begin(), replicas.end());
+  auto [winner, answer] = fu.get();
+  answered = true;  // tell the losers to stop early
+  @endcode
+
+  The combined task does not wait for the other tasks but retains itself
+  until all of them finish, since each task in the range 
+  refers to the combined task until it finishes.
+
+  This member function is thread-safe.
+  */
+  template <typename I>
+  auto when_any(I first, I last);
+
+  // --------------------------------------------------------------------------
+  // Timer Methods
+  // --------------------------------------------------------------------------
+
+  /**
+  @brief creates a parameterized asynchronous task that runs at the given time
+
+  @tparam P task parameter type
+  @tparam C clock type
+  @tparam D duration type
+  @tparam F callable type
+
+  @param params task parameters
+  @param tp time point at which the task becomes ready to run
+  @param func callable object
+
+  @return a tf::Future that will hold the result of the execution
+
+  The task waits in the timer wheel of the executor, which costs no worker
+  and no thread of its own, and is scheduled as an asynchronous task
+  (see tf::Executor::async) at the first tick of the wheel at or after 
+  the given time (see @c TF_DEFAULT_TIMER_RESOLUTION).
+  A time point that has already passed schedules the task immediately.
+  Like other asynchronous tasks, a pending task counts towards 
+  tf::Executor::wait_for_all. The destruction of the executor does not
+  wait for the time of a pending task but drops the task, whose future
+  then reports @c std::future_errc::broken_promise.
+
+  @code{.cpp}
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  tf::Future<int> future = executor.async_at("timeout", deadline, [](){
+    return 1;
+  });
+  @endcode
+
+  This member function is thread-safe.
+  */
+  template <typename P, typename C, typename D, typename F>
+  auto async_at(P&& params, const std::chrono::time_point<C, D>& tp, F&& func);
+
+  /**
+  @brief creates an asynchronous task that runs at the given time
+
+  @tparam C clock type
+  @tparam D duration type
+  @tparam F callable type
+
+  @param tp time point at which the task becomes ready to run
+  @param func callable object
+
+  @return a tf::Future that will hold the result of the execution
+
+  This member function is equivalent to 
+  <tt>async_at(tf::DefaultTaskParams{}, tp, func)</tt>.
+
+  @code{.cpp}
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  executor.async_at(deadline, [](){ std::cout << "one second later\n"; });
+  @endcode
+
+  This member function is thread-safe.
+  */
+  template <typename C, typename D, typename F>
+  auto async_at(const std::chrono::time_point<C, D>& tp, F&& func);
+
+  /**
+  @brief creates a parameterized asynchronous task that runs after the given delay
+
+  @tparam P task parameter type
+  @tparam R arithmetic type of the duration
+  @tparam T period type of the duration
+  @tparam F callable type
+
+  @param params task parameters
+  @param delay duration after which the task becomes ready to run
+  @param func callable object
+
+  @return a tf::Future that will hold the result of the execution
+
+  This member function is equivalent to
+  <tt>async_at(params, std::chrono::steady_clock::now() + delay, func)</tt>,
+  except that a deadline beyond the latest time point of the steady clock,
+  such as the one of <tt>std::chrono::hours::max()</tt>, saturates 
+  at that time point instead of overflowing.
+
+  This member function is thread-safe.
+  */
+  template <typename P, typename R, typename T, typename F>
+  auto async_after(P&& params, const std::chrono::duration<R, T>& delay, F&& func);
+
+  /**
+  @brief creates an asynchronous task that runs after the given delay
+
+  @tparam R arithmetic type of the duration
+  @tparam T period type of the duration
+  @tparam F callable type
+
+  @param delay duration after which the task becomes ready to run
+  @param func callable object
+
+  @return a tf::Future that will hold the result of the execution
+
+  @code{.cpp}
+  auto future = executor.async_after(std::chrono::milliseconds(5), [](){
+    return flush_logs();
+  });
+  @endcode
+
+  This member function is thread-safe.
+  */
+  template <typename R, typename T, typename F>
+  auto async_after(const std::chrono::duration<R, T>& delay, F&& func);
+
+  /**
+  @brief runs a taskflow periodically
+
+  @param period time between the starts of two runs
+  @param taskflow taskflow object
+
+  @return a tf::PeriodicRun handle to cancel the periodic run
+
+  The first run starts one period after the call, and the following runs
+  start at multiples of the period from there, as driven by the timer wheel
+  of the executor. A run whose start comes while the previous run
+  is still in flight is skipped, such that runs of a slow taskflow
+  do not pile up.
+  The periodic run continues until it is cancelled through the returned 
+  handle or the executor is destroyed. Periodic runs do not count towards 
+  tf::Executor::wait_for_all, except for the run in flight.
+
+  @code{.cpp}
+  tf::Taskflow taskflow;
+  taskflow.emplace([](){ report_metrics(); });
+
+  auto handle = executor.run_every(std::chrono::milliseconds(100), taskflow);
+  
+  // do something else
+
+  handle.cancel();
+  executor.wait_for_all();
+  @endcode
+
+  This member function is thread-safe.
+
+  @attention
+  The executor does not own the given taskflow. It is your responsibility to
+  ensure the taskflow remains alive until the periodic run is cancelled
+  and its last run completes.
+  */
+  PeriodicRun run_every(std::chrono::nanoseconds period, Taskflow& taskflow);
 
   private:
+
+  // an arena owns the workers [beg, end), the partition of the shared
+  // buffers for tasks submitted to it, and the notifier of its workers
+  struct Arena {
+
+    Arena(const ArenaParams& p, size_t b) :
+      name {p.name}, beg {b}, end {b + p.num_workers}, steal {p.steal},
+      notifier (p.num_workers) {
+    }
+
+    std::string name;
+    size_t beg;
+    size_t end;
+    bool steal;
+    DefaultNotifier notifier;
+
+    // workers of the arena that busy-poll the queues for tasks and thus 
+    // pick up new tasks without being notified
+    std::atomic<size_t> num_idle_pollers {0};
+  };
+
+  // a timer expires either an asynchronous task, which is counted as
+  // a topology until it runs, the next start of a periodic run, or 
+  // the threshold of the mailbox of a worker
+  struct Timer {
+    Node* node {nullptr};
+    std::shared_ptr<PeriodicRun::State> periodic;
+    Worker* mailbox {nullptr};
+  };
+
+  // the timer thread is started by the first timer and sleeps until the
+  // next tick at which the wheel has work to do; once the executor starts
+  // to be destroyed, pending asynchronous tasks and periodic runs are
+  // dropped
+  struct Timers {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::thread thread;
+    TimerWheel<Timer> wheel;
+    std::chrono::steady_clock::time_point origin {std::chrono::steady_clock::now()};
+    uint64_t deadline {TimerWheel<Timer>::NO_TICK};
+    bool draining {false};
+    bool done {false};
+  };
     
   std::mutex _taskflows_mutex;
+  std::mutex _workers_mutex;
   
   std::vector<Worker> _workers;
-  DefaultNotifier _notifier;
+  std::atomic<size_t> _num_workers {0};
+  std::vector<std::unique_ptr<Arena>> _arenas;
 
 #if __cplusplus >= TF_CPP20
   std::atomic<size_t> _num_topologies {0};
@@ -1071,30 +1928,83 @@ class Executor {
   Freelist<Node*> _buffers;
 
   std::shared_ptr<WorkerInterface> _worker_interface;
+  std::shared_ptr<SpinPolicy> _spin_policy;
   std::unordered_set<std::shared_ptr<ObserverInterface>> _observers;
 
+  std::atomic<int64_t> _affinity_threshold {TF_DEFAULT_AFFINITY_THRESHOLD};
+
+  Timers _timers;
+
+  Executor(
+    const std::vector<ArenaParams>&, 
+    size_t, 
+    const CPUTopology&, 
+    std::shared_ptr<WorkerInterface>, 
+    std::shared_ptr<SpinPolicy>
+  );
+
+  static size_t _num_arena_workers(const std::vector<ArenaParams>&);
+  static std::vector<size_t> _arena_sizes(const std::vector<ArenaParams>&);
+
   void _observer_prologue(Worker&, Node*);
   void _observer_epilogue(Worker&, Node*);
-  void _spawn(size_t);
+  void _spawn(size_t, size_t);
+  void _build_victims(const CPUTopology&);
   void _exploit_task(Worker&, Node*&);
-  bool _explore_task(Worker&, Node*&);
+  bool _explore_task(Worker&, Node*&, size_t&);
   void _schedule(Worker&, Node*);
   void _schedule(Node*);
   void _set_up_topology(Worker*, Topology*);
+  bool _set_up_flat_graph(Taskflow&, Topology*);
+  void _record_flat_graph(Taskflow&, Topology*);
+  void _rerun_topology(Worker&, Topology*);
   void _tear_down_topology(Worker&, Topology*);
   void _tear_down_async(Worker&, Node*, Node*&);
   void _tear_down_dependent_async(Worker&, Node*, Node*&);
   void _tear_down_invoke(Worker&, Node*, Node*&);
-  void _increment_topology();
+  void _increment_topology(size_t = 1);
   void _decrement_topology();
   void _invoke(Worker&, Node*);
   void _invoke_static_task(Worker&, Node*);
   void _invoke_condition_task(Worker&, Node*, SmallVector<int>&);
   void _invoke_multi_condition_task(Worker&, Node*, SmallVector<int>&);
-  void _process_async_dependent(Node*, tf::AsyncTask&, size_t&);
+  void _process_async_dependent(Node*, tf::AsyncTask&, Node::AsyncLink&, size_t&);
+  bool _release_any(Node*);
+  bool _link_async_successor(tf::AsyncTask&, Node::AsyncLink&);
+
+  template <typename I>
+  void _process_async_dependents(Node*, I, I, size_t&);
+
+  template <typename C>
+  auto _when_any(std::vector<AsyncTask>, C&&);
   void _process_exception(Worker&, Node*);
   void _schedule_async_task(Node*);
   void _update_cache(Worker&, Node*&, Node*);
+  
+  size_t _select_victim(Worker&, size_t);
+  Node* _steal(Worker&, size_t);
+  Node* _steal_mail(Worker&, Worker&);
+  static int64_t _steady_time_ns();
+  bool _is_mailed(unsigned, size_t) const;
+  size_t _arena_of(Node*, size_t) const;
+  void _deliver(Node*, unsigned);
+  void _notify(size_t, size_t);
+  void _drain_mailbox(Worker&);
+  void _arm_mailbox(Worker&, int64_t);
+  uint64_t _timer_tick(std::chrono::steady_clock::time_point) const;
+
+  template <typename R, typename T>
+  static std::chrono::steady_clock::time_point _time_after(
+    std::chrono::steady_clock::time_point, const std::chrono::duration<R, T>&
+  );
+
+  void _insert_timer(uint64_t, Timer);
+  bool _expire_periodic(Timer&);
+  void _start_periodic(std::shared_ptr<PeriodicRun::State>);
+  void _timer_loop();
+  void _drain_timers();
+  void _drop_async_task(Node*);
+  void _shut_down_timers();
 
   bool _wait_for_task(Worker&, Node*&);
   bool _invoke_subflow_task(Worker&, Node*);
@@ -1103,8 +2013,16 @@ class Executor {
   bool _invoke_async_task(Worker&, Node*);
   bool _invoke_dependent_async_task(Worker&, Node*);
   bool _invoke_runtime_task(Worker&, Node*);
-  bool _invoke_runtime_task_impl(Worker&, Node*, std::function<void(Runtime&)>&);
-  bool _invoke_runtime_task_impl(Worker&, Node*, std::function<void(Runtime&, bool)>&);
+  bool _invoke_runtime_task_impl(Worker&, Node*, SmallFunction<void(Runtime&)>&);
+  bool _invoke_runtime_task_impl(Worker&, Node*, SmallFunction<void(Runtime&, bool)>&);
+
+#if __cplusplus >= TF_CPP20
+  bool _invoke_coroutine_task(Worker&, Node*, Node::Coroutine&);
+  void _await_async_task(CoroPromiseBase*, AsyncTask&);
+  bool _await_future(CoroPromiseBase*, FutureAwaiters&);
+  void _await_graph(CoroPromiseBase*, Graph&);
+  static void _resume_awaiters(FutureAwaiters&);
+#endif
 
   template <typename I>
   I _set_up_graph(I, I, Topology*, Node*);
@@ -1124,28 +2042,122 @@ class Executor {
   template <typename I>
   void _schedule_graph_with_parent(Worker&, I, I, Node*);
 
+  template <typename I>
+  void _set_up_flat_nodes(Worker*, I, Taskflow&, Topology*);
+
+  template <typename I>
+  void _reset_flat_nodes(I, Taskflow&, Topology*, size_t, size_t);
+
+  template <typename I>
+  void _schedule_flat_sources(Worker*, I, Taskflow&, Topology*);
+
   template <typename P, typename F>
   auto _async(P&&, F&&, Topology*, Node*);
 
+  template <typename P, typename F>
+  auto _animate_async(P&&, F&&, Topology*, Node*);
+
   template <typename P, typename F>
   void _silent_async(P&&, F&&, Topology*, Node*);
 
+  template <typename P, typename C>
+  std::shared_ptr<Topology> _make_topology(Taskflow&, P&&, C&&);
+
+  void _run_topology(Taskflow&, const std::shared_ptr<Topology>&);
+
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 
 // Constructor
-inline Executor::Executor(size_t N, std::shared_ptr<WorkerInterface> wix) :
-  _workers  (N),
-  _notifier (N),
-  _buffers  (N),
-  _worker_interface(std::move(wix)) {
+inline Executor::Executor(
+  size_t N, std::shared_ptr<WorkerInterface> wix, std::shared_ptr<SpinPolicy> spin
+) :
+  Executor(N, N, CPUTopology::system(), std::move(wix), std::move(spin)) {
+}
+
+// Constructor
+inline Executor::Executor(
+  size_t N, 
+  const CPUTopology& topology, 
+  std::shared_ptr<WorkerInterface> wix, 
+  std::shared_ptr<SpinPolicy> spin
+) :
+  Executor(N, N, topology, std::move(wix), std::move(spin)) {
+}
+
+// Constructor
+inline Executor::Executor(
+  size_t N, size_t M, std::shared_ptr<WorkerInterface> wix, std::shared_ptr<SpinPolicy> spin
+) :
+  Executor(N, M, CPUTopology::system(), std::move(wix), std::move(spin)) {
+}
+
+// Constructor
+inline Executor::Executor(
+  size_t N, 
+  size_t M, 
+  const CPUTopology& topology, 
+  std::shared_ptr<WorkerInterface> wix,
+  std::shared_ptr<SpinPolicy> spin
+) :
+  Executor({ArenaParams{"default", M}}, N, topology, std::move(wix), std::move(spin)) {
+}
+
+// Constructor
+inline Executor::Executor(
+  const std::vector<ArenaParams>& arenas,
+  std::shared_ptr<WorkerInterface> wix,
+  std::shared_ptr<SpinPolicy> spin
+) :
+  Executor(
+    arenas, _num_arena_workers(arenas), CPUTopology::system(), std::move(wix), std::move(spin)
+  ) {
+}
+
+// Constructor
+inline Executor::Executor(
+  const std::vector<ArenaParams>& arenas,
+  size_t N,
+  const CPUTopology& topology, 
+  std::shared_ptr<WorkerInterface> wix,
+  std::shared_ptr<SpinPolicy> spin
+) :
+  _workers  (_num_arena_workers(arenas)),
+  _buffers  (_arena_sizes(arenas)),
+  _worker_interface(std::move(wix)),
+  _spin_policy(std::move(spin)) {
 
   if(N == 0) {
     TF_THROW("executor must define at least one worker");
   }
 
-  _spawn(N);
+  if(N > _workers.size()) {
+    TF_THROW("initial number of workers (", N, ") exceeds the maximum (", _workers.size(), ")");
+  }
+
+  if(arenas.size() >= NO_ARENA) {
+    TF_THROW("number of arenas (", arenas.size(), ") exceeds the maximum (", NO_ARENA-1, ")");
+  }
+
+  for(const auto& a : arenas) {
+    if(a.num_workers == 0) {
+      TF_THROW("arena '", a.name, "' must define at least one worker");
+    }
+    _arenas.push_back(std::make_unique<Arena>(
+      a, _arenas.empty() ? 0 : _arenas.back()->end
+    ));
+  }
+
+  for(size_t a=0; a<_arenas.size(); ++a) {
+    for(size_t id=_arenas[a]->beg; id<_arenas[a]->end; ++id) {
+      _workers[id]._arena = a;
+      _workers[id]._waiter = _arenas[a]->notifier.waiter(id - _arenas[a]->beg);
+    }
+  }
+
+  _build_victims(topology);
+  _spawn(0, N);
 
   // initialize the default observer if requested
   if(has_env(TF_ENABLE_PROFILER)) {
@@ -1156,8 +2168,12 @@ inline Executor::Executor(size_t N, std::shared_ptr<WorkerInterface> wix) :
 // Destructor
 inline Executor::~Executor() {
 
-  // wait for all topologies to complete
+  // drop the periodic runs, whose timers never run out, and the 
+  // asynchronous tasks of pending timers before waiting for all 
+  // topologies to complete
+  _drain_timers();
   wait_for_all();
+  _shut_down_timers();
 
   // shut down the scheduler
   for(size_t i=0; i<_workers.size(); ++i) {
@@ -1168,44 +2184,159 @@ inline Executor::~Executor() {
   #endif
   }
 
-  _notifier.notify_all();
+  for(auto& a : _arenas) {
+    a->notifier.notify_all();
+  }
 
+  // retired or never spawned workers have no thread to join
   for(auto& w : _workers) {
-    w._thread.join();
+    if(w._thread.joinable()) {
+      w._thread.join();
+    }
   }
 }
 
 // Function: num_workers
 inline size_t Executor::num_workers() const noexcept {
-  return _workers.size();
+  return _num_workers.load(std::memory_order_relaxed);
 }
 
-// Function: num_waiters
-inline size_t Executor::num_waiters() const noexcept {
-#if __cplusplus >= TF_CPP20
-  return _notifier.num_waiters();
-#else
-  // Unfortunately, nonblocking notifier does not have an easy way to return
-  // the number of workers that are not making stealing attempts.
-  return 0;
-#endif
+// Function: max_num_workers
+inline size_t Executor::max_num_workers() const noexcept {
+  return _workers.size();
 }
 
-// Function: num_queues
-inline size_t Executor::num_queues() const noexcept {
-  return _workers.size() + _buffers.size();
+// Function: metrics
+inline ExecutorMetrics Executor::metrics() const {
+  ExecutorMetrics m;
+  m.workers.reserve(_workers.size());
+  for(const auto& w : _workers) {
+    m.workers.push_back(w._metrics.snapshot());
+  }
+  return m;
 }
 
-// Function: num_topologies
-inline size_t Executor::num_topologies() const {
-#if __cplusplus >= TF_CPP20
-  return _num_topologies.load(std::memory_order_relaxed);
-#else
-  return _num_topologies;
-#endif
+// Function: num_arenas
+inline size_t Executor::num_arenas() const noexcept {
+  return _arenas.size();
 }
 
-// Function: num_taskflows
+// Function: arena_id
+inline size_t Executor::arena_id(const std::string& name) const {
+  size_t a = 0;
+  while(a < _arenas.size() && _arenas[a]->name != name) {
+    ++a;
+  }
+  if(a == _arenas.size()) {
+    TF_THROW("executor has no arena named '", name, "'");
+  }
+  return a;
+}
+
+// Function: _num_arena_workers
+inline size_t Executor::_num_arena_workers(const std::vector<ArenaParams>& arenas) {
+  size_t n = 0;
+  for(const auto& a : arenas) {
+    n += a.num_workers;
+  }
+  return n;
+}
+
+// Function: _arena_sizes
+inline std::vector<size_t> Executor::_arena_sizes(const std::vector<ArenaParams>& arenas) {
+  std::vector<size_t> sizes;
+  sizes.reserve(arenas.size());
+  for(const auto& a : arenas) {
+    sizes.push_back(a.num_workers);
+  }
+  return sizes;
+}
+
+// Procedure: affinity_threshold
+inline void Executor::affinity_threshold(std::chrono::nanoseconds threshold) {
+  _affinity_threshold.store(threshold.count(), std::memory_order_relaxed);
+}
+
+// Function: affinity_threshold
+inline std::chrono::nanoseconds Executor::affinity_threshold() const {
+  return std::chrono::nanoseconds(_affinity_threshold.load(std::memory_order_relaxed));
+}
+
+// Procedure: resize
+inline void Executor::resize(size_t N) {
+
+  if(_arenas.size() > 1) {
+    TF_THROW("executor with ", _arenas.size(), " arenas cannot be resized");
+  }
+
+  if(N == 0 || N > _workers.size()) {
+    TF_THROW("number of workers (", N, ") must be in [1, ", _workers.size(), "]");
+  }
+
+  if(auto w = pt::this_worker; w && w->_executor == this) {
+    TF_THROW("resize must not be called by a worker of the executor");
+  }
+
+  std::scoped_lock lock(_workers_mutex);
+
+  auto n = _num_workers.load(std::memory_order_relaxed);
+
+  // grow the pool by spawning workers [n, N)
+  if(N > n) {
+    _spawn(n, N);
+  }
+  // shrink the pool by retiring workers [N, n)
+  else if(N < n) {
+    for(size_t id=N; id<n; ++id) {
+    #if __cplusplus >= TF_CPP20
+      _workers[id]._done.test_and_set(std::memory_order_relaxed);
+    #else
+      _workers[id]._done.store(true, std::memory_order_relaxed);
+    #endif
+    }
+    _arenas[0]->notifier.notify_all();
+    for(size_t id=N; id<n; ++id) {
+      _workers[id]._thread.join();
+    }
+    _num_workers.store(N, std::memory_order_relaxed);
+
+    // tasks left in the mailboxes of the retired workers go to other workers
+    for(size_t id=N; id<n; ++id) {
+      _drain_mailbox(_workers[id]);
+    }
+  }
+}
+
+// Function: num_waiters
+inline size_t Executor::num_waiters() const noexcept {
+#if __cplusplus >= TF_CPP20
+  size_t n = 0;
+  for(const auto& a : _arenas) {
+    n += a->notifier.num_waiters();
+  }
+  return n;
+#else
+  // Unfortunately, nonblocking notifier does not have an easy way to return
+  // the number of workers that are not making stealing attempts.
+  return 0;
+#endif
+}
+
+// Function: num_queues
+inline size_t Executor::num_queues() const noexcept {
+  return _workers.size() + _buffers.size();
+}
+
+// Function: num_topologies
+inline size_t Executor::num_topologies() const {
+#if __cplusplus >= TF_CPP20
+  return _num_topologies.load(std::memory_order_relaxed);
+#else
+  return _num_topologies;
+#endif
+}
+
+// Function: num_taskflows
 inline size_t Executor::num_taskflows() const {
   return _taskflows.size();
 }
@@ -1216,15 +2347,87 @@ inline int Executor::this_worker_id() const {
   return (w && w->_executor == this) ? static_cast<int>(w->_id) : -1;
 }
 
+// Procedure: _build_victims
+// Each worker sorts the queues of its arena into three tiers of increasing 
+// distance: (1) workers sharing its L3 domain and the shared buffers of 
+// the arena, (2) workers on the same NUMA node, and (3) remote workers. 
+// An empty or flat topology yields a single tier, i.e., uniformly random 
+// victim selection. Workers of an arena that steals from other arenas
+// append the queues of those arenas as a last tier.
+inline void Executor::_build_victims(const CPUTopology& topology) {
+  
+  for(size_t id=0; id<_workers.size(); ++id) {
+
+    auto& w = _workers[id];
+    auto& arena = *_arenas[w._arena];
+    
+    w._victims.clear();
+    w._victims.reserve(num_queues());
+
+    for(size_t d=0; d<=2; ++d) {
+      for(size_t vtm=arena.beg; vtm<arena.end; ++vtm) {
+        if(topology.distance(id, vtm) == d) {
+          w._victims.push_back(vtm);
+        }
+      }
+      if(d == 0) {
+        for(auto [b, e] = _buffers.partition(w._arena); b<e; ++b) {
+          w._victims.push_back(_workers.size() + b);
+        }
+      }
+      w._victim_tiers[d] = w._victims.size();
+    }
+
+    if(!arena.steal) {
+      continue;
+    }
+
+    for(size_t a=0; a<_arenas.size(); ++a) {
+      if(a == w._arena) {
+        continue;
+      }
+      for(size_t vtm=_arenas[a]->beg; vtm<_arenas[a]->end; ++vtm) {
+        w._victims.push_back(vtm);
+      }
+      for(auto [b, e] = _buffers.partition(a); b<e; ++b) {
+        w._victims.push_back(_workers.size() + b);
+      }
+    }
+  }
+}
+
+// Function: _select_victim
+// The range of victims widens from the L3-local tier to the NUMA-local tier, 
+// to all queues of the arena, and then to the queues of other arenas
+// as the number of consecutive failed steals grows.
+TF_FORCE_INLINE size_t Executor::_select_victim(Worker& w, size_t num_steals) {
+  size_t n = w._victims.size();
+  if(num_steals < (w._victim_tiers[0] << 1)) {
+    n = w._victim_tiers[0];
+  }
+  else if(num_steals < (w._victim_tiers[1] << 1)) {
+    n = w._victim_tiers[1];
+  }
+  else if(num_steals < (w._victim_tiers[2] << 1)) {
+    n = w._victim_tiers[2];
+  }
+  return w._victims[std::uniform_int_distribution<size_t>(0, n-1)(w._rdgen)];
+}
+
 // Procedure: _spawn
-inline void Executor::_spawn(size_t N) {
+// spawns workers [beg, end), which may have been retired before
+inline void Executor::_spawn(size_t beg, size_t end) {
 
-  for(size_t id=0; id<N; ++id) {
+  for(size_t id=beg; id<end; ++id) {
 
+  #if __cplusplus >= TF_CPP20
+    _workers[id]._done.clear(std::memory_order_relaxed);
+  #else
+    _workers[id]._done.store(false, std::memory_order_relaxed);
+  #endif
     _workers[id]._id = id;
     _workers[id]._vtm = id;
     _workers[id]._executor = this;
-    _workers[id]._waiter = &_notifier._waiters[id];
     _workers[id]._thread = std::thread([&, &w=_workers[id]] () {
 
       pt::this_worker = &w;
@@ -1247,21 +2450,29 @@ inline void Executor::_spawn(size_t N) {
       // are still preparing for entering the scheduling loop
       try {
 
+        w._metrics.start();
+
         // worker loop
         while(1) {
 
           // drain out the local queue
           _exploit_task(w, t);
+          w._metrics.elapse(MetricsCounter::BUSY_TIME);
 
           // steal and wait for tasks
           if(_wait_for_task(w, t) == false) {
             break;
           }
+          w._metrics.elapse(MetricsCounter::IDLE_TIME);
         }
       } 
       catch(...) {
         ptr = std::current_exception();
       }
+
+      // A retiring worker may have consumed a notification meant for a task
+      // it did not steal, so we pass the notification on to another worker.
+      _arenas[w._arena]->notifier.notify_one();
       
       // call the user-specified epilogue function
       if(_worker_interface) {
@@ -1270,15 +2481,15 @@ inline void Executor::_spawn(size_t N) {
 
     });
   } 
+  
+  _num_workers.store(end, std::memory_order_relaxed);
 }
 
 // Function: _corun_until
 template <typename P>
 void Executor::_corun_until(Worker& w, P&& stop_predicate) {
 
-  const size_t MAX_STEALS = ((num_queues() + 1) << 1);
-    
-  std::uniform_int_distribution<size_t> udist(0, num_queues()-1);
+  const size_t MAX_STEALS = ((w._victims.size() + 1) << 1);
   
   exploit:
 
@@ -1287,6 +2498,9 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
     if(auto t = w._wsq.pop(); t) {
       _invoke(w, t);
     }
+    else if(t = _steal_mail(w, w); t) {
+      _invoke(w, t);
+    }
     else {
       size_t num_steals = 0;
       size_t vtm = w._vtm;
@@ -1295,19 +2509,25 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
       
       //auto vtm = udist(w._rdgen);
 
-      t = (vtm < _workers.size()) ? _workers[vtm]._wsq.steal() : 
-                                    _buffers.steal(vtm - _workers.size());
+      t = _steal(w, vtm);
+
+      if(!t && vtm < _workers.size() && vtm != w._id) {
+        t = _steal_mail(w, _workers[vtm]);
+      }
 
       if(t) {
+        w._metrics.add(MetricsCounter::STEALS);
         _invoke(w, t);
         w._vtm = vtm;
         goto exploit;
       }
       else if(!stop_predicate()) {
+        w._metrics.add(MetricsCounter::FAILED_STEALS);
         if(++num_steals > MAX_STEALS) {
+          w._metrics.add(MetricsCounter::YIELDS);
           std::this_thread::yield();
         }
-        vtm = udist(w._rdgen);
+        vtm = _select_victim(w, num_steals);
         goto explore;
       }
       else {
@@ -1317,16 +2537,183 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
   }
 }
 
+// Function: _steal
+TF_FORCE_INLINE Node* Executor::_steal(Worker& w, size_t vtm) {
+
+  // If the worker's victim thread is within the worker pool, steal from the worker's queue.
+  // Otherwise, steal from the buffer, adjusting the victim index based on the worker pool size.
+#ifdef TF_ENABLE_BATCH_STEALING
+  // The thief moves up to half of the victim's tasks into its own queue, 
+  // such that it does not go through the stealing loop again for each of them.
+  // The victims include the thief itself, whose tasks are in its queue already.
+  if(vtm == w._id) {
+    return w._wsq.steal();
+  }
+  return (vtm < _workers.size())
+    ? _workers[vtm]._wsq.steal_batch(w._wsq)
+    : _buffers.steal_batch(vtm - _workers.size(), w._wsq);
+#else
+  (void)w;
+  return (vtm < _workers.size())
+    ? _workers[vtm]._wsq.steal()
+    : _buffers.steal(vtm - _workers.size());
+#endif
+}
+
+// Function: _steady_time_ns
+TF_FORCE_INLINE int64_t Executor::_steady_time_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+// Function: _steal_mail
+// The owner of a mailbox takes its tasks at any time, while other workers 
+// take them only once the oldest one has waited longer than the threshold.
+// Whoever empties the mailbox clears its time stamp and sets it again if 
+// a task has been delivered in the meantime, which either we see here or
+// the delivery sees the cleared time stamp, as both sides fence between 
+// their store and their load.
+TF_FORCE_INLINE Node* Executor::_steal_mail(Worker& w, Worker& owner) {
+
+  auto since = owner._mailbox_since.load(std::memory_order_relaxed);
+
+  if(since == 0) {
+    return nullptr;
+  }
+
+  if(&w != &owner && 
+     _steady_time_ns() - since < _affinity_threshold.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  auto t = owner._mailbox.steal();
+
+  if(owner._mailbox.empty()) {
+    owner._mailbox_since.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(!owner._mailbox.empty()) {
+      int64_t zero = 0;
+      owner._mailbox_since.compare_exchange_strong(zero, _steady_time_ns());
+    }
+  }
+
+  return t;
+}
+
+// Function: _is_mailed
+// A task goes to the mailbox of its preferred worker if the worker is running
+// and belongs to the given arena of the task, since a worker of another arena
+// would run the task outside its arena.
+// This includes the caller itself, since other workers could steal 
+// the task from its queue.
+TF_FORCE_INLINE bool Executor::_is_mailed(unsigned w, size_t a) const {
+  return w < _num_workers.load(std::memory_order_relaxed) && _workers[w]._arena == a;
+}
+
+// Procedure: _deliver
+// A worker does not go to sleep with a non-empty mailbox: either the owner 
+// sees the task before sleeping or we see the owner sleeping, in which case
+// we wake up the owner only; otherwise, we wake up one worker that may steal
+// the task if the owner stays busy. The same argument holds for the owner 
+// being retired, in which case we drain its mailbox ourselves.
+inline void Executor::_deliver(Node* node, unsigned a) {
+
+  auto& owner = _workers[a];
+
+  owner._mailbox.push(node);
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if(owner._mailbox_since.load(std::memory_order_relaxed) == 0) {
+    int64_t zero = 0;
+    owner._mailbox_since.compare_exchange_strong(zero, _steady_time_ns());
+  }
+
+#if __cplusplus >= TF_CPP20
+  if(owner._done.test(std::memory_order_relaxed)) {
+#else
+  if(owner._done.load(std::memory_order_relaxed)) {
+#endif
+    _drain_mailbox(owner);
+  }
+  else if(owner._sleeping.load(std::memory_order_relaxed)) {
+    _arenas[owner._arena]->notifier.notify(owner._waiter);
+  }
+  else {
+    _arenas[owner._arena]->notifier.notify_one();
+  }
+}
+
+// Procedure: _drain_mailbox
+// moves the tasks in the mailbox of a retired worker to the shared buffers
+// of its arena
+inline void Executor::_drain_mailbox(Worker& owner) {
+  size_t n = 0;
+  while(auto t = owner._mailbox.steal()) {
+    _buffers.push(t, t->_priority, owner._arena);
+    ++n;
+  }
+  _notify(owner._arena, n);
+}
+
+// Procedure: _notify
+// announces new tasks to the workers of an arena, where each idle poller 
+// takes one of the tasks and thus saves the notification of a sleeping worker
+inline void Executor::_notify(size_t a, size_t n) {
+  auto& arena = *_arenas[a];
+  if(auto k = arena.num_idle_pollers.load(std::memory_order_relaxed); n > k) {
+    arena.notifier.notify_n(n - k);
+  }
+}
+
+// Procedure: _arm_mailbox
+// A worker going to sleep while the tasks of a mailbox have not waited
+// longer than the threshold arms a timer that wakes up a worker of the arena
+// once they have, since nothing else does if the owner stays busy.
+// Workers arm one timer for each time stamp of a mailbox.
+inline void Executor::_arm_mailbox(Worker& owner, int64_t since) {
+  if(owner._mailbox_alarm.exchange(since, std::memory_order_relaxed) == since) {
+    return;
+  }
+  auto tp = std::chrono::steady_clock::time_point(
+    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::nanoseconds(since + _affinity_threshold.load(std::memory_order_relaxed))
+    )
+  );
+  _insert_timer(_timer_tick(tp), Timer{nullptr, nullptr, &owner});
+}
+
+// Function: _arena_of
+// A node runs in the arena given by its parameters or its taskflow. 
+// A node without a valid arena runs in the given arena, which is the arena
+// of the scheduling worker or the first arena for threads outside.
+TF_FORCE_INLINE size_t Executor::_arena_of(Node* node, size_t a) const {
+  size_t n = node->_arena;
+  if(n == NO_ARENA && node->_topology) {
+    n = node->_topology->_arena;
+  }
+  return n < _arenas.size() ? n : a;
+}
+
 // Function: _explore_task
-inline bool Executor::_explore_task(Worker& w, Node*& t) {
+inline bool Executor::_explore_task(Worker& w, Node*& t, size_t& num_failed_steals) {
 
   //assert(!t);
   
-  const size_t MAX_STEALS = ((num_queues() + 1) << 1);
-  std::uniform_int_distribution<size_t> udist(0, num_queues()-1);
+  const auto [MAX_STEALS, MAX_YIELDS, POLL] = _spin_policy ? 
+    _spin_policy->budget(w, w._victims.size()) : SpinBudget{(w._victims.size() + 1) << 1, 100};
 
   size_t num_steals = 0;
   size_t vtm = w._vtm;
+  bool alive = true;
+
+  // An idle poller keeps looking for tasks until it finds one, 
+  // so schedulers skip notifying a sleeping worker for it (see _notify).
+  auto& num_idle_pollers = _arenas[w._arena]->num_idle_pollers;
+  if(POLL) {
+    num_idle_pollers.fetch_add(1, std::memory_order_relaxed);
+  }
 
   // Make the worker steal immediately from the assigned victim.
   while(true) {
@@ -1334,22 +2721,37 @@ inline bool Executor::_explore_task(Worker& w, Node*& t) {
     // Randomely generate a next victim.
     //vtm = udist(w._rdgen); //w._rdvtm();
 
-    // If the worker's victim thread is within the worker pool, steal from the worker's queue.
-    // Otherwise, steal from the buffer, adjusting the victim index based on the worker pool size.
-    t = (vtm < _workers.size())
-      ? _workers[vtm]._wsq.steal()
-      : _buffers.steal(vtm - _workers.size());
+    // Tasks delivered to this worker take precedence over stealing.
+    if(t = _steal_mail(w, w); t) {
+      break;
+    }
+
+    t = _steal(w, vtm);
+
+    if(!t && vtm < _workers.size() && vtm != w._id) {
+      t = _steal_mail(w, _workers[vtm]);
+    }
 
     if(t) {
+      w._metrics.add(MetricsCounter::STEALS);
       w._vtm = vtm;
       break;
     }
+    
+    w._metrics.add(MetricsCounter::FAILED_STEALS);
+    ++num_failed_steals;
 
     // Increment the steal count, and if it exceeds MAX_STEALS, yield the thread.
-    // If the number of *consecutive* empty steals reaches MAX_STEALS, exit the loop.
-    if (++num_steals > MAX_STEALS) {
+    // If the number of *consecutive* empty steals reaches MAX_STEALS + MAX_YIELDS, exit the loop.
+    // A polling worker instead backs off with up to 64 pause instructions
+    // and keeps the CPU, such that it never goes to sleep.
+    if (++num_steals > MAX_STEALS && POLL) {
+      pause(size_t{1} << std::min(num_steals - MAX_STEALS, size_t{6}));
+    }
+    else if (num_steals > MAX_STEALS) {
+      w._metrics.add(MetricsCounter::YIELDS);
       std::this_thread::yield();
-      if(num_steals > 100 + MAX_STEALS) {
+      if(num_steals > MAX_YIELDS + MAX_STEALS) {
         break;
       }
     }
@@ -1359,12 +2761,18 @@ inline bool Executor::_explore_task(Worker& w, Node*& t) {
   #else
     if(w._done.load(std::memory_order_relaxed)) {
   #endif
-      return false;
+      alive = false;
+      break;
     } 
 
-    vtm = udist(w._rdgen); //w._rdvtm();
+    // Select the next victim, preferring the ones close to this worker.
+    vtm = _select_victim(w, num_steals);
   } 
-  return true;
+
+  if(POLL) {
+    num_idle_pollers.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return alive;
 }
 
 // Procedure: _exploit_task
@@ -1378,62 +2786,110 @@ inline void Executor::_exploit_task(Worker& w, Node*& t) {
 // Function: _wait_for_task
 inline bool Executor::_wait_for_task(Worker& w, Node*& t) {
 
+  // the spin policy, if any, learns from the latency to obtain the next task
+  std::chrono::steady_clock::time_point beg;
+  if(_spin_policy) {
+    beg = std::chrono::steady_clock::now();
+  }
+  size_t num_failed_steals = 0;
+  bool slept = false;
+
   explore_task:
 
-  if(_explore_task(w, t) == false) {
+  w._sleeping.store(false, std::memory_order_relaxed);
+
+  if(_explore_task(w, t, num_failed_steals) == false) {
     return false;
   }
   
   // Go exploit the task if we successfully steal one.
   if(t) {
+    if(_spin_policy) {
+      _spin_policy->on_task(
+        w, 
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - beg), 
+        num_failed_steals, 
+        slept
+      );
+    }
     return true;
   }
 
   // Entering the 2PC guard as all queues should be empty after many stealing attempts.
-  _notifier.prepare_wait(w._waiter);
-  
-  // Condition #1: buffers should be empty
-  for(size_t vtm=0; vtm<_buffers.size(); ++vtm) {
-    if(!_buffers._buckets[vtm].queue.empty()) {
-      _notifier.cancel_wait(w._waiter);
-      w._vtm = vtm + _workers.size();
-      goto explore_task;
-    }
+  // The fence in prepare_wait orders the store to _sleeping before
+  // the check of the mailbox.
+  w._sleeping.store(true, std::memory_order_relaxed);
+
+  auto& notifier = _arenas[w._arena]->notifier;
+  notifier.prepare_wait(w._waiter);
+
+  // Condition #0: mailbox of this worker should be empty
+  if(!w._mailbox.empty()) {
+    notifier.cancel_wait(w._waiter);
+    goto explore_task;
   }
   
-  // Condition #2: worker queues should be empty
-  // Note: We need to use index-based looping to avoid data race with _spawan
-  // which initializes other worker data structure at the same time
-  for(size_t vtm=0; vtm<w._id; ++vtm) {
-    if(!_workers[vtm]._wsq.empty()) {
-      _notifier.cancel_wait(w._waiter);
-      w._vtm = vtm;
-      goto explore_task;
+  // Condition #1: queues this worker steals from should be empty, including
+  // the buffers, the worker queues, and the mailboxes whose tasks have
+  // waited longer than the threshold
+  // Note: The victims are fixed at construction, so the loop does not race 
+  // with _spawn which initializes other worker data structure at the same time.
+  Worker* mail_owner = nullptr;
+  int64_t mail_since = 0;
+
+  for(auto vtm : w._victims) {
+    
+    if(vtm >= _workers.size()) {
+      if(!_buffers._buckets[vtm - _workers.size()].queue.empty()) {
+        notifier.cancel_wait(w._waiter);
+        w._vtm = vtm;
+        goto explore_task;
+      }
+      continue;
     }
-  }
-  
-  // due to the property of the work-stealing queue, we don't need to check
-  // the queue of this worker
-  for(size_t vtm=w._id+1; vtm<_workers.size(); vtm++) {
-    if(!_workers[vtm]._wsq.empty()) {
-      _notifier.cancel_wait(w._waiter);
+
+    // due to the property of the work-stealing queue, we don't need to check
+    // the queue of this worker
+    if(vtm == w._id) {
+      continue;
+    }
+
+    auto since = _workers[vtm]._mailbox_since.load(std::memory_order_relaxed); 
+    
+    if(!_workers[vtm]._wsq.empty() || (since != 0 && 
+       _steady_time_ns() - since >= _affinity_threshold.load(std::memory_order_relaxed))) {
+      notifier.cancel_wait(w._waiter);
       w._vtm = vtm;
       goto explore_task;
     }
+
+    // the mailbox whose tasks pass the threshold first
+    if(since != 0 && (mail_owner == nullptr || since < mail_since)) {
+      mail_owner = &_workers[vtm];
+      mail_since = since;
+    }
   }
   
-  // Condition #3: worker should be alive
+  // Condition #2: worker should be alive
 #if __cplusplus >= TF_CPP20
   if(w._done.test(std::memory_order_relaxed)) {
 #else
   if(w._done.load(std::memory_order_relaxed)) {
 #endif
-    _notifier.cancel_wait(w._waiter);
+    notifier.cancel_wait(w._waiter);
     return false;
   }
+
+  // Condition #3: a worker must wake up once the tasks of a mailbox pass
+  // the threshold, which the notification of the timer does
+  if(mail_owner) {
+    _arm_mailbox(*mail_owner, mail_since);
+  }
   
   // Now I really need to relinquish myself to others.
-  _notifier.commit_wait(w._waiter);
+  w._metrics.add(MetricsCounter::SLEEPS);
+  notifier.commit_wait(w._waiter);
+  slept = true;
   goto explore_task;
 }
 
@@ -1476,24 +2932,54 @@ inline size_t Executor::num_observers() const noexcept {
 // Procedure: _schedule
 inline void Executor::_schedule(Worker& worker, Node* node) {
   
+  // We need to fetch p before the push such that the read 
+  // operation does not race with the node being run and recycled
+  // by another worker right after it becomes visible.
+  auto p = node->_priority;
+
+  // a node without a valid arena runs in the arena of the caller, if any
+  auto a = _arena_of(node, worker._executor == this ? worker._arena : 0);
+
+  if(_is_mailed(node->_affinity, a)) {
+    _deliver(node, node->_affinity);
+    return;
+  }
+  
   // caller is a worker to this pool - starting at v3.5 we do not use
   // any complicated notification mechanism as the experimental result
   // has shown no significant advantage.
   if(worker._executor == this) {
-    worker._wsq.push(node, [&](){ _buffers.push(node); });
-    _notifier.notify_one();
+    
+    // a node of another arena goes through the buffers of that arena
+    if(a != worker._arena) {
+      _buffers.push(node, p, a);
+      _notify(a, 1);
+      return;
+    }
+
+    worker._wsq.level(p).push(node, [&](){ 
+      worker._metrics.add(MetricsCounter::OVERFLOWS);
+      _buffers.push(node, p, worker._arena); 
+    });
+    worker._metrics.add(MetricsCounter::WAKEUPS);
+    _notify(worker._arena, 1);
     return;
   }
   
   // go through the centralized queue
-  _buffers.push(node);
-  _notifier.notify_one();
+  _buffers.push(node, p, a);
+  _notify(a, 1);
 }
 
 // Procedure: _schedule
 inline void Executor::_schedule(Node* node) {
-  _buffers.push(node);
-  _notifier.notify_one();
+  auto a = _arena_of(node, 0);
+  if(_is_mailed(node->_affinity, a)) {
+    _deliver(node, node->_affinity);
+    return;
+  }
+  _buffers.push(node, node->_priority, a);
+  _notify(a, 1);
 }
 
 // Procedure: _schedule
@@ -1506,24 +2992,57 @@ void Executor::_schedule(Worker& worker, I first, I last) {
     return;
   }
   
+  // caller is not a worker of this pool - go through the centralized queue
+  if(worker._executor != this) {
+    _schedule(first, last);
+    return;
+  }
+  
   // NOTE: We cannot use first/last in the for-loop (e.g., for(; first != last; ++first)).
   // This is because when a node v is inserted into the queue, v can run and finish 
   // immediately. If v is the last node in the graph, it will tear down the parent task vector
   // which cause the last ++first to fail. This problem is specific to MSVC which has a stricter
   // iterator implementation in std::vector than GCC/Clang.
-  if(worker._executor == this) {
-    for(size_t i=0; i<num_nodes; i++) {
-      auto node = detail::get_node_ptr(first[i]);
-      worker._wsq.push(node, [&](){ _buffers.push(node); });
-      _notifier.notify_one();
+  // For the same reason, we read the priority of a node only before it is published.
+  //
+  // Each run of nodes with the same priority is published using one bulk push,
+  // and all nodes are announced to idle workers using one notification.
+  // Nodes delivered to mailboxes or to other arenas are published and 
+  // announced individually.
+  detail::NodePtrIterator<I> nodes {first};
+  size_t num_local = 0;
+
+  auto is_local = [&](Node* node) {
+    return _arena_of(node, worker._arena) == worker._arena && 
+           !_is_mailed(node->_affinity, worker._arena);
+  };
+
+  for(size_t i=0; i<num_nodes;) {
+    auto p = nodes[i]->_priority;
+    auto a = _arena_of(nodes[i], worker._arena);
+    if(auto w = nodes[i]->_affinity; _is_mailed(w, a)) {
+      _deliver(nodes[i++], w);
+      continue;
     }
-    return;
-  }
-  
-  for(size_t i=0; i<num_nodes; i++) {
-    _buffers.push(detail::get_node_ptr(first[i]));
+    if(a != worker._arena) {
+      _buffers.push(nodes[i++], p, a);
+      _notify(a, 1);
+      continue;
+    }
+    size_t j = i + 1;
+    while(j < num_nodes && nodes[j]->_priority == p && is_local(nodes[j])) {
+      ++j;
+    }
+    worker._wsq.level(p).bulk_push(nodes + i, j - i, [&](auto rest, size_t n){
+      worker._metrics.add(MetricsCounter::OVERFLOWS, n);
+      _buffers.bulk_push(rest, n, p, worker._arena);
+    });
+    num_local += j - i;
+    i = j;
   }
-  _notifier.notify_n(num_nodes);
+
+  worker._metrics.add(MetricsCounter::WAKEUPS, num_local);
+  _notify(worker._arena, num_local);
 }
 
 // Procedure: _schedule
@@ -1541,10 +3060,27 @@ inline void Executor::_schedule(I first, I last) {
   // immediately. If v is the last node in the graph, it will tear down the parent task vector
   // which cause the last ++first to fail. This problem is specific to MSVC which has a stricter
   // iterator implementation in std::vector than GCC/Clang.
-  for(size_t i=0; i<num_nodes; i++) {
-    _buffers.push(detail::get_node_ptr(first[i]));
+  // Each run of nodes with the same priority and arena is published using
+  // one bulk push and announced to the idle workers of the arena using
+  // one notification.
+  detail::NodePtrIterator<I> nodes {first};
+
+  for(size_t i=0; i<num_nodes;) {
+    auto p = nodes[i]->_priority;
+    auto a = _arena_of(nodes[i], 0);
+    if(auto w = nodes[i]->_affinity; _is_mailed(w, a)) {
+      _deliver(nodes[i++], w);
+      continue;
+    }
+    size_t j = i + 1;
+    while(j < num_nodes && nodes[j]->_priority == p && 
+          _arena_of(nodes[j], 0) == a && !_is_mailed(nodes[j]->_affinity, a)) {
+      ++j;
+    }
+    _buffers.bulk_push(nodes + i, j - i, p, a);
+    _notify(a, j - i);
+    i = j;
   }
-  _notifier.notify_n(num_nodes);
 }
   
 template <typename I>
@@ -1554,11 +3090,26 @@ void Executor::_schedule_graph_with_parent(Worker& worker, I beg, I end, Node* p
   _schedule(worker, beg, send);
 }
 
+// Procedure: _update_cache
+// Here, we want to cache the latest ready node with the highest priority
+// and schedule the others, so the continuation never bypasses a 
+// higher-priority successor.
+// A node preferring another worker or belonging to another arena is never cached.
 TF_FORCE_INLINE void Executor::_update_cache(Worker& worker, Node*& cache, Node* node) {
-  if(cache) {
+  if(_arena_of(node, worker._arena) != worker._arena ||
+     (node->_affinity != worker._id && _is_mailed(node->_affinity, worker._arena))) {
+    _schedule(worker, node);
+  }
+  else if(cache == nullptr) {
+    cache = node;
+  }
+  else if(node->_priority <= cache->_priority) {
     _schedule(worker, cache);
+    cache = node;
+  }
+  else {
+    _schedule(worker, node);
   }
-  cache = node;
 }
   
 // Procedure: _invoke
@@ -1571,6 +3122,8 @@ inline void Executor::_invoke(Worker& worker, Node* node) {
   }
 
   begin_invoke:
+  
+  worker._metrics.add(MetricsCounter::EXECUTED_TASKS);
 
   Node* cache {nullptr};
   
@@ -1665,6 +3218,16 @@ inline void Executor::_invoke(Worker& worker, Node* node) {
     }
     break;
 
+#if __cplusplus >= TF_CPP20
+    // coroutine task
+    case Node::COROUTINE: {
+      if(_invoke_coroutine_task(worker, node, *std::get_if<Node::Coroutine>(&node->_handle))) {
+        return;
+      }
+    }
+    break;
+#endif
+
     // monostate (placeholder)
     default:
     break;
@@ -1929,6 +3492,15 @@ inline bool Executor::_invoke_async_task(Worker& worker, Node* node) {
         return true;
       }
     break;
+
+#if __cplusplus >= TF_CPP20
+    // coroutine
+    case 3:
+      if(_invoke_coroutine_task(worker, node, *std::get_if<3>(&work))) {
+        return true;
+      }
+    break;
+#endif
   }
 
   return false;
@@ -2048,21 +3620,91 @@ tf::Future<void> Executor::run_until(Taskflow& f, P&& p, C&& c) {
   }
 
   // create a topology for this run
-  auto t = std::make_shared<Topology>(f, std::forward<P>(p), std::forward<C>(c));
+  auto t = _make_topology(f, std::forward<P>(p), std::forward<C>(c));
 
   // need to create future before the topology got torn down quickly
-  tf::Future<void> future(t->_promise.get_future(), t);
+  t->_promise.emplace();
+  tf::Future<void> future(t->_promise->get_future(), this, t);
 
-  // modifying topology needs to be protected under the lock
-  {
-    std::lock_guard<std::mutex> lock(f._mutex);
-    f._topologies.push(t);
-    if(f._topologies.size() == 1) {
-      _set_up_topology(pt::this_worker, t.get());
+  _run_topology(f, t);
+
+  return future;
+}
+
+// Function: submit
+inline tf::RunHandle Executor::submit(Taskflow& f) {
+  return submit_n(f, 1);
+}
+
+// Function: submit_n
+inline tf::RunHandle Executor::submit_n(Taskflow& f, size_t repeat) {
+  return submit_until(f, [repeat]() mutable { return repeat-- == 0; });
+}
+
+// Function: submit_until
+template <typename P>
+tf::RunHandle Executor::submit_until(Taskflow& f, P&& p) {
+  return submit_until(f, std::forward<P>(p), nullptr);
+}
+
+// Function: submit_until
+template <typename P, typename C>
+tf::RunHandle Executor::submit_until(Taskflow& f, P&& p, C&& c) {
+
+  _increment_topology();
+
+  // no need to create a topology but returns a completed handle
+  if(f.empty() || p()) {
+    if constexpr (!std::is_same_v<std::decay_t<C>, std::nullptr_t>) {
+      c();
     }
+    _decrement_topology();
+    return tf::RunHandle();
   }
 
-  return future;
+  // create a topology for this run
+  auto t = _make_topology(f, std::forward<P>(p), std::forward<C>(c));
+
+  tf::RunHandle handle(t);
+
+  _run_topology(f, t);
+
+  return handle;
+}
+
+// Function: _make_topology
+template <typename P, typename C>
+std::shared_ptr<Topology> Executor::_make_topology(Taskflow& f, P&& p, C&& c) {
+  auto t = std::allocate_shared<Topology>(
+    TopologyAllocator(), f, std::forward<P>(p), std::forward<C>(c)
+  );
+  t->_arena = f._arena;
+  return t;
+}
+
+// Procedure: _run_topology
+inline void Executor::_run_topology(Taskflow& f, const std::shared_ptr<Topology>& t) {
+
+  // concurrent run on its own array of tasks
+  if(f._concurrent_runs) {
+    try {
+      t->_nodes = f._acquire_run_nodes();
+    }
+    catch(...) {
+      _decrement_topology();
+      throw;
+    }
+    t->_self = t;
+    _set_up_topology(pt::this_worker, t.get());
+    return;
+  }
+
+  // modifying topology needs to be protected under the lock
+  std::lock_guard<std::mutex> lock(f._mutex);
+  f._topologies.push(t);
+  if(f._topologies.size() == 1) {
+    _set_up_topology(pt::this_worker, t.get());
+  }
 }
 
 // Function: run_until
@@ -2080,6 +3722,234 @@ tf::Future<void> Executor::run_until(Taskflow&& f, P&& pred, C&& c) {
   return run_until(*itr, std::forward<P>(pred), std::forward<C>(c));
 }
 
+// ----------------------------------------------------------------------------
+// Timers
+// ----------------------------------------------------------------------------
+
+// Function: run_every
+inline PeriodicRun Executor::run_every(std::chrono::nanoseconds period, Taskflow& f) {
+
+  if(period.count() <= 0) {
+    TF_THROW("period of a periodic run must be positive");
+  }
+
+  auto ticks = (static_cast<uint64_t>(period.count()) + TF_DEFAULT_TIMER_RESOLUTION - 1) /
+               TF_DEFAULT_TIMER_RESOLUTION;
+  auto tick = _timer_tick(_time_after(std::chrono::steady_clock::now(), period));
+
+  auto state = std::make_shared<PeriodicRun::State>(f, ticks, tick);
+  _insert_timer(tick, Timer{nullptr, state});
+  return PeriodicRun(std::move(state));
+}
+
+// Function: _time_after
+// the time point the given duration after the given one, which saturates
+// at the latest time point of the steady clock instead of overflowing and
+// does not go back for a negative duration
+template <typename R, typename T>
+std::chrono::steady_clock::time_point Executor::_time_after(
+  std::chrono::steady_clock::time_point tp, const std::chrono::duration<R, T>& d
+) {
+  if(d <= d.zero()) {
+    return tp;
+  }
+  // floating point cannot overflow, and the margin covers its rounding
+  if(std::chrono::duration<double>(d) >= 
+     std::chrono::duration<double>(std::chrono::steady_clock::time_point::max() - tp) - 
+     std::chrono::seconds(1)) {
+    return std::chrono::steady_clock::time_point::max();
+  }
+  return tp + std::chrono::duration_cast<std::chrono::steady_clock::duration>(d);
+}
+
+// Function: _timer_tick
+// the first tick at or after the given time point
+inline uint64_t Executor::_timer_tick(std::chrono::steady_clock::time_point tp) const {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(tp - _timers.origin).count();
+  return ns <= 0 ? 0 : (static_cast<uint64_t>(ns) + TF_DEFAULT_TIMER_RESOLUTION - 1) / 
+                       TF_DEFAULT_TIMER_RESOLUTION;
+}
+
+// Procedure: _insert_timer
+// The timer thread needs to recompute its deadline only if the new timer
+// expires before the tick it sleeps until.
+// Once the timers drain, both an asynchronous task and a periodic run
+// are dropped. Once the timers shut down, which happens after
+// all topologies have completed, only workers going to sleep arm timers,
+// which are dropped as well.
+inline void Executor::_insert_timer(uint64_t tick, Timer timer) {
+  {
+    std::lock_guard<std::mutex> lock(_timers.mutex);
+    if(!_timers.done && !(_timers.draining && (timer.node || timer.periodic))) {
+      if(!_timers.thread.joinable()) {
+        _timers.thread = std::thread([this](){ _timer_loop(); });
+      }
+      _timers.wheel.insert(tick, std::move(timer));
+      if(tick < _timers.deadline) {
+        _timers.cv.notify_one();
+      }
+      return;
+    }
+  }
+  if(timer.node) {
+    _drop_async_task(timer.node);
+  }
+}
+
+// Function: _expire_periodic
+// Marks the next run of a periodic taskflow as starting unless the previous
+// run is still in flight, and puts the timer back for the start after that.
+// Starts that fell behind the wheel are skipped to keep the phase.
+// The caller holds the mutex of the timers and starts the run after
+// releasing it if this function returns true.
+inline bool Executor::_expire_periodic(Timer& timer) {
+
+  auto& s = *timer.periodic;
+  bool start;
+
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if(s.cancelled || _timers.draining) {
+      return false;
+    }
+    start = !s.running.exchange(true, std::memory_order_acquire);
+    s.starting = start;
+  }
+
+  auto now = _timers.wheel.now();
+  s.tick += s.period;
+  if(s.tick <= now) {
+    s.tick += ((now - s.tick) / s.period + 1) * s.period;
+  }
+  _timers.wheel.insert(s.tick, std::move(timer));
+
+  return start;
+}
+
+// Procedure: _start_periodic
+// starts a run of a periodic taskflow marked as starting, after which
+// a cancellation waiting for the start can return
+inline void Executor::_start_periodic(std::shared_ptr<PeriodicRun::State> p) {
+  auto& s = *p;
+  run(s.taskflow, [p](){ 
+    p->running.store(false, std::memory_order_release); 
+  });
+  {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.starting = false;
+  }
+  s.cv.notify_all();
+}
+
+// Procedure: _timer_loop
+// The timer thread sleeps until the next tick at which the wheel has work
+// to do, and schedules the asynchronous tasks expired at that tick 
+// using one batch. Both the tasks and the periodic runs start outside
+// the mutex of the timers.
+inline void Executor::_timer_loop() {
+
+  std::vector<Timer> expired;
+  std::vector<Node*> nodes;
+  std::vector<std::shared_ptr<PeriodicRun::State>> starts;
+
+  std::unique_lock<std::mutex> lock(_timers.mutex);
+
+  while(!_timers.done) {
+
+    _timers.deadline = _timers.wheel.next_tick();
+
+    if(_timers.deadline == TimerWheel<Timer>::NO_TICK) {
+      _timers.cv.wait(lock);
+      continue;
+    }
+
+    auto tp = _timers.origin + std::chrono::nanoseconds(
+      _timers.deadline * TF_DEFAULT_TIMER_RESOLUTION
+    );
+
+    auto now = std::chrono::steady_clock::now();
+
+    if(now < tp) {
+      _timers.cv.wait_until(lock, tp);
+      continue;
+    }
+
+    // advance the wheel to the last tick that has fully elapsed
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _timers.origin).count();
+
+    _timers.wheel.advance(static_cast<uint64_t>(ns) / TF_DEFAULT_TIMER_RESOLUTION, 
+      [&](Timer&& timer){ expired.push_back(std::move(timer)); }
+    );
+
+    for(auto& timer : expired) {
+      if(timer.node) {
+        nodes.push_back(timer.node);
+      }
+      else if(timer.periodic) {
+        if(auto p = timer.periodic; _expire_periodic(timer)) {
+          starts.push_back(std::move(p));
+        }
+      }
+      else if(timer.mailbox) {
+        _arenas[timer.mailbox->_arena]->notifier.notify_one();
+      }
+    }
+    expired.clear();
+
+    if(!nodes.empty() || !starts.empty()) {
+      lock.unlock();
+      _schedule(nodes.begin(), nodes.end());
+      nodes.clear();
+      for(auto& p : starts) {
+        _start_periodic(std::move(p));
+      }
+      starts.clear();
+      lock.lock();
+    }
+  }
+}
+
+// Procedure: _drain_timers
+// drops the periodic runs and the asynchronous tasks of the pending timers,
+// such that the destruction of the executor does not wait for their time
+inline void Executor::_drain_timers() {
+
+  std::vector<Node*> nodes;
+  {
+    std::lock_guard<std::mutex> lock(_timers.mutex);
+    _timers.draining = true;
+    _timers.wheel.remove_if([&](Timer& timer){
+      if(timer.node) {
+        nodes.push_back(timer.node);
+      }
+      return timer.node || timer.periodic;
+    });
+  }
+  for(auto node : nodes) {
+    _drop_async_task(node);
+  }
+}
+
+// Procedure: _drop_async_task
+// destroys an asynchronous task of a timer that never runs, which breaks
+// the promise of the task
+inline void Executor::_drop_async_task(Node* node) {
+  recycle(node);
+  _decrement_topology();
+}
+
+// Procedure: _shut_down_timers
+inline void Executor::_shut_down_timers() {
+  {
+    std::lock_guard<std::mutex> lock(_timers.mutex);
+    _timers.done = true;
+  }
+  _timers.cv.notify_one();
+  if(_timers.thread.joinable()) {
+    _timers.thread.join();
+  }
+}
+
 // Function: corun
 template <typename T>
 void Executor::corun(T& target) {
@@ -2105,6 +3975,56 @@ void Executor::corun_until(P&& predicate) {
   _corun_until(*pt::this_worker, std::forward<P>(predicate));
 }
 
+// ----------------------------------------------------------------------------
+// Worker-aware Waits
+// ----------------------------------------------------------------------------
+
+// Procedure: wait
+template <typename T>
+void Future<T>::wait() const {
+  // a worker keeps running tasks of its executor until the result is ready,
+  // which only the executor of this future is bound to produce
+  if(auto w = pt::this_worker; w && w->_executor == _executor && this->valid()) {
+    _executor->_corun_until(*w, [this] () -> bool {
+      return this->wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    });
+  }
+  std::future<T>::wait();
+}
+
+// Function: get
+template <typename T>
+decltype(auto) Future<T>::get() {
+  wait();
+  return std::future<T>::get();
+}
+
+// Procedure: wait
+inline void AsyncTask::wait() const {
+
+  if(_node == nullptr) {
+    return;
+  }
+
+  // a worker keeps running tasks of its executor until the task finishes,
+  // which only the executor of the task is bound to do
+  if(auto w = pt::this_worker; w && w->_executor == _executor) {
+    _executor->_corun_until(*w, [this] () -> bool { return is_done(); });
+    return;
+  }
+
+  auto& successors = std::get_if<Node::DependentAsync>(&(_node->_handle))->successors;
+  
+  for(auto s = successors.load(std::memory_order_acquire); s != &Node::DependentAsync::FINISHED;
+           s = successors.load(std::memory_order_acquire)) {
+#if __cplusplus >= TF_CPP20
+    successors.wait(s, std::memory_order_acquire);
+#else
+    std::this_thread::yield();
+#endif
+  }
+}
+
 // Procedure: _corun_graph
 template <typename I>
 void Executor::_corun_graph(Worker& w, Node* p, I first, I last) {
@@ -2128,12 +4048,12 @@ void Executor::_corun_graph(Worker& w, Node* p, I first, I last) {
 }
 
 // Procedure: _increment_topology
-inline void Executor::_increment_topology() {
+inline void Executor::_increment_topology(size_t n) {
 #if __cplusplus >= TF_CPP20
-  _num_topologies.fetch_add(1, std::memory_order_relaxed);
+  _num_topologies.fetch_add(n, std::memory_order_relaxed);
 #else
   std::lock_guard<std::mutex> lock(_topology_mutex);
-  ++_num_topologies;
+  _num_topologies += n;
 #endif
 }
 
@@ -2168,8 +4088,29 @@ inline void Executor::wait_for_all() {
 // Function: _set_up_topology
 inline void Executor::_set_up_topology(Worker* w, Topology* tpg) {
 
+  auto& f = tpg->_taskflow;
+
+  // concurrent run - the tasks of the run have the layout of the compiled graph
+  if(tpg->_nodes) {
+    _set_up_flat_nodes(w, tpg->_nodes.get(), f, tpg);
+    return;
+  }
+
   // ---- under taskflow lock ----
-  auto& g = tpg->_taskflow._graph;
+  auto& g = f._graph;
+
+  // compiled taskflow - sources are known up front
+  if(!f._flat_graph.empty()) {
+    if(_set_up_flat_graph(f, tpg)) {
+      auto first = g.begin();
+      auto last  = first + f._flat_num_sources;
+      tpg->_join_counter.store(f._flat_num_sources, std::memory_order_relaxed);
+      w ? _schedule(*w, first, last) : _schedule(first, last);
+      return;
+    }
+    // the graph has changed since compilation
+    f._clear_flat_graph();
+  }
   
   auto send = _set_up_graph(g.begin(), g.end(), tpg, nullptr);
   tpg->_join_counter.store(send - g.begin(), std::memory_order_relaxed);
@@ -2177,6 +4118,176 @@ inline void Executor::_set_up_topology(Worker* w, Topology* tpg) {
   w ? _schedule(*w, g.begin(), send) : _schedule(g.begin(), send);
 }
 
+// Function: _set_up_flat_graph
+inline bool Executor::_set_up_flat_graph(Taskflow& f, Topology* tpg) {
+
+  auto& g = f._graph;
+
+  if(f._flat_graph.size() != g.size()) {
+    return false;
+  }
+
+  auto nodes = g.data();
+  auto flat = f._flat_graph.data();
+
+  for(size_t i=0, n=g.size(); i<n; i++) {
+
+    auto node = nodes[i].get();
+
+    // a partially set-up graph is fine as _set_up_graph resets every node
+    if(flat[i].node != node || (node->_nstate & NSTATE::DIRTY)) {
+      return false;
+    }
+
+    node->_topology = tpg;
+    node->_parent = nullptr;
+    node->_nstate = flat[i].nstate;
+    node->_estate.store(ESTATE::NONE, std::memory_order_relaxed);
+    node->_join_counter.store(flat[i].join_counter, std::memory_order_relaxed);
+    // resetting an exception pointer is not free, so skip the common case
+    if(node->_exception_ptr) {
+      node->_exception_ptr = nullptr;
+    }
+  }
+
+  return true;
+}
+
+// Procedure: _set_up_flat_nodes
+// sets up the nodes in the layout of the compiled graph and
+// schedules the sources, where large graphs are reset by multiple workers
+template <typename I>
+void Executor::_set_up_flat_nodes(
+  Worker* w, I g, Taskflow& f, Topology* tpg
+) {
+
+  const size_t n = f._flat_graph.size();
+  const size_t num_chunks = (std::min)(
+    num_workers(), n / TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE
+  );
+
+  if(num_chunks <= 1) {
+    _reset_flat_nodes(g, f, tpg, 0, n);
+    _schedule_flat_sources(w, g, f, tpg);
+    return;
+  }
+
+  // the worker that resets the last chunk schedules the sources
+  const size_t chunk_size = (n + num_chunks - 1) / num_chunks;
+  tpg->_num_set_up_chunks.store(num_chunks, std::memory_order_relaxed);
+
+  for(size_t c=1; c<num_chunks; c++) {
+    _increment_topology();
+    _silent_async(
+      DefaultTaskParams{},
+      [this, g, &f, tpg, beg=c*chunk_size, end=(std::min)(n, (c+1)*chunk_size)](){
+        _reset_flat_nodes(g, f, tpg, beg, end);
+        if(tpg->_num_set_up_chunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          _schedule_flat_sources(pt::this_worker, g, f, tpg);
+        }
+      },
+      nullptr, nullptr
+    );
+  }
+
+  _reset_flat_nodes(g, f, tpg, 0, chunk_size);
+  if(tpg->_num_set_up_chunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    _schedule_flat_sources(w, g, f, tpg);
+  }
+}
+
+// Procedure: _reset_flat_nodes
+template <typename I>
+void Executor::_reset_flat_nodes(
+  I g, Taskflow& f, Topology* tpg, size_t beg, size_t end
+) {
+
+  detail::NodePtrIterator<I> nodes {g};
+  auto flat = f._flat_graph.data();
+
+  for(size_t i=beg; i<end; i++) {
+    auto node = nodes[i];
+    // the tasks of a concurrent run follow the attributes of their
+    // original tasks, which can change without invalidating the graph
+    if(auto origin = flat[i].node; origin != node) {
+      node->_data = origin->_data;
+      node->_priority = origin->_priority;
+      node->_affinity = origin->_affinity;
+      node->_arena = origin->_arena;
+    }
+    node->_topology = tpg;
+    node->_parent = nullptr;
+    node->_nstate = flat[i].nstate;
+    node->_estate.store(ESTATE::NONE, std::memory_order_relaxed);
+    node->_join_counter.store(flat[i].join_counter, std::memory_order_relaxed);
+    if(node->_exception_ptr) {
+      node->_exception_ptr = nullptr;
+    }
+  }
+}
+
+// Procedure: _schedule_flat_sources
+template <typename I>
+void Executor::_schedule_flat_sources(
+  Worker* w, I first, Taskflow& f, Topology* tpg
+) {
+  auto last  = first + f._flat_num_sources;
+  tpg->_join_counter.store(f._flat_num_sources, std::memory_order_relaxed);
+  w ? _schedule(*w, first, last) : _schedule(first, last);
+}
+
+// Procedure: _record_flat_graph
+// sets up the graph like _set_up_graph and records the states of the nodes
+// as a compiled graph for the subsequent runs of the same topology
+inline void Executor::_record_flat_graph(Taskflow& f, Topology* tpg) {
+
+  // ---- under taskflow lock ----
+
+  // the previous set-up has moved the sources to the front
+  size_t num_sources = 0;
+
+  f._flat_graph.reserve(f._graph.size());
+
+  for(auto& ptr : f._graph) {
+    auto node = ptr.get();
+    node->_topology = tpg;
+    node->_parent = nullptr;
+    node->_nstate &= NSTATE::DIRTY;
+    node->_estate.store(ESTATE::NONE, std::memory_order_relaxed);
+    node->_set_up_join_counter();
+    node->_exception_ptr = nullptr;
+    num_sources += (node->num_predecessors() == 0);
+    f._flat_graph.push_back({
+      node,
+      node->_join_counter.load(std::memory_order_relaxed),
+      0,
+      node->_nstate
+    });
+  }
+
+  f._flat_num_sources = num_sources;
+  f._flat_transient = true;
+}
+
+// Procedure: _rerun_topology
+inline void Executor::_rerun_topology(Worker& w, Topology* tpg) {
+
+  // ---- under taskflow lock ----
+  auto& f = tpg->_taskflow;
+  
+  // The graph cannot change between the runs of a topology, so the first
+  // rerun records the states of the tasks and the subsequent runs copy them
+  // instead of visiting the predecessors of every task.
+  // A compiled graph has been validated by the first run of the topology.
+  if(f._flat_graph.empty()) {
+    _record_flat_graph(f, tpg);
+    _schedule_flat_sources(&w, f._graph.begin(), f, tpg);
+  }
+  else {
+    _set_up_flat_nodes(&w, f._graph.begin(), f, tpg);
+  }
+}
+
 // Function: _set_up_graph
 template <typename I>
 I Executor::_set_up_graph(I first, I last, Topology* tpg, Node* parent) {
@@ -2187,7 +4298,8 @@ I Executor::_set_up_graph(I first, I last, Topology* tpg, Node* parent) {
     auto node = first->get();
     node->_topology = tpg;
     node->_parent = parent;
-    node->_nstate = NSTATE::NONE;
+    // keep the flag of modifications until the next compilation
+    node->_nstate &= NSTATE::DIRTY;
     node->_estate.store(ESTATE::NONE, std::memory_order_relaxed);
     node->_set_up_join_counter();
     node->_exception_ptr = nullptr;
@@ -2211,23 +4323,65 @@ inline void Executor::_tear_down_topology(Worker& worker, Topology* tpg) {
   // case 1: we still need to run the topology again
   if(!tpg->_exception_ptr && !tpg->cancelled() && !tpg->_pred()) {
     //assert(tpg->_join_counter == 0);
-    std::lock_guard<std::mutex> lock(f._mutex);
-    _set_up_topology(&worker, tpg);
+    if(tpg->_nodes) {
+      _set_up_topology(&worker, tpg);
+    }
+    else {
+      std::lock_guard<std::mutex> lock(f._mutex);
+      _rerun_topology(worker, tpg);
+    }
   }
   // case 2: the final run of this topology
   else {
 
     // invoke the callback after each run
-    if(tpg->_call != nullptr) {
+    if(tpg->_call) {
       tpg->_call();
     }
 
+    // concurrent run - other runs are independent of this one
+    if(tpg->_nodes) {
+
+      auto fetched_tpg {std::move(tpg->_self)};
+      std::optional<std::list<Taskflow>::iterator> satellite;
+      {
+        // the tasks of this run, which include the current task, go back
+        // to the taskflow for reuse before the taskflow may be destroyed;
+        // nothing touches them after this point
+        std::lock_guard<std::mutex> lock(f._mutex);
+        f._run_nodes.push_back(std::move(tpg->_nodes));
+        if(--f._num_concurrent_runs == 0 && f._topologies.empty()) {
+          satellite = f._satellite;
+        }
+      }
+
+      fetched_tpg->_carry_out_promise();
+#if __cplusplus >= TF_CPP20
+      _resume_awaiters(fetched_tpg->_awaiters);
+#endif
+      _decrement_topology();
+
+      if(satellite) {
+        std::scoped_lock<std::mutex> satellite_lock(_taskflows_mutex);
+        _taskflows.erase(*satellite);
+      }
+      return;
+    }
+
     // If there is another run (interleave between lock)
     if(std::unique_lock<std::mutex> lock(f._mutex); f._topologies.size()>1) {
       //assert(tpg->_join_counter == 0);
 
+      // the recorded graph is only valid for the runs of this topology
+      if(f._flat_transient) {
+        f._clear_flat_graph();
+      }
+
       // Set the promise
-      tpg->_promise.set_value();
+      tpg->_carry_out_promise();
+#if __cplusplus >= TF_CPP20
+      _resume_awaiters(tpg->_awaiters);
+#endif
       f._topologies.pop();
       tpg = f._topologies.front().get();
 
@@ -2241,6 +4395,10 @@ inline void Executor::_tear_down_topology(Worker& worker, Topology* tpg) {
     else {
       //assert(f._topologies.size() == 1);
 
+      if(f._flat_transient) {
+        f._clear_flat_graph();
+      }
+
       auto fetched_tpg {std::move(f._topologies.front())};
       f._topologies.pop();
       auto satellite {f._satellite};
@@ -2250,6 +4408,9 @@ inline void Executor::_tear_down_topology(Worker& worker, Topology* tpg) {
       // Soon after we carry out the promise, there is no longer any guarantee
       // for the lifetime of the associated taskflow.
       fetched_tpg->_carry_out_promise();
+#if __cplusplus >= TF_CPP20
+      _resume_awaiters(fetched_tpg->_awaiters);
+#endif
 
       _decrement_topology();
 
@@ -170,6 +170,45 @@ class FlowBuilder {
   >
   Task emplace(C&& callable);
 
+#if __cplusplus >= TF_CPP20
+  /**
+  @brief creates a coroutine task from a given callable object
+
+  @tparam C callable type that takes no arguments and returns a tf::Coro
+
+  @param callable callable to construct a coroutine task
+
+  @return a tf::Task handle
+
+  A coroutine task can suspend at a @c co_await on a tf::AsyncTask,
+  a tf::Future, or a tf::corun target without blocking the worker that
+  runs it. The executor resumes the coroutine on a worker once
+  the awaited operation completes, and the task completes, and its
+  successors are scheduled, when the coroutine returns.
+
+  @code{.cpp}
+  tf::Executor executor;
+  tf::Taskflow taskflow;
+
+  auto A = taskflow.emplace([&]() -> tf::Coro<void> {
+    auto task = executor.silent_dependent_async([](){ std::cout << "child\n"; });
+    co_await task;   // the worker runs other tasks in the meantime
+    std::cout << "A\n";
+  });
+  auto B = taskflow.emplace([](){ std::cout << "B\n"; });
+  A.precede(B);
+
+  executor.run(taskflow).wait();
+  @endcode
+
+  Please refer to @ref CoroutineTasking for details.
+  */
+  template <typename C,
+    std::enable_if_t<is_coroutine_task_v<C>, void>* = nullptr
+  >
+  Task emplace(C&& callable);
+#endif
+
   /**
   @brief creates multiple tasks from a list of callable objects
 
@@ -1296,6 +1335,16 @@ Task FlowBuilder::emplace(C&& c) {
   ));
 }
 
+#if __cplusplus >= TF_CPP20
+// Function: emplace
+template <typename C, std::enable_if_t<is_coroutine_task_v<C>, void>*>
+Task FlowBuilder::emplace(C&& c) {
+  return Task(_graph._emplace_back(NSTATE::NONE, ESTATE::NONE, DefaultTaskParams{}, nullptr, nullptr, 0,
+    std::in_place_type_t<Node::Coroutine>{}, std::forward<C>(c)
+  ));
+}
+#endif
+
 // Function: composed_of
 template <typename T>
 Task FlowBuilder::composed_of(T& object) {
@@ -14,28 +14,48 @@ class Freelist {
 
   public:
   struct Bucket {
-    std::mutex mutex;
-    UnboundedTaskQueue<T> queue;
+    MultiLevelTaskQueue<InjectionQueue<T>> queue;
   };  
   
   // Here, we don't create just N task queues in the freelist as it will cause
   // the work-stealing loop to spand a lot of time on stealing tasks.
   // Experimentally speaking, we found floor_log2(N) is the best.
-  TF_FORCE_INLINE Freelist(size_t N) : _buckets(N < 4 ? 1 : floor_log2(N)) {}
+  // We create a partition of buckets for each group of N[a] workers, 
+  // such that the executor decides which workers steal the items of a group.
+  Freelist(const std::vector<size_t>& N) : _offsets(N.size() + 1, 0) {
+    for(size_t a=0; a<N.size(); a++) {
+      _offsets[a+1] = _offsets[a] + (N[a] < 4 ? 1 : floor_log2(N[a]));
+    }
+    _buckets = std::vector<Bucket>(_offsets.back());
+  }
 
   // Pointers are aligned to 8 bytes. We perform a simple hash to avoid contention caused
   // by hashing to the same slot.
-  TF_FORCE_INLINE void push(T item) {
+  // The item is inserted into the level of the given priority without locking,
+  // such that many external threads can submit tasks at the same time.
+  TF_FORCE_INLINE void push(T item, unsigned p, size_t a) {
     //auto b = reinterpret_cast<uintptr_t>(item) % _buckets.size();
-    auto b = (reinterpret_cast<uintptr_t>(item) >> 16) % _buckets.size();
-    std::scoped_lock lock(_buckets[b].mutex);
-    _buckets[b].queue.push(item);
+    auto b = _bucket(reinterpret_cast<uintptr_t>(item), a);
+    _buckets[b].queue.level(p).push(item);
+  }
+
+  // Inserts N items into the level of the given priority of a single bucket.
+  template <typename I>
+  TF_FORCE_INLINE void bulk_push(I first, size_t N, unsigned p, size_t a) {
+    auto b = _bucket(reinterpret_cast<uintptr_t>(first[0]), a);
+    _buckets[b].queue.level(p).bulk_push(first, N);
   }
 
   TF_FORCE_INLINE T steal(size_t w) {
     return _buckets[w].queue.steal();
   }
   
+  // Steals up to half of the items of bucket w into the queue dst.
+  template <typename Q>
+  TF_FORCE_INLINE T steal_batch(size_t w, Q& dst) {
+    return _buckets[w].queue.steal_batch(dst);
+  }
+  
   TF_FORCE_INLINE T steal_with_hint(size_t w, size_t& num_empty_steals) {
     return _buckets[w].queue.steal_with_hint(num_empty_steals);
   }
@@ -44,9 +64,19 @@ class Freelist {
     return _buckets.size();
   }
 
+  // range of the buckets in partition a
+  std::pair<size_t, size_t> partition(size_t a) const {
+    return {_offsets[a], _offsets[a+1]};
+  }
+
   private:
   
+  std::vector<size_t> _offsets;
   std::vector<Bucket> _buckets;
+
+  TF_FORCE_INLINE size_t _bucket(uintptr_t key, size_t a) const {
+    return _offsets[a] + (key >> 16) % (_offsets[a+1] - _offsets[a]);
+  }
 };
 
 
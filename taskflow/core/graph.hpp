@@ -9,8 +9,11 @@
 #endif
 
 #include "../utility/os.hpp"
+#include "../utility/cpu_topology.hpp"
 #include "../utility/math.hpp"
 #include "../utility/small_vector.hpp"
+#include "../utility/small_function.hpp"
+#include "../utility/slab_allocator.hpp"
 #include "../utility/serializer.hpp"
 #include "../utility/lazy_string.hpp"
 #include "error.hpp"
@@ -20,6 +23,10 @@
 #include "topology.hpp"
 #include "tsq.hpp"
 
+#if __cplusplus >= TF_CPP20
+#include <coroutine>
+#endif
+
 
 /**
 @file graph.hpp
@@ -99,6 +106,20 @@ class Graph : public std::vector<std::unique_ptr<Node>> {
 // TaskParams
 // ----------------------------------------------------------------------------
 
+/**
+@brief affinity value of a task that any worker can run
+
+@see tf::Task::affinity
+*/
+inline constexpr size_t NO_AFFINITY = std::numeric_limits<unsigned>::max();
+
+/**
+@brief arena value of a task that runs in the arena of the scheduling thread
+
+@see tf::ArenaParams
+*/
+inline constexpr size_t NO_ARENA = std::numeric_limits<uint16_t>::max();
+
 /**
 @struct TaskParams
 
@@ -114,6 +135,16 @@ struct TaskParams {
   @brief C-styled pointer to user data
   */
   void* data {nullptr};
+
+  /**
+  @brief id of the worker preferred to run the task (see tf::Task::affinity)
+  */
+  size_t affinity {NO_AFFINITY};
+
+  /**
+  @brief id of the executor arena to run the task (see tf::ArenaParams)
+  */
+  size_t arena {NO_ARENA};
 };
 
 /**
@@ -158,6 +189,7 @@ class Node {
   friend class Runtime;
   friend class AnchorGuard;
   friend class PreemptionGuard;
+  friend class CoroPromiseBase;
 
   //template <typename T>
   //friend class Freelist;
@@ -174,7 +206,7 @@ class Node {
     template <typename C>
     Static(C&&);
 
-    std::function<void()> work;
+    SmallFunction<void()> work;
   };
   
   // runtime work handle
@@ -183,7 +215,7 @@ class Node {
     template <typename C>
     Runtime(C&&);
 
-    std::function<void(tf::Runtime&)> work;
+    SmallFunction<void(tf::Runtime&)> work;
   };
 
   // subflow work handle
@@ -192,7 +224,7 @@ class Node {
     template <typename C>
     Subflow(C&&);
 
-    std::function<void(tf::Subflow&)> work;
+    SmallFunction<void(tf::Subflow&)> work;
     Graph subgraph;
   };
 
@@ -202,7 +234,7 @@ class Node {
     template <typename C>
     Condition(C&&);
     
-    std::function<int()> work;
+    SmallFunction<int()> work;
   };
 
   // multi-condition work handle
@@ -211,7 +243,7 @@ class Node {
     template <typename C>
     MultiCondition(C&&);
 
-    std::function<SmallVector<int>()> work;
+    SmallFunction<SmallVector<int>()> work;
   };
 
   // module work handle
@@ -223,6 +255,26 @@ class Node {
     Graph& graph;
   };
 
+#if __cplusplus >= TF_CPP20
+  // coroutine work handle
+  struct Coroutine {
+
+    template <typename C>
+    explicit Coroutine(C&&);
+
+    Coroutine(Coroutine&&) noexcept;
+
+    ~Coroutine();
+
+    // creates the frame of a new coroutine and returns its promise
+    SmallFunction<CoroPromiseBase*()> work;
+
+    // frame of the running coroutine and its promise
+    std::coroutine_handle<> frame;
+    CoroPromiseBase* promise {nullptr};
+  };
+#endif
+
   // Async work
   struct Async {
 
@@ -230,12 +282,22 @@ class Node {
     Async(T&&);
 
     std::variant<
-      std::function<void()>, 
-      std::function<void(tf::Runtime&)>,       // silent async
-      std::function<void(tf::Runtime&, bool)>  // async
+      SmallFunction<void()>, 
+      SmallFunction<void(tf::Runtime&)>,       // silent async
+      SmallFunction<void(tf::Runtime&, bool)>  // async
+#if __cplusplus >= TF_CPP20
+      , Coroutine                              // coroutine async
+#endif
     > work;
   };
   
+  // entry of a successor in the successor list of a dependent async task
+  struct AsyncLink {
+    Node* node {nullptr};
+    AsyncLink* next {nullptr};
+    bool any {false};  // the successor runs after any, not all, of its tasks
+  };
+  
   // silent dependent async
   struct DependentAsync {
     
@@ -243,13 +305,22 @@ class Node {
     DependentAsync(C&&);
     
     std::variant<
-      std::function<void()>, 
-      std::function<void(tf::Runtime&)>,       // silent async
-      std::function<void(tf::Runtime&, bool)>  // async
+      SmallFunction<void()>, 
+      SmallFunction<void(tf::Runtime&)>,       // silent async
+      SmallFunction<void(tf::Runtime&, bool)>  // async
     > work;
    
     std::atomic<size_t> use_count {1};
-    std::atomic<ASTATE::underlying_type> state {ASTATE::UNFINISHED};
+
+    // lock-free (Treiber) stack of successors, which becomes FINISHED
+    // once the task finishes and accepts no more successors
+    std::atomic<AsyncLink*> successors {nullptr};
+
+    // entries of this task in the successor lists of the tasks it depends on
+    SmallVector<AsyncLink, 2> links;
+
+    // sentinel of the successor list of a finished task
+    static AsyncLink FINISHED;
   };
 
   using handle_t = std::variant<
@@ -262,6 +333,9 @@ class Node {
     Module,           // composable tasking
     Async,            // async tasking
     DependentAsync    // dependent async tasking
+#if __cplusplus >= TF_CPP20
+    , Coroutine       // coroutine tasking
+#endif
   >;
 
   struct Semaphores {
@@ -281,6 +355,9 @@ class Node {
   constexpr static auto MODULE          = get_index_v<Module, handle_t>;
   constexpr static auto ASYNC           = get_index_v<Async, handle_t>;
   constexpr static auto DEPENDENT_ASYNC = get_index_v<DependentAsync, handle_t>;
+#if __cplusplus >= TF_CPP20
+  constexpr static auto COROUTINE       = get_index_v<Coroutine, handle_t>;
+#endif
 
   Node() = default;
   
@@ -302,6 +379,10 @@ class Node {
   nstate_t _nstate              {NSTATE::NONE};
   std::atomic<estate_t> _estate {ESTATE::NONE};
 
+  uint16_t _priority {0};
+  uint16_t _arena {static_cast<uint16_t>(NO_ARENA)};
+  unsigned _affinity {static_cast<unsigned>(NO_AFFINITY)};
+
   std::string _name;
   
   void* _data {nullptr};
@@ -341,6 +422,8 @@ class Node {
 */
 #ifdef TF_ENABLE_TASK_POOL
 inline ObjectPool<Node> _task_pool;
+#elif defined(TF_ENABLE_TASK_SLAB)
+inline SlabAllocator<Node> _task_slab;
 #endif
 
 /**
@@ -350,6 +433,8 @@ template <typename... ArgsT>
 TF_FORCE_INLINE Node* animate(ArgsT&&... args) {
 #ifdef TF_ENABLE_TASK_POOL
   return _task_pool.animate(std::forward<ArgsT>(args)...);
+#elif defined(TF_ENABLE_TASK_SLAB)
+  return _task_slab.animate(std::forward<ArgsT>(args)...);
 #else
   return new Node(std::forward<ArgsT>(args)...);
 #endif
@@ -361,6 +446,8 @@ TF_FORCE_INLINE Node* animate(ArgsT&&... args) {
 TF_FORCE_INLINE void recycle(Node* ptr) {
 #ifdef TF_ENABLE_TASK_POOL
   _task_pool.recycle(ptr);
+#elif defined(TF_ENABLE_TASK_SLAB)
+  _task_slab.recycle(ptr);
 #else
   delete ptr;
 #endif
@@ -429,6 +516,42 @@ template <typename C>
 Node::Async::Async(C&& c) : work {std::forward<C>(c)} {
 }
 
+#if __cplusplus >= TF_CPP20
+
+// ----------------------------------------------------------------------------
+// Definition for Node::Coroutine
+// ----------------------------------------------------------------------------
+
+// Constructor
+// the callable either returns a tf::Coro or, for a task of a concurrent run,
+// the promise created by the work of that node
+template <typename C>
+Node::Coroutine::Coroutine(C&& c) {
+  if constexpr (std::is_same_v<std::invoke_result_t<std::decay_t<C>&>, CoroPromiseBase*>) {
+    work = std::forward<C>(c);
+  }
+  else {
+    work = [c=std::forward<C>(c)]() mutable { return c()._release(); };
+  }
+}
+
+// Move constructor
+inline Node::Coroutine::Coroutine(Coroutine&& rhs) noexcept :
+  work    {std::move(rhs.work)},
+  frame   {std::exchange(rhs.frame, nullptr)},
+  promise {std::exchange(rhs.promise, nullptr)} {
+}
+
+// Destructor
+// destroys the frame of a coroutine that never ran to completion
+inline Node::Coroutine::~Coroutine() {
+  if(frame) {
+    frame.destroy();
+  }
+}
+
+#endif
+
 // ----------------------------------------------------------------------------
 // Definition for Node::DependentAsync
 // ----------------------------------------------------------------------------
@@ -438,6 +561,9 @@ template <typename C>
 Node::DependentAsync::DependentAsync(C&& c) : work {std::forward<C>(c)} {
 }
 
+// Sentinel: FINISHED
+inline Node::AsyncLink Node::DependentAsync::FINISHED {};
+
 // ----------------------------------------------------------------------------
 // Definition for Node
 // ----------------------------------------------------------------------------
@@ -455,6 +581,8 @@ Node::Node(
 ) :
   _nstate       {nstate},
   _estate       {estate},
+  _arena        {static_cast<uint16_t>(std::min(params.arena, NO_ARENA))},
+  _affinity     {static_cast<unsigned>(std::min(params.affinity, NO_AFFINITY))},
   _name         {params.name},
   _data         {params.data},
   _topology     {topology},
@@ -498,6 +626,8 @@ inline void Node::_precede(Node* v) {
   _edges.push_back(v);
   std::swap(_edges[_num_successors++], _edges[_edges.size() - 1]);
   v->_edges.push_back(this);
+  _nstate |= NSTATE::DIRTY;
+  v->_nstate |= NSTATE::DIRTY;
 }
 
 // Function: _remove_successors
@@ -507,6 +637,7 @@ inline void Node::_remove_successors(Node* node) {
   std::move(_edges.begin() + _num_successors, _edges.end(), sit);
   _edges.resize(_edges.size() - (_num_successors - new_num_successors));
   _num_successors = new_num_successors;
+  _nstate |= NSTATE::DIRTY;
 }
 
 // Function: _remove_predecessors
@@ -514,6 +645,7 @@ inline void Node::_remove_predecessors(Node* node) {
   _edges.erase( 
     std::remove(_edges.begin() + _num_successors, _edges.end(), node), _edges.end()
   );
+  _nstate |= NSTATE::DIRTY;
 }
 
 // Function: num_successors
@@ -660,6 +792,7 @@ inline void Graph::_erase(Node* node) {
 template <typename ...ArgsT>
 Node* Graph::_emplace_back(ArgsT&&... args) {
   push_back(std::make_unique<Node>(std::forward<ArgsT>(args)...));
+  back()->_nstate |= NSTATE::DIRTY;
   return back().get();
 }
 
@@ -728,11 +861,34 @@ TF_FORCE_INLINE Node* get_node_ptr(T& node) {
   else if constexpr (std::is_same_v<U, std::unique_ptr<Node>>) {
     return node.get();
   } 
+  else if constexpr (std::is_same_v<U, Node>) {
+    return &node;
+  } 
   else {
     static_assert(dependent_false_v<T>, "Unsupported type for get_node_ptr");
   }
 } 
 
+/**
+@private
+
+@brief adaptor to access a random-access range of Node, Node* or 
+       std::unique_ptr<Node> as a range of Node*
+*/
+template <typename I>
+struct NodePtrIterator {
+
+  I it;
+
+  TF_FORCE_INLINE Node* operator [] (size_t i) const {
+    return get_node_ptr(it[i]);
+  }
+
+  TF_FORCE_INLINE NodePtrIterator operator + (size_t n) const {
+    return NodePtrIterator{it + n};
+  }
+};
+
 }  // end of namespace tf::detail ---------------------------------------------
 
 
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include "../utility/macros.hpp"
+
+/**
+@file metrics.hpp
+@brief metrics include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: WorkerMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct WorkerMetrics
+
+@brief struct to store a snapshot of the scheduling counters of a worker
+
+The counters are collected only if the macro @c TF_ENABLE_SCHEDULER_METRICS
+is defined before including Taskflow. Otherwise, the counters cost nothing
+and all values remain zero.
+
+@code{.cpp}
+#define TF_ENABLE_SCHEDULER_METRICS
+#include <taskflow/taskflow.hpp>
+
+tf::Executor executor;
+executor.run(taskflow).wait();
+
+auto total = executor.metrics().total();
+std::cout << total.num_steals << " successful steals out of "
+          << total.num_steals + total.num_failed_steals << " attempts\n";
+@endcode
+*/
+struct WorkerMetrics {
+
+  /**
+  @brief number of tasks executed by the worker
+  */
+  size_t num_executed_tasks {0};
+
+  /**
+  @brief number of tasks the worker successfully stole from other queues
+  */
+  size_t num_steals {0};
+
+  /**
+  @brief number of steal attempts that found the victim queue empty
+  */
+  size_t num_failed_steals {0};
+
+  /**
+  @brief number of times the worker yielded its thread after too many failed steals
+  */
+  size_t num_yields {0};
+
+  /**
+  @brief number of times the worker committed to sleep on the notifier
+  */
+  size_t num_sleeps {0};
+
+  /**
+  @brief number of wake-up notifications the worker issued to other workers
+         when scheduling tasks
+  */
+  size_t num_wakeups {0};
+
+  /**
+  @brief number of tasks spilled to the shared buffers because the
+         worker's queue was full
+  */
+  size_t num_overflows {0};
+
+  /**
+  @brief time the worker spent running tasks
+  */
+  std::chrono::nanoseconds busy_time {0};
+
+  /**
+  @brief time the worker spent stealing or sleeping
+  */
+  std::chrono::nanoseconds idle_time {0};
+
+  /**
+  @brief accumulates the counters of another snapshot
+  */
+  WorkerMetrics& operator += (const WorkerMetrics& rhs) {
+    num_executed_tasks += rhs.num_executed_tasks;
+    num_steals += rhs.num_steals;
+    num_failed_steals += rhs.num_failed_steals;
+    num_yields += rhs.num_yields;
+    num_sleeps += rhs.num_sleeps;
+    num_wakeups += rhs.num_wakeups;
+    num_overflows += rhs.num_overflows;
+    busy_time += rhs.busy_time;
+    idle_time += rhs.idle_time;
+    return *this;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: ExecutorMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct ExecutorMetrics
+
+@brief struct to store a snapshot of the scheduling counters of an executor
+
+The snapshot has one tf::WorkerMetrics per worker slot of the executor,
+indexed by the worker id and including the slots of retired workers.
+The counters of a running executor are read without synchronization and
+may therefore be slightly out of date with respect to each other.
+*/
+struct ExecutorMetrics {
+
+  /**
+  @brief per-worker metrics indexed by worker id
+  */
+  std::vector<WorkerMetrics> workers;
+
+  /**
+  @brief sums up the metrics of all workers
+  */
+  WorkerMetrics total() const {
+    WorkerMetrics sum;
+    for(const auto& w : workers) {
+      sum += w;
+    }
+    return sum;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: MetricsCounter
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief class to count scheduling events of a worker
+
+Only the owning worker updates the counters, so we avoid atomic read-modify-write
+operations and use relaxed loads and stores that other threads can read
+at any time. When @c TF_ENABLE_SCHEDULER_METRICS is not defined,
+all member functions are empty and get optimized away.
+*/
+class MetricsCounter {
+
+  public:
+
+  enum : size_t {
+    EXECUTED_TASKS = 0,
+    STEALS,
+    FAILED_STEALS,
+    YIELDS,
+    SLEEPS,
+    WAKEUPS,
+    OVERFLOWS,
+    BUSY_TIME,
+    IDLE_TIME,
+    MAX
+  };
+
+#ifdef TF_ENABLE_SCHEDULER_METRICS
+
+  TF_FORCE_INLINE void add(size_t c, size_t v = 1) {
+    _counts[c].store(_counts[c].load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+  }
+
+  // starts the clock for elapse
+  TF_FORCE_INLINE void start() {
+    _last = std::chrono::steady_clock::now();
+  }
+
+  // adds the time elapsed since the last call to start or elapse to counter c
+  TF_FORCE_INLINE void elapse(size_t c) {
+    auto now = std::chrono::steady_clock::now();
+    add(c, static_cast<size_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - _last).count()
+    ));
+    _last = now;
+  }
+
+  WorkerMetrics snapshot() const {
+    WorkerMetrics m;
+    m.num_executed_tasks = _counts[EXECUTED_TASKS].load(std::memory_order_relaxed);
+    m.num_steals = _counts[STEALS].load(std::memory_order_relaxed);
+    m.num_failed_steals = _counts[FAILED_STEALS].load(std::memory_order_relaxed);
+    m.num_yields = _counts[YIELDS].load(std::memory_order_relaxed);
+    m.num_sleeps = _counts[SLEEPS].load(std::memory_order_relaxed);
+    m.num_wakeups = _counts[WAKEUPS].load(std::memory_order_relaxed);
+    m.num_overflows = _counts[OVERFLOWS].load(std::memory_order_relaxed);
+    m.busy_time = std::chrono::nanoseconds(_counts[BUSY_TIME].load(std::memory_order_relaxed));
+    m.idle_time = std::chrono::nanoseconds(_counts[IDLE_TIME].load(std::memory_order_relaxed));
+    return m;
+  }
+
+  private:
+
+  std::array<std::atomic<size_t>, MAX> _counts {};
+  std::chrono::steady_clock::time_point _last;
+
+#else
+
+  TF_FORCE_INLINE void add(size_t, size_t = 1) {}
+  TF_FORCE_INLINE void start() {}
+  TF_FORCE_INLINE void elapse(size_t) {}
+  WorkerMetrics snapshot() const { return {}; }
+
+#endif
+};
+
+}  // end of namespace tf -----------------------------------------------------
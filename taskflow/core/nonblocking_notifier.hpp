@@ -69,18 +69,23 @@ class NonblockingNotifierV1 {
   struct Waiter {
     alignas (2*TF_CACHELINE_SIZE) std::atomic<Waiter*> next;
     uint64_t epoch;
+    // kTargeted marks a waiter woken up by notify(w) that is still 
+    // on the stack
     enum : unsigned {
       kNotSignaled = 0,
       kWaiting,
       kSignaled,
+      kTargeted,
     };
 
+    std::atomic<bool> notified {false};
+
 #if __cplusplus >= TF_CPP20
-    std::atomic<unsigned> state {0};
+    std::atomic<unsigned> state {kSignaled};
 #else
     std::mutex mu;
     std::condition_variable cv;
-    unsigned state;
+    unsigned state {kSignaled};
 #endif
   };
 
@@ -99,6 +104,7 @@ class NonblockingNotifierV1 {
   // After calling this function the thread must re-check the wait predicate
   // and call either cancel_wait or commit_wait passing the same Waiter object.
   void prepare_wait(Waiter* w) {
+    w->notified.store(false, std::memory_order_relaxed);
     w->epoch = _state.fetch_add(kWaiterInc, std::memory_order_relaxed);
     std::atomic_thread_fence(std::memory_order_seq_cst);
   }
@@ -106,11 +112,17 @@ class NonblockingNotifierV1 {
   // commit_wait commits waiting.
   // only the waiter itself can call
   void commit_wait(Waiter* w) {
-#if __cplusplus >= TF_CPP20
-    w->state.store(Waiter::kNotSignaled, std::memory_order_relaxed);
-#else
-    w->state = Waiter::kNotSignaled;
-#endif
+    // A waiter woken up by notify(w) is still on the stack and leaves the
+    // prewait counter without pushing itself a second time.
+    const bool ghost = _transit(w, Waiter::kTargeted, Waiter::kNotSignaled);
+    if(!ghost) {
+      _store(w, Waiter::kNotSignaled);
+    }
+    if(w->notified.load(std::memory_order_seq_cst)) {
+      cancel_wait(w);
+      _leave(w, ghost);
+      return;
+    }
     // Modification epoch of this waiter.
     uint64_t epoch =
         (w->epoch & kEpochMask) +
@@ -125,16 +137,21 @@ class NonblockingNotifierV1 {
         continue;
       }
       // We've already been notified.
-      if (int64_t((state & kEpochMask) - epoch) > 0) return;
+      if (int64_t((state & kEpochMask) - epoch) > 0) {
+        _leave(w, ghost);
+        return;
+      }
       // Remove this thread from prewait counter and add it to the waiter list.
       assert((state & kWaiterMask) != 0);
       uint64_t newstate = state - kWaiterInc + kEpochInc;
-      //newstate = (newstate & ~kStackMask) | (w - &_waiters[0]);
-      newstate = static_cast<uint64_t>((newstate & ~kStackMask) | static_cast<uint64_t>(w - &_waiters[0]));
-      if ((state & kStackMask) == kStackMask)
-        w->next.store(nullptr, std::memory_order_relaxed);
-      else
-        w->next.store(&_waiters[state & kStackMask], std::memory_order_relaxed);
+      if(!ghost) {
+        //newstate = (newstate & ~kStackMask) | (w - &_waiters[0]);
+        newstate = static_cast<uint64_t>((newstate & ~kStackMask) | static_cast<uint64_t>(w - &_waiters[0]));
+        if ((state & kStackMask) == kStackMask)
+          w->next.store(nullptr, std::memory_order_relaxed);
+        else
+          w->next.store(&_waiters[state & kStackMask], std::memory_order_relaxed);
+      }
       if (_state.compare_exchange_weak(state, newstate,
                                        std::memory_order_release))
         break;
@@ -174,15 +191,44 @@ class NonblockingNotifierV1 {
     _notify<true>();
   }
 
+  // notify wakes up the given waiter only, which stays on the stack and 
+  // parks again in place at its next commit_wait.
+  // Must be called after changing the associated wait predicate.
+  void notify(Waiter* w) {
+    w->notified.store(true, std::memory_order_seq_cst);
+#if __cplusplus >= TF_CPP20
+    unsigned state = w->state.load(std::memory_order_seq_cst);
+    while(state == Waiter::kNotSignaled || state == Waiter::kWaiting) {
+      if(w->state.compare_exchange_weak(state, Waiter::kTargeted, 
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_seq_cst)) {
+        if(state == Waiter::kWaiting) {
+          w->state.notify_one();
+        }
+        return;
+      }
+    }
+#else
+    unsigned state;
+    {
+      std::unique_lock<std::mutex> lock(w->mu);
+      state = w->state;
+      if(state == Waiter::kNotSignaled || state == Waiter::kWaiting) {
+        w->state = Waiter::kTargeted;
+      }
+    }
+    if (state == Waiter::kWaiting) w->cv.notify_one();
+#endif
+  }
+
   // notify n workers
   void notify_n(size_t n) {
     if(n >= _waiters.size()) {
       _notify<true>();
     }
     else {
-      for(size_t k=0; k<n; ++k) {
-        _notify<false>();
-      }
+      // stop early once no thread is left waiting
+      for(size_t k=0; k<n && _notify<false>(); ++k);
     }
   }
 
@@ -190,6 +236,11 @@ class NonblockingNotifierV1 {
     return _waiters.size();
   }
 
+  // waiter returns the i-th waiter, which only one thread may wait on
+  Waiter* waiter(size_t i) {
+    return &_waiters[i];
+  }
+
  private:
 
   // State_ layout:
@@ -220,14 +271,53 @@ class NonblockingNotifierV1 {
     }
 #else
     std::unique_lock<std::mutex> lock(w->mu);
-    while (w->state != Waiter::kSignaled) {
+    while (w->state != Waiter::kSignaled && w->state != Waiter::kTargeted) {
       w->state = Waiter::kWaiting;
       w->cv.wait(lock);
     }
 #endif
   }
 
-  void _unpark(Waiter* waiters) {
+  // _transit changes the waiter state from the expected one to the desired one
+  bool _transit(Waiter* w, unsigned expected, unsigned desired) {
+#if __cplusplus >= TF_CPP20
+    return w->state.compare_exchange_strong(expected, desired,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_seq_cst);
+#else
+    std::unique_lock<std::mutex> lock(w->mu);
+    if(w->state != expected) {
+      return false;
+    }
+    w->state = desired;
+    return true;
+#endif
+  }
+
+  void _store(Waiter* w, unsigned state) {
+#if __cplusplus >= TF_CPP20
+    w->state.store(state, std::memory_order_seq_cst);
+#else
+    std::unique_lock<std::mutex> lock(w->mu);
+    w->state = state;
+#endif
+  }
+
+  // _leave marks a waiter that returns from commit_wait without parking
+  // as awake, and a waiter still on the stack as targeted unless it has
+  // been popped in the meantime
+  void _leave(Waiter* w, bool ghost) {
+    if(ghost) {
+      _transit(w, Waiter::kNotSignaled, Waiter::kTargeted);
+    }
+    else {
+      _store(w, Waiter::kSignaled);
+    }
+  }
+
+  // _unpark returns false if all waiters were already woken up by notify(w)
+  bool _unpark(Waiter* waiters) {
+    bool woken = false;
     Waiter* next = nullptr;
     for (Waiter* w = waiters; w; w = next) {
       next = w->next.load(std::memory_order_relaxed);
@@ -235,8 +325,8 @@ class NonblockingNotifierV1 {
       // We only notify if the other is waiting - this is why we use tri-state
       // variable instead of binary-state variable (i.e., atomic_flag)
       // Performance is about 0.1% faster
-      if(w->state.exchange(Waiter::kSignaled, std::memory_order_relaxed) == 
-         Waiter::kWaiting) {
+      unsigned state = w->state.exchange(Waiter::kSignaled, std::memory_order_relaxed);
+      if(state == Waiter::kWaiting) {
         w->state.notify_one();
       }
 #else
@@ -249,19 +339,22 @@ class NonblockingNotifierV1 {
       // Avoid notifying if it wasn't waiting.
       if (state == Waiter::kWaiting) w->cv.notify_one();
 #endif
+      woken |= (state != Waiter::kTargeted);
     }
+    return woken;
   }
   
-  // notify wakes one or all waiting threads.
+  // notify wakes one or all waiting threads and returns false if
+  // there was no thread to wake up.
   // Must be called after changing the associated wait predicate.
   template <bool all>
-  void _notify() {
+  bool _notify() {
     std::atomic_thread_fence(std::memory_order_seq_cst);
     uint64_t state = _state.load(std::memory_order_acquire);
     for (;;) {
       // Easy case: no waiters.
       if ((state & kStackMask) == kStackMask && (state & kWaiterMask) == 0) {
-        return;
+        return false;
       }
       uint64_t waiters = (state & kWaiterMask) >> kWaiterShift;
       uint64_t newstate;
@@ -288,14 +381,15 @@ class NonblockingNotifierV1 {
       }
       if (_state.compare_exchange_weak(state, newstate,
                                        std::memory_order_acquire)) {
-        if (!all && waiters) return;  // unblocked pre-wait thread
-        if ((state & kStackMask) == kStackMask) return;
+        if (!all && waiters) return true;  // unblocked pre-wait thread
+        if ((state & kStackMask) == kStackMask) return true;
         Waiter* w = &_waiters[state & kStackMask];
         if (!all) {
           w->next.store(nullptr, std::memory_order_relaxed);
         }
-        _unpark(w);
-        return;
+        // retry if the popped waiter is already awake
+        if (_unpark(w) || all) return true;
+        state = _state.load(std::memory_order_acquire);
       }
     }
   }
@@ -338,18 +432,23 @@ class NonblockingNotifierV2 {
   struct Waiter {
     alignas (2*TF_CACHELINE_SIZE) std::atomic<uint64_t> next{kStackMask};
     uint64_t epoch{0};
+    // kTargeted marks a waiter woken up by notify(w) that is still 
+    // on the stack
     enum : unsigned {
       kNotSignaled = 0,
       kWaiting,
       kSignaled,
+      kTargeted,
     };
 
+    std::atomic<bool> notified {false};
+
 #if __cplusplus >= TF_CPP20
-    std::atomic<unsigned> state {kNotSignaled};
+    std::atomic<unsigned> state {kSignaled};
 #else
     std::mutex mu;
     std::condition_variable cv;
-    unsigned state {kNotSignaled};
+    unsigned state {kSignaled};
 #endif
   };
 
@@ -375,18 +474,25 @@ class NonblockingNotifierV2 {
   //  }
   //}
 
-  void prepare_wait(Waiter*) {
+  void prepare_wait(Waiter* w) {
+    w->notified.store(false, std::memory_order_relaxed);
     _state.fetch_add(kWaiterInc, std::memory_order_relaxed);
     std::atomic_thread_fence(std::memory_order_seq_cst);
   }
 
   // commit_wait commits waiting after prepare_wait.
   void commit_wait(Waiter* w) {
-#if __cplusplus >= TF_CPP20
-    w->state.store(Waiter::kNotSignaled, std::memory_order_relaxed);
-#else
-    w->state = Waiter::kNotSignaled;
-#endif
+    // A waiter woken up by notify(w) is still on the stack and leaves the
+    // pre-wait counter without pushing itself a second time.
+    const bool ghost = _transit(w, Waiter::kTargeted, Waiter::kNotSignaled);
+    if(!ghost) {
+      _store(w, Waiter::kNotSignaled);
+    }
+    if(w->notified.load(std::memory_order_seq_cst)) {
+      cancel_wait(w);
+      _leave(w, ghost);
+      return;
+    }
     const uint64_t me = (w - &_waiters[0]) | w->epoch;
     uint64_t state = _state.load(std::memory_order_seq_cst);
     for (;;) {
@@ -395,6 +501,9 @@ class NonblockingNotifierV2 {
       if ((state & kSignalMask) != 0) {
         // Consume the signal and return immediately.
         newstate = state - kWaiterInc - kSignalInc;
+      } else if (ghost) {
+        // Remove this thread from pre-wait counter only.
+        newstate = state - kWaiterInc;
       } else {
         // Remove this thread from pre-wait counter and add to the waiter stack.
         newstate = ((state & kWaiterMask) - kWaiterInc) | me;
@@ -403,9 +512,14 @@ class NonblockingNotifierV2 {
       //_check_state(newstate);
       if (_state.compare_exchange_weak(state, newstate, std::memory_order_acq_rel)) {
         if ((state & kSignalMask) == 0) {
-          w->epoch += kEpochInc;
+          if(!ghost) {
+            w->epoch += kEpochInc;
+          }
           _park(w);
         }
+        else {
+          _leave(w, ghost);
+        }
         return;
       }
     }
@@ -434,6 +548,36 @@ class NonblockingNotifierV2 {
   void notify_all() {
     _notify<true>();
   }
+
+  // notify wakes up the given waiter only, which stays on the stack and 
+  // parks again in place at its next commit_wait.
+  // Must be called after changing the associated wait predicate.
+  void notify(Waiter* w) {
+    w->notified.store(true, std::memory_order_seq_cst);
+#if __cplusplus >= TF_CPP20
+    unsigned state = w->state.load(std::memory_order_seq_cst);
+    while(state == Waiter::kNotSignaled || state == Waiter::kWaiting) {
+      if(w->state.compare_exchange_weak(state, Waiter::kTargeted, 
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_seq_cst)) {
+        if(state == Waiter::kWaiting) {
+          w->state.notify_one();
+        }
+        return;
+      }
+    }
+#else
+    unsigned state;
+    {
+      std::unique_lock<std::mutex> lock(w->mu);
+      state = w->state;
+      if(state == Waiter::kNotSignaled || state == Waiter::kWaiting) {
+        w->state = Waiter::kTargeted;
+      }
+    }
+    if (state == Waiter::kWaiting) w->cv.notify_one();
+#endif
+  }
   
   // notify n workers
   void notify_n(size_t n) {
@@ -441,9 +585,8 @@ class NonblockingNotifierV2 {
       _notify<true>();
     }
     else {
-      for(size_t k=0; k<n; ++k) {
-        _notify<false>();
-      }
+      // stop early once no thread is left waiting
+      for(size_t k=0; k<n && _notify<false>(); ++k);
     }
   }
 
@@ -451,6 +594,11 @@ class NonblockingNotifierV2 {
     return _waiters.size();
   }
 
+  // waiter returns the i-th waiter, which only one thread may wait on
+  Waiter* waiter(size_t i) {
+    return &_waiters[i];
+  }
+
   private:
 
 
@@ -467,20 +615,59 @@ class NonblockingNotifierV2 {
     }
 #else
     std::unique_lock<std::mutex> lock(w->mu);
-    while (w->state != Waiter::kSignaled) {
+    while (w->state != Waiter::kSignaled && w->state != Waiter::kTargeted) {
       w->state = Waiter::kWaiting;
       w->cv.wait(lock);
     }
 #endif
   }
 
-  void _unpark(Waiter* w) {
+  // _transit changes the waiter state from the expected one to the desired one
+  bool _transit(Waiter* w, unsigned expected, unsigned desired) {
+#if __cplusplus >= TF_CPP20
+    return w->state.compare_exchange_strong(expected, desired,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_seq_cst);
+#else
+    std::unique_lock<std::mutex> lock(w->mu);
+    if(w->state != expected) {
+      return false;
+    }
+    w->state = desired;
+    return true;
+#endif
+  }
+
+  void _store(Waiter* w, unsigned state) {
+#if __cplusplus >= TF_CPP20
+    w->state.store(state, std::memory_order_seq_cst);
+#else
+    std::unique_lock<std::mutex> lock(w->mu);
+    w->state = state;
+#endif
+  }
+
+  // _leave marks a waiter that returns from commit_wait without parking
+  // as awake, and a waiter still on the stack as targeted unless it has
+  // been popped in the meantime
+  void _leave(Waiter* w, bool ghost) {
+    if(ghost) {
+      _transit(w, Waiter::kNotSignaled, Waiter::kTargeted);
+    }
+    else {
+      _store(w, Waiter::kSignaled);
+    }
+  }
+
+  // _unpark returns false if all waiters were already woken up by notify(w)
+  bool _unpark(Waiter* w) {
+    bool woken = false;
     for (Waiter* next; w; w = next) {
       uint64_t wnext = w->next.load(std::memory_order_relaxed) & kStackMask;
       next = (wnext == kStackMask) ? nullptr : &_waiters[static_cast<size_t>(wnext)];
 #if __cplusplus >= TF_CPP20
-      if(w->state.exchange(Waiter::kSignaled, std::memory_order_relaxed) == 
-         Waiter::kWaiting) {
+      unsigned state = w->state.exchange(Waiter::kSignaled, std::memory_order_relaxed);
+      if(state == Waiter::kWaiting) {
         w->state.notify_one();
       }
 #else      
@@ -493,13 +680,16 @@ class NonblockingNotifierV2 {
       // Avoid notifying if it wasn't waiting.
       if (state == Waiter::kWaiting) w->cv.notify_one();
 #endif
+      woken |= (state != Waiter::kTargeted);
     }
+    return woken;
   }
   
-  // Notify wakes one or all waiting threads.
+  // Notify wakes one or all waiting threads and returns false if
+  // there was no thread to wake up.
   // Must be called after changing the associated wait predicate.
   template <bool notifyAll>
-  void _notify() {
+  bool _notify() {
     std::atomic_thread_fence(std::memory_order_seq_cst);
     uint64_t state = _state.load(std::memory_order_acquire);
     for (;;) {
@@ -507,7 +697,7 @@ class NonblockingNotifierV2 {
       const uint64_t waiters = (state & kWaiterMask) >> kWaiterShift;
       const uint64_t signals = (state & kSignalMask) >> kSignalShift;
       // Easy case: no waiters.
-      if ((state & kStackMask) == kStackMask && waiters == signals) return;
+      if ((state & kStackMask) == kStackMask && waiters == signals) return false;
       uint64_t newstate;
       if (notifyAll) {
         // Empty wait stack and set signal to number of pre-wait threads.
@@ -523,12 +713,13 @@ class NonblockingNotifierV2 {
       }
       //_check_state(newstate);
       if (_state.compare_exchange_weak(state, newstate, std::memory_order_acq_rel)) {
-        if (!notifyAll && (signals < waiters)) return;  // unblocked pre-wait thread
-        if ((state & kStackMask) == kStackMask) return;
+        if (!notifyAll && (signals < waiters)) return true;  // unblocked pre-wait thread
+        if ((state & kStackMask) == kStackMask) return true;
         Waiter* w = &_waiters[state & kStackMask];
         if (!notifyAll) w->next.store(kStackMask, std::memory_order_relaxed);
-        _unpark(w);
-        return;
+        // retry if the popped waiter is already awake
+        if (_unpark(w) || notifyAll) return true;
+        state = _state.load(std::memory_order_acquire);
       }
     }
   }
@@ -479,7 +479,7 @@ inline bool Executor::_invoke_runtime_task(Worker& worker, Node* node) {
 
 // Function: _invoke_runtime_task_impl
 inline bool Executor::_invoke_runtime_task_impl(
-  Worker& worker, Node* node, std::function<void(Runtime&)>& work
+  Worker& worker, Node* node, SmallFunction<void(Runtime&)>& work
 ) {
   // first time
   if((node->_nstate & NSTATE::PREEMPTED) == 0) {
@@ -506,7 +506,7 @@ inline bool Executor::_invoke_runtime_task_impl(
 
 // Function: _invoke_runtime_task_impl
 inline bool Executor::_invoke_runtime_task_impl(
-  Worker& worker, Node* node, std::function<void(Runtime&, bool)>& work
+  Worker& worker, Node* node, SmallFunction<void(Runtime&, bool)>& work
 ) {
     
   Runtime rt(*this, worker, node);
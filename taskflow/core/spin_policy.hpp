@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#include "worker.hpp"
+
+/**
+@file spin_policy.hpp
+@brief spin policy include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: SpinBudget
+// ----------------------------------------------------------------------------
+
+/**
+@struct SpinBudget
+
+@brief struct to describe how long an idle worker looks for tasks before sleeping
+
+A worker that runs out of tasks repeatedly tries to steal a task from
+the other queues.
+After @c max_steals failed attempts, the worker yields its thread
+after every further failed attempt,
+and after another @c max_yields failed attempts, the worker goes to sleep
+until new tasks are scheduled.
+A polling worker (@c poll is @c true) never yields or sleeps: 
+after @c max_steals failed attempts, it backs off with a growing number of 
+CPU pause instructions between attempts (see tf::pause) 
+until it finds a task, which avoids the system call to wake it up.
+*/
+struct SpinBudget {
+
+  /**
+  @brief number of failed steal attempts before the worker starts yielding
+  */
+  size_t max_steals;
+
+  /**
+  @brief number of yields before the worker goes to sleep
+  */
+  size_t max_yields;
+
+  /**
+  @brief whether the worker busy-polls the queues instead of sleeping
+  */
+  bool poll {false};
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: SpinPolicy
+// ----------------------------------------------------------------------------
+
+/**
+@class SpinPolicy
+
+@brief class to configure how long idle workers spin before sleeping
+
+An idle worker that keeps stealing picks up new tasks with the lowest latency
+but burns CPU time (and the capacity of its hyperthread sibling)
+while no task arrives.
+An idle worker that goes to sleep saves the CPU time but must be woken up
+by the operating system when new tasks arrive.
+A spin policy decides this trade-off by giving each idle worker a tf::SpinBudget.
+
+@code{.cpp}
+// latency-sensitive service: spin long before going to sleep
+tf::Executor service(8, nullptr, std::make_shared<tf::FixedSpinPolicy>(64, 10000));
+
+// batch node: sleep right after one round of stealing
+tf::Executor batch(8, nullptr, std::make_shared<tf::FixedSpinPolicy>(1, 0));
+
+// learn the budget from the observed wake-to-work latency
+tf::Executor adaptive(8, nullptr, std::make_shared<tf::AdaptiveSpinPolicy>());
+@endcode
+
+Without a spin policy, an executor behaves as tf::FixedSpinPolicy with
+the default arguments but avoids the cost of calling the policy
+and measuring the latency.
+
+@attention
+The methods of a spin policy are invoked by all idle workers simultaneously.
+*/
+class SpinPolicy {
+
+  public:
+
+  /**
+  @brief default destructor
+  */
+  virtual ~SpinPolicy() = default;
+
+  /**
+  @brief queries the budget of a worker that has run out of tasks
+
+  @param worker a reference to the idle worker
+  @param num_queues number of queues the worker can steal tasks from
+
+  The method is called each time the worker starts looking for tasks,
+  including after it wakes up from sleep.
+  */
+  virtual SpinBudget budget(const Worker& worker, size_t num_queues) = 0;
+
+  /**
+  @brief method to call when an idle worker obtains its next task
+
+  @param worker a reference to the worker
+  @param latency time between the worker running out of tasks
+                 and obtaining the next one
+  @param num_failed_steals number of failed steal attempts in the meantime
+  @param slept whether the worker went to sleep in the meantime
+
+  The default implementation does nothing.
+  */
+  virtual void on_task(
+    const Worker& worker,
+    std::chrono::nanoseconds latency,
+    size_t num_failed_steals,
+    bool slept
+  ) {
+    (void)worker;
+    (void)latency;
+    (void)num_failed_steals;
+    (void)slept;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: FixedSpinPolicy
+// ----------------------------------------------------------------------------
+
+/**
+@class FixedSpinPolicy
+
+@brief class to create a spin policy of a fixed budget
+
+An idle worker makes <tt>(num_queues + 1) * steals_per_queue</tt>
+failed steal attempts before it starts yielding, and
+yields @c max_yields times before it goes to sleep.
+The default arguments give the default behavior of an executor.
+*/
+class FixedSpinPolicy : public SpinPolicy {
+
+  public:
+
+  /**
+  @brief constructs a fixed spin policy
+
+  @param steals_per_queue number of failed steal attempts per queue before yielding
+  @param max_yields number of yields before going to sleep
+  */
+  explicit FixedSpinPolicy(size_t steals_per_queue = 2, size_t max_yields = 100) :
+    _steals_per_queue {steals_per_queue},
+    _max_yields {max_yields} {
+  }
+
+  /**
+  @brief queries the fixed budget
+  */
+  SpinBudget budget(const Worker&, size_t num_queues) override {
+    return {(num_queues + 1) * _steals_per_queue, _max_yields};
+  }
+
+  private:
+
+  size_t _steals_per_queue;
+  size_t _max_yields;
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: BusyPollSpinPolicy
+// ----------------------------------------------------------------------------
+
+/**
+@class BusyPollSpinPolicy
+
+@brief class to create a spin policy in which some workers never sleep
+
+The first @c num_pollers workers (by worker id) busy-poll the queues 
+when they run out of tasks, backing off with CPU pause instructions 
+rather than yielding their threads or going to sleep.
+A task submitted to an executor with an idle poller therefore starts
+without waiting for the operating system to wake up a worker,
+at the cost of the pollers occupying their CPUs at all times.
+The executor does not notify a sleeping worker for as many new tasks 
+as there are idle pollers in their arena.
+The other workers follow tf::FixedSpinPolicy with the given arguments.
+
+@code{.cpp}
+// two of eight workers keep polling for low first-task latency
+tf::Executor executor(8, nullptr, std::make_shared<tf::BusyPollSpinPolicy>(2));
+@endcode
+
+Worker ids run across the arenas of an executor in the order of the arenas 
+(see tf::ArenaParams), so the pollers belong to the first arenas.
+A poller only picks up the tasks of another arena if its arena steals from 
+other arenas, so an executor with arenas should order them such that 
+the arenas that need pollers come first.
+
+Polling pays off only if each poller has a CPU of its own,
+for instance, through tf::CPUPinning.
+*/
+class BusyPollSpinPolicy : public FixedSpinPolicy {
+
+  public:
+
+  /**
+  @brief constructs a busy-poll spin policy
+
+  @param num_pollers number of workers that never sleep
+  @param steals_per_queue number of failed steal attempts per queue before 
+                          yielding (or backing off for pollers)
+  @param max_yields number of yields before the other workers go to sleep
+  */
+  explicit BusyPollSpinPolicy(
+    size_t num_pollers, size_t steals_per_queue = 2, size_t max_yields = 100
+  ) :
+    FixedSpinPolicy(steals_per_queue, max_yields),
+    _num_pollers {num_pollers} {
+  }
+
+  /**
+  @brief queries the polling budget for pollers or the fixed budget otherwise
+  */
+  SpinBudget budget(const Worker& worker, size_t num_queues) override {
+    auto b = FixedSpinPolicy::budget(worker, num_queues);
+    b.poll = worker.id() < _num_pollers;
+    return b;
+  }
+
+  /**
+  @brief queries the number of workers that never sleep
+  */
+  size_t num_pollers() const { return _num_pollers; }
+
+  private:
+
+  size_t _num_pollers;
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: AdaptiveSpinPolicy
+// ----------------------------------------------------------------------------
+
+/**
+@class AdaptiveSpinPolicy
+
+@brief class to create a spin policy that learns from the recent wake-to-work latency
+
+The policy keeps an exponential moving average of the latency between
+a worker running out of tasks and obtaining its next task, and of
+the time a failed steal attempt takes.
+An idle worker spins for about twice the average latency such that
+it picks up most new tasks without going to sleep.
+If the average latency exceeds @c max_latency, new tasks arrive too rarely
+for spinning to pay off, and idle workers go to sleep after one round of stealing.
+
+The learned state is shared by all workers using the policy, since
+the arrival of tasks is typically a property of the entire workload.
+*/
+class AdaptiveSpinPolicy : public SpinPolicy {
+
+  public:
+
+  /**
+  @brief constructs an adaptive spin policy
+
+  @param max_latency maximum wake-to-work latency an idle worker spins for
+  */
+  explicit AdaptiveSpinPolicy(
+    std::chrono::nanoseconds max_latency = std::chrono::microseconds(100)
+  ) :
+    _max_latency {static_cast<size_t>(max_latency.count())} {
+  }
+
+  /**
+  @brief queries the budget learned from the recent latency
+  */
+  SpinBudget budget(const Worker&, size_t num_queues) override {
+
+    size_t min_steals = num_queues + 1;
+
+    auto latency = _latency.load(std::memory_order_relaxed);
+
+    // spinning does not pay off
+    if(latency > _max_latency) {
+      return {min_steals, 0};
+    }
+
+    auto cost = std::max(_steal_cost.load(std::memory_order_relaxed), size_t{1});
+    auto num_steals = std::clamp(
+      2 * latency / cost, min_steals, std::max(_max_latency / cost, min_steals)
+    );
+
+    // a few rounds of stealing before yielding the rest of the budget
+    auto max_steals = std::min(num_steals, 2 * min_steals);
+    return {max_steals, num_steals - max_steals};
+  }
+
+  /**
+  @brief updates the moving averages from the latency of an idle worker
+  */
+  void on_task(
+    const Worker&, std::chrono::nanoseconds latency, size_t num_failed_steals, bool slept
+  ) override {
+
+    // cap the sample such that a single long idle period does not
+    // prevent the policy from adapting back
+    auto l = std::min(static_cast<size_t>(latency.count()), 2 * _max_latency + 1);
+    _update(_latency, l);
+
+    // only spinning episodes tell the cost of a steal attempt
+    if(!slept && num_failed_steals > 0) {
+      _update(_steal_cost, l / num_failed_steals);
+    }
+  }
+
+  /**
+  @brief queries the average wake-to-work latency
+  */
+  std::chrono::nanoseconds latency() const {
+    return std::chrono::nanoseconds(_latency.load(std::memory_order_relaxed));
+  }
+
+  private:
+
+  size_t _max_latency;
+
+  // concurrent updates may get lost, which is harmless for an average
+  std::atomic<size_t> _latency {0};
+  std::atomic<size_t> _steal_cost {100};
+
+  static void _update(std::atomic<size_t>& avg, size_t sample) {
+    auto a = avg.load(std::memory_order_relaxed);
+    avg.store(a - a/8 + sample/8, std::memory_order_relaxed);
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------
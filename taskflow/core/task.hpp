@@ -33,6 +33,8 @@ enum class TaskType : int {
   MODULE,
   /** @brief asynchronous task type */
   ASYNC,
+  /** @brief coroutine task type */
+  COROUTINE,
   /** @brief undefined task type (for internal use only) */
   UNDEFINED
 };
@@ -41,7 +43,7 @@ enum class TaskType : int {
 @private
 @brief array of all task types (used for iterating task types)
 */
-inline constexpr std::array<TaskType, 7> TASK_TYPES = {
+inline constexpr std::array<TaskType, 8> TASK_TYPES = {
   TaskType::PLACEHOLDER,
   TaskType::STATIC,
   TaskType::RUNTIME,
@@ -49,6 +51,7 @@ inline constexpr std::array<TaskType, 7> TASK_TYPES = {
   TaskType::CONDITION,
   TaskType::MODULE,
   TaskType::ASYNC,
+  TaskType::COROUTINE,
 };
 
 /**
@@ -64,6 +67,7 @@ TaskType::SUBFLOW         ->  "subflow"
 TaskType::CONDITION       ->  "condition"
 TaskType::MODULE          ->  "module"
 TaskType::ASYNC           ->  "async"
+TaskType::COROUTINE       ->  "coroutine"
 @endcode
 */
 inline const char* to_string(TaskType type) {
@@ -78,6 +82,7 @@ inline const char* to_string(TaskType type) {
     case TaskType::CONDITION:        val = "condition";       break;
     case TaskType::MODULE:           val = "module";          break;
     case TaskType::ASYNC:            val = "async";           break;
+    case TaskType::COROUTINE:        val = "coroutine";       break;
     default:                         val = "undefined";       break;
   }
 
@@ -181,6 +186,48 @@ std::function<tf::SmallVector<int>()>.
 template <typename C>
 constexpr bool is_multi_condition_task_v = std::is_invocable_r_v<SmallVector<int>, C>;
 
+#if __cplusplus >= TF_CPP20
+
+// ----------------------------------------------------------------------------
+// Coroutine Task Trait
+// ----------------------------------------------------------------------------
+
+/**
+@private
+*/
+template <typename T>
+struct is_coro : std::false_type {};
+
+/**
+@private
+*/
+template <typename T>
+struct is_coro<Coro<T>> : std::true_type {};
+
+/**
+@private
+*/
+template <typename C, typename = void>
+struct is_coroutine_task : std::false_type {};
+
+/**
+@private
+*/
+template <typename C>
+struct is_coroutine_task<C, std::enable_if_t<std::is_invocable_v<C>>>
+  : is_coro<std::invoke_result_t<C>> {};
+
+/**
+@brief determines if a callable is a coroutine task
+
+A coroutine task is a callable object that takes no arguments and
+returns a tf::Coro (C++20 only).
+*/
+template <typename C>
+constexpr bool is_coroutine_task_v = is_coroutine_task<C>::value;
+
+#endif
+
 
 // ----------------------------------------------------------------------------
 // Task
@@ -372,6 +419,83 @@ class Task {
     */
     Task& data(void* data);
     
+    /**
+    @brief assigns a priority value to the task
+
+    A priority value can be one of the following three levels, 
+    tf::TaskPriority::HIGH (numerically equivalent to 0),
+    tf::TaskPriority::NORMAL (numerically equivalent to 1), and
+    tf::TaskPriority::LOW (numerically equivalent to 2).
+    The smaller the priority value, the higher the priority.
+    By default, a task has the highest priority, tf::TaskPriority::HIGH.
+
+    @code{.cpp}
+    auto [A, B, C] = taskflow.emplace(
+      [] () { std::cout << "A\n"; },
+      [] () { std::cout << "B\n"; },  // runs after C
+      [] () { std::cout << "C\n"; }   // runs before B
+    );
+    A.precede(B, C);
+    B.priority(tf::TaskPriority::LOW);
+    C.priority(tf::TaskPriority::HIGH);
+    @endcode
+
+    Priority is a hint to the scheduler: each worker keeps one queue per
+    priority level and always drains the higher-priority levels first.
+    There is no guarantee that a lower-priority task never runs before
+    a higher-priority task that becomes ready at the same time on another worker.
+
+    @return @c *this
+    */
+    Task& priority(TaskPriority p);
+
+    /**
+    @brief queries the priority value of the task
+    */
+    TaskPriority priority() const;
+
+    /**
+    @brief assigns the id of the worker preferred to run the task
+
+    When the task becomes ready, the executor delivers it to the mailbox
+    of worker @c worker_id instead of the queue of the scheduling thread.
+    The worker checks its mailbox before stealing tasks from others,
+    which is useful for stateful tasks that reuse per-worker scratch buffers
+    or touch data first touched by that worker.
+
+    @code{.cpp}
+    tf::Executor executor(4);
+    std::vector<std::vector<float>> scratch(executor.num_workers());
+    
+    for(size_t w=0; w<executor.num_workers(); w++) {
+      taskflow.emplace([&, w](){ 
+        use(scratch[w]);   // most likely runs on worker w
+      }).affinity(w);
+    }
+    @endcode
+
+    Affinity is a hint to the scheduler rather than a guarantee:
+    if the worker does not pick up a task within the threshold
+    set by tf::Executor::affinity_threshold, 
+    other workers may steal the task.
+    A task with an affinity out of the range of running workers,
+    including tf::NO_AFFINITY (the default), or with an affinity to
+    a worker outside the arena of the task (see tf::ArenaParams)
+    is scheduled as usual.
+    Tasks delivered to a mailbox run in the order of their delivery
+    regardless of their priorities.
+
+    @return @c *this
+    */
+    Task& affinity(size_t worker_id);
+
+    /**
+    @brief queries the id of the worker preferred to run the task
+
+    Returns tf::NO_AFFINITY if the task has no affinity.
+    */
+    size_t affinity() const;
+
     /**
     @brief resets the task handle to null
     */
@@ -460,6 +584,7 @@ Task& Task::succeed(Ts&&... tasks) {
 template <typename T>
 Task& Task::composed_of(T& object) {
   _node->_handle.emplace<Node::Module>(object);
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -488,6 +613,7 @@ inline bool Task::operator != (const Task& rhs) const {
 // Function: name
 inline Task& Task::name(const std::string& name) {
   _node->_name = name;
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -497,6 +623,7 @@ inline Task& Task::acquire(Semaphore& s) {
     _node->_semaphores = std::make_unique<Node::Semaphores>();
   }
   _node->_semaphores->to_acquire.push_back(&s);
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -512,6 +639,7 @@ Task& Task::acquire(I first, I last) {
   for(auto s = first; s != last; ++s){
     _node->_semaphores->to_acquire.push_back(&(*s));
   }
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -521,6 +649,7 @@ inline Task& Task::release(Semaphore& s) {
     _node->_semaphores = std::make_unique<Node::Semaphores>();
   }
   _node->_semaphores->to_release.push_back(&s);
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -536,9 +665,32 @@ Task& Task::release(I first, I last) {
   for(auto s = first; s != last; ++s) {
     _node->_semaphores->to_release.push_back(&(*s));
   }
+  _node->_nstate |= NSTATE::DIRTY;
+  return *this;
+}
+
+// Function: priority
+inline Task& Task::priority(TaskPriority p) {
+  _node->_priority = static_cast<uint16_t>(p);
   return *this;
 }
 
+// Function: priority
+inline TaskPriority Task::priority() const {
+  return static_cast<TaskPriority>(_node->_priority);
+}
+
+// Function: affinity
+inline Task& Task::affinity(size_t worker_id) {
+  _node->_affinity = static_cast<unsigned>(std::min(worker_id, NO_AFFINITY));
+  return *this;
+}
+
+// Function: affinity
+inline size_t Task::affinity() const {
+  return _node->_affinity;
+}
+
 // Procedure: reset
 inline void Task::reset() {
   _node = nullptr;
@@ -547,6 +699,7 @@ inline void Task::reset() {
 // Procedure: reset_work
 inline void Task::reset_work() {
   _node->_handle.emplace<std::monostate>();
+  _node->_nstate |= NSTATE::DIRTY;
 }
 
 // Function: name
@@ -596,6 +749,9 @@ inline TaskType Task::type() const {
     case Node::MODULE:          return TaskType::MODULE;
     case Node::ASYNC:           return TaskType::ASYNC;
     case Node::DEPENDENT_ASYNC: return TaskType::ASYNC;
+#if __cplusplus >= TF_CPP20
+    case Node::COROUTINE:       return TaskType::COROUTINE;
+#endif
     default:                    return TaskType::UNDEFINED;
   }
 }
@@ -648,9 +804,15 @@ Task& Task::work(C&& c) {
   else if constexpr(is_multi_condition_task_v<C>) {
     _node->_handle.emplace<Node::MultiCondition>(std::forward<C>(c));
   }
+#if __cplusplus >= TF_CPP20
+  else if constexpr(is_coroutine_task_v<C>) {
+    _node->_handle.emplace<Node::Coroutine>(std::forward<C>(c));
+  }
+#endif
   else {
     static_assert(dependent_false_v<C>, "invalid task callable");
   }
+  _node->_nstate |= NSTATE::DIRTY;
   return *this;
 }
 
@@ -788,6 +950,9 @@ inline TaskType TaskView::type() const {
     case Node::MODULE:          return TaskType::MODULE;
     case Node::ASYNC:           return TaskType::ASYNC;
     case Node::DEPENDENT_ASYNC: return TaskType::ASYNC;
+#if __cplusplus >= TF_CPP20
+    case Node::COROUTINE:       return TaskType::COROUTINE;
+#endif
     default:                    return TaskType::UNDEFINED;
   }
 }
@@ -284,8 +284,129 @@ class Taskflow : public FlowBuilder {
     */
     Graph& graph();
 
+    /**
+    @brief compiles the taskflow into a flat graph for repeated runs
+
+    Each run of a taskflow resets the state of every task and
+    counts the dependencies of each task by visiting its predecessors.
+    Compiling a taskflow computes these states once and stores them
+    in a contiguous array, with the source tasks first,
+    such that the executor sets up each subsequent run by copying the
+    precomputed states and schedules the source tasks without searching for them.
+    This reduces the overhead of taskflows that run many times
+    (e.g., tf::Executor::run_n).
+
+    @code{.cpp}
+    tf::Taskflow taskflow;
+    auto [A, B, C] = taskflow.emplace(
+      [](){ std::cout << "A\n"; },
+      [](){ std::cout << "B\n"; },
+      [](){ std::cout << "C\n"; }
+    );
+    A.precede(B, C);
+
+    taskflow.compile();
+    executor.run_n(taskflow, 1000000).wait();
+    @endcode
+
+    Modifying the graph after compilation, such as adding or removing tasks
+    or dependencies or assigning new work to a task, is safe:
+    the executor detects the change at the next run, falls back to
+    the regular set-up, and discards the compiled graph.
+    You need to call tf::Taskflow::compile again to compile the new graph.
+    The behavior of compiling a running taskflow is undefined.
+    */
+    void compile();
+
+    /**
+    @brief queries if the taskflow has a compiled graph matching its tasks
+
+    @code{.cpp}
+    taskflow.compile();
+    assert(taskflow.compiled());
+    taskflow.placeholder();
+    assert(!taskflow.compiled());
+    @endcode
+    */
+    bool compiled() const;
+
+    /**
+    @brief enables or disables concurrent runs of the taskflow
+
+    By default, an executor runs the submissions of a taskflow one after
+    another, since the state of a run (e.g., join counters) lives in the tasks.
+    With concurrent runs enabled, each submission keeps the state of its run
+    in its own array of tasks, indexed like the compiled graph, that invoke
+    the work of the original tasks, such that multiple submissions of the same
+    taskflow (e.g., a taskflow that handles requests from many threads)
+    run at the same time.
+
+    @code{.cpp}
+    tf::Taskflow taskflow;
+    taskflow.emplace([](){ handle_request(); });
+    taskflow.concurrent_runs(true);
+
+    // the two runs may overlap
+    auto fu1 = executor.run(taskflow);
+    auto fu2 = executor.run(taskflow);
+    @endcode
+
+    Since submissions may invoke the same task concurrently, the work of
+    each task must be safe to invoke concurrently.
+    The taskflow is compiled (see tf::Taskflow::compile) before
+    the first concurrent run. The arrays of finished runs are kept by the
+    taskflow and reused by later submissions until the graph changes,
+    such that a steady stream of submissions does not allocate per task.
+    Concurrent runs do not support module tasks, and the executor throws
+    an exception when running such a taskflow concurrently.
+    The behavior of changing the mode while the taskflow is running is undefined.
+    */
+    void concurrent_runs(bool enable);
+
+    /**
+    @brief queries if concurrent runs of the taskflow are enabled
+    */
+    bool concurrent_runs() const;
+
+    /**
+    @brief assigns the id of the executor arena to run the taskflow
+
+    An executor constructed with multiple arenas (see tf::ArenaParams)
+    runs each submission of the taskflow on the workers of the arena
+    assigned at the time of the submission.
+    By default, a taskflow has no arena, tf::NO_ARENA, and runs in the arena
+    of the submitting worker, or in the first arena if submitted from
+    a thread outside the executor.
+    An id out of the range of the arenas of the executor is treated as tf::NO_ARENA.
+
+    @code{.cpp}
+    tf::Executor executor({{"interactive", 2}, {"background", 6}});
+    
+    interactive.arena(executor.arena_id("interactive"));
+    background.arena(executor.arena_id("background"));
+
+    // the background run does not delay the interactive run
+    executor.run(background);
+    executor.run(interactive).wait();
+    @endcode
+    */
+    void arena(size_t id);
+
+    /**
+    @brief queries the id of the executor arena to run the taskflow
+    */
+    size_t arena() const;
+
   private:
 
+    // per-task state of a compiled graph
+    struct FlatNode {
+      Node* node;           // task at the same position in _graph
+      size_t join_counter;  // number of strong dependencies
+      size_t successors;    // offset of the successor indices in _flat_successors
+      nstate_t nstate;      // number of weak dependencies and flags
+    };
+
     mutable std::mutex _mutex;
 
     std::string _name;
@@ -295,6 +416,29 @@ class Taskflow : public FlowBuilder {
     std::queue<std::shared_ptr<Topology>> _topologies;
     std::optional<std::list<Taskflow>::iterator> _satellite;
 
+    // compiled graph in the order of _graph, which has the source tasks first
+    std::vector<FlatNode> _flat_graph;
+    std::vector<size_t> _flat_successors;
+    size_t _flat_num_sources {0};
+
+    // recorded by the executor for the repeated runs of a single topology,
+    // without successors, and discarded when the topology completes
+    bool _flat_transient {false};
+
+    bool _concurrent_runs {false};
+
+    // number of concurrent runs in flight, counted under _mutex
+    size_t _num_concurrent_runs {0};
+
+    // per-run task arrays of finished concurrent runs for reuse
+    std::vector<std::unique_ptr<Node[]>> _run_nodes;
+
+    size_t _arena {NO_ARENA};
+
+    void _clear_flat_graph();
+    std::unique_ptr<Node[]> _acquire_run_nodes();
+    std::unique_ptr<Node[]> _make_run_nodes() const;
+
     void _dump(std::ostream&, const Graph*) const;
     void _dump(std::ostream&, const Node*, Dumper&) const;
     void _dump(std::ostream&, const Graph*, Dumper&) const;
@@ -319,8 +463,16 @@ inline Taskflow::Taskflow(Taskflow&& rhs) : FlowBuilder{_graph} {
   _graph = std::move(rhs._graph);
   _topologies = std::move(rhs._topologies);
   _satellite = rhs._satellite;
+  _flat_graph = std::move(rhs._flat_graph);
+  _flat_successors = std::move(rhs._flat_successors);
+  _flat_num_sources = rhs._flat_num_sources;
+  _flat_transient = rhs._flat_transient;
+  _concurrent_runs = rhs._concurrent_runs;
+  _num_concurrent_runs = rhs._num_concurrent_runs;
+  _arena = rhs._arena;
 
   rhs._satellite.reset();
+  rhs._clear_flat_graph();
 }
 
 // Move assignment
@@ -331,7 +483,15 @@ inline Taskflow& Taskflow::operator = (Taskflow&& rhs) {
     _graph = std::move(rhs._graph);
     _topologies = std::move(rhs._topologies);
     _satellite = rhs._satellite;
+    _flat_graph = std::move(rhs._flat_graph);
+    _flat_successors = std::move(rhs._flat_successors);
+    _flat_num_sources = rhs._flat_num_sources;
+    _flat_transient = rhs._flat_transient;
+    _concurrent_runs = rhs._concurrent_runs;
+    _num_concurrent_runs = rhs._num_concurrent_runs;
+    _arena = rhs._arena;
     rhs._satellite.reset();
+    rhs._clear_flat_graph();
   }
   return *this;
 }
@@ -339,6 +499,7 @@ inline Taskflow& Taskflow::operator = (Taskflow&& rhs) {
 // Procedure:
 inline void Taskflow::clear() {
   _graph.clear();
+  _clear_flat_graph();
 }
 
 // Function: num_tasks
@@ -366,6 +527,204 @@ inline Graph& Taskflow::graph() {
   return _graph;
 }
 
+// Procedure: compile
+inline void Taskflow::compile() {
+
+  _clear_flat_graph();
+
+  // move source tasks to the front, which is also the order _set_up_graph
+  // leaves the graph in such that composition does not invalidate the result
+  auto send = std::stable_partition(_graph.begin(), _graph.end(), [](auto& node){
+    return node->num_predecessors() == 0;
+  });
+  _flat_num_sources = send - _graph.begin();
+
+  _flat_graph.reserve(_graph.size());
+
+  std::unordered_map<const Node*, size_t> indices;
+  indices.reserve(_graph.size());
+  for(size_t i=0; i<_graph.size(); i++) {
+    indices[_graph[i].get()] = i;
+  }
+
+  // compilation clears the dirty flag every modification of a task sets
+  for(auto& node : _graph) {
+    node->_nstate = NSTATE::NONE;
+    node->_set_up_join_counter();
+    _flat_graph.push_back({
+      node.get(),
+      node->_join_counter.load(std::memory_order_relaxed),
+      _flat_successors.size(),
+      node->_nstate
+    });
+    for(size_t i=0; i<node->_num_successors; i++) {
+      _flat_successors.push_back(indices[node->_edges[i]]);
+    }
+  }
+}
+
+// Function: compiled
+inline bool Taskflow::compiled() const {
+  if(_flat_transient || _flat_graph.empty() || _flat_graph.size() != _graph.size()) {
+    return false;
+  }
+  for(size_t i=0; i<_graph.size(); i++) {
+    auto& s = _flat_graph[i];
+    if(_graph[i].get() != s.node || (s.node->_nstate & NSTATE::DIRTY)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Procedure: _clear_flat_graph
+inline void Taskflow::_clear_flat_graph() {
+  _flat_graph.clear();
+  _flat_successors.clear();
+  _flat_num_sources = 0;
+  _flat_transient = false;
+  _run_nodes.clear();
+}
+
+// Procedure: concurrent_runs
+inline void Taskflow::concurrent_runs(bool enable) {
+  _concurrent_runs = enable;
+}
+
+// Function: concurrent_runs
+inline bool Taskflow::concurrent_runs() const {
+  return _concurrent_runs;
+}
+
+// Procedure: arena
+inline void Taskflow::arena(size_t id) {
+  _arena = std::min(id, NO_ARENA);
+}
+
+// Function: arena
+inline size_t Taskflow::arena() const {
+  return _arena;
+}
+
+// Function: _acquire_run_nodes
+// acquires the tasks of a new concurrent run and counts the run
+inline std::unique_ptr<Node[]> Taskflow::_acquire_run_nodes() {
+
+  std::unique_ptr<Node[]> nodes;
+
+  // the graph cannot change while a run is in flight, so only a submission
+  // that finds no other run checks the graph against the compiled one
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(_num_concurrent_runs == 0 && !compiled()) {
+      compile();
+    }
+    if(!_run_nodes.empty()) {
+      nodes = std::move(_run_nodes.back());
+      _run_nodes.pop_back();
+    }
+    ++_num_concurrent_runs;
+  }
+
+  if(!nodes) {
+    try {
+      nodes = _make_run_nodes();
+    }
+    catch(...) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      --_num_concurrent_runs;
+      throw;
+    }
+  }
+
+  return nodes;
+}
+
+// Function: _make_run_nodes
+// creates the tasks of a concurrent run in the order of the compiled graph,
+// where each task invokes the work of its original task and keeps
+// the state of the run
+inline std::unique_ptr<Node[]> Taskflow::_make_run_nodes() const {
+
+  const size_t n = _flat_graph.size();
+
+  auto nodes = std::make_unique<Node[]>(n);
+
+  for(size_t i=0; i<n; i++) {
+
+    auto node = _flat_graph[i].node;
+    auto& r = nodes[i];
+
+    // forwarding the work through the original task takes no allocation
+    switch(node->_handle.index()) {
+      case Node::PLACEHOLDER:
+      break;
+
+      case Node::STATIC:
+        r._handle.emplace<Node::Static>([node](){
+          std::get_if<Node::Static>(&node->_handle)->work();
+        });
+      break;
+
+      case Node::RUNTIME:
+        r._handle.emplace<Node::Runtime>([node](tf::Runtime& rt){
+          std::get_if<Node::Runtime>(&node->_handle)->work(rt);
+        });
+      break;
+
+      case Node::SUBFLOW:
+        r._handle.emplace<Node::Subflow>([node](tf::Subflow& sf){
+          std::get_if<Node::Subflow>(&node->_handle)->work(sf);
+        });
+      break;
+
+      case Node::CONDITION:
+        r._handle.emplace<Node::Condition>([node](){
+          return std::get_if<Node::Condition>(&node->_handle)->work();
+        });
+      break;
+
+      case Node::MULTI_CONDITION:
+        r._handle.emplace<Node::MultiCondition>([node](){
+          return std::get_if<Node::MultiCondition>(&node->_handle)->work();
+        });
+      break;
+
+#if __cplusplus >= TF_CPP20
+      case Node::COROUTINE:
+        r._handle.emplace<Node::Coroutine>([node](){
+          return std::get_if<Node::Coroutine>(&node->_handle)->work();
+        });
+      break;
+#endif
+
+      default:
+        TF_THROW("concurrent runs do not support module task '", node->_name, "'");
+      break;
+    }
+
+    r._name = node->_name;
+    r._data = node->_data;
+    r._priority = node->_priority;
+    r._affinity = node->_affinity;
+    r._arena = node->_arena;
+    if(node->_semaphores) {
+      r._semaphores = std::make_unique<Node::Semaphores>(*node->_semaphores);
+    }
+  }
+  
+  // add dependencies in the same order to keep the indices of condition tasks
+  for(size_t i=0; i<n; i++) {
+    auto beg = _flat_graph[i].successors;
+    auto end = (i + 1 < n) ? _flat_graph[i+1].successors : _flat_successors.size();
+    for(; beg != end; ++beg) {
+      nodes[i]._precede(&nodes[_flat_successors[beg]]);
+    }
+  }
+
+  return nodes;
+}
+
 // Function: for_each_task
 template <typename V>
 void Taskflow::for_each_task(V&& visitor) const {
@@ -542,7 +901,8 @@ inline void Taskflow::_dump(
 @brief class to access the result of an execution
 
 tf::Future is a derived class from std::future that will eventually hold the
-execution result of a submitted taskflow (tf::Executor::run)
+execution result of a submitted taskflow (tf::Executor::run) or
+an async task (tf::Executor::async).
 In addition to the base methods inherited from std::future,
 you can call tf::Future::cancel to cancel the execution of the running taskflow
 associated with this future object.
@@ -575,6 +935,10 @@ class Future : public std::future<T>  {
   friend class Executor;
   friend class Subflow;
   friend class Runtime;
+  friend class CoroPromiseBase;
+
+  template <typename P>
+  friend class AsyncPromise;
 
   public:
 
@@ -616,17 +980,48 @@ class Future : public std::future<T>  {
     You can call tf::Future::wait to wait for the cancellation to complete.
     */
     bool cancel();
+    
+    /**
+    @brief waits until the result becomes available
+
+    When the caller is a worker of the executor that created this future,
+    the worker keeps running other tasks of the executor until the result 
+    becomes available, instead of blocking its thread.
+    Otherwise, the caller blocks as in std::future::wait.
+    */
+    void wait() const;
+
+    /**
+    @brief waits until the result becomes available and retrieves it
+
+    Similar to tf::Future::wait, a worker of the executor that created this
+    future keeps running other tasks of the executor while waiting for 
+    the result.
+    The result is then retrieved as in std::future::get.
+    */
+    decltype(auto) get();
 
   private:
     
+    Executor* _executor {nullptr};
     std::weak_ptr<Topology> _topology;
 
-    Future(std::future<T>&&, std::weak_ptr<Topology> = std::weak_ptr<Topology>());
+#if __cplusplus >= TF_CPP20
+    // coroutines awaiting the result of an async task
+    std::shared_ptr<FutureAwaiters> _awaiters;
+#endif
+
+    Future(
+      std::future<T>&&, 
+      Executor* = nullptr, 
+      std::weak_ptr<Topology> = std::weak_ptr<Topology>()
+    );
 };
 
 template <typename T>
-Future<T>::Future(std::future<T>&& f, std::weak_ptr<Topology> p) :
+Future<T>::Future(std::future<T>&& f, Executor* e, std::weak_ptr<Topology> p) :
   std::future<T> {std::move(f)},
+  _executor      {e},
   _topology      {std::move(p)} {
 }
 
@@ -640,5 +1035,114 @@ bool Future<T>::cancel() {
   return false;
 }
 
+// ----------------------------------------------------------------------------
+// RunHandle
+// ----------------------------------------------------------------------------
+
+/**
+@class RunHandle
+
+@brief class to wait for a submitted taskflow without a shared-state future
+
+A tf::RunHandle is a lightweight alternative to tf::Future returned by
+tf::Executor::submit, tf::Executor::submit_n, and tf::Executor::submit_until.
+The handle shares the topology of the run, which completes
+through an atomic flag instead of a std::promise, so a submission does not
+allocate the shared state of a promise and a future.
+Topologies are also allocated from a per-thread pool,
+which makes submitting tiny taskflows at a high rate considerably cheaper.
+
+@code{.cpp}
+tf::Executor executor;
+tf::Taskflow taskflow;
+
+taskflow.emplace([](){ std::cout << "hello\n"; });
+
+tf::RunHandle handle = executor.submit(taskflow);
+
+// do something else
+
+// wait for the run and rethrow the exception of the run, if any
+handle.get();
+@endcode
+
+Unlike tf::Future, the handle keeps the topology alive until the handle
+is destroyed, and the exception of the run is retrieved through
+tf::RunHandle::get rather than a std::future.
+*/
+class RunHandle {
+
+  friend class Executor;
+
+  public:
+
+    /**
+    @brief constructs a handle that refers to no run
+    
+    An empty handle counts as completed.
+    */
+    RunHandle() = default;
+
+    /**
+    @brief queries if the handle refers to a run
+    
+    A handle refers to no run if it is default-constructed or if
+    the submission completed immediately
+    (e.g., the taskflow is empty or the predicate is already satisfied).
+    */
+    bool valid() const noexcept {
+      return _topology != nullptr;
+    }
+
+    /**
+    @brief queries if the run has completed
+    */
+    bool done() const {
+      return _topology == nullptr || _topology->_is_done();
+    }
+
+    /**
+    @brief waits until the run completes
+    */
+    void wait() const {
+      if(_topology) {
+        _topology->_wait();
+      }
+    }
+
+    /**
+    @brief waits until the run completes and rethrows its exception, if any
+    */
+    void get() const {
+      wait();
+      if(_topology && _topology->_exception_ptr) {
+        std::rethrow_exception(_topology->_exception_ptr);
+      }
+    }
+
+    /**
+    @brief cancels the run
+
+    @return @c true if the run can be cancelled or
+            @c false if the run has already completed
+
+    Similar to tf::Future::cancel, the executor stops scheduling tasks
+    of the run, and tasks that are already running will continue to finish.
+    */
+    bool cancel() {
+      if(done()) {
+        return false;
+      }
+      _topology->_estate.fetch_or(ESTATE::CANCELLED, std::memory_order_relaxed);
+      return true;
+    }
+
+  private:
+
+    std::shared_ptr<Topology> _topology;
+
+    explicit RunHandle(std::shared_ptr<Topology> t) : _topology {std::move(t)} {
+    }
+};
 
 }  // end of namespace tf. ---------------------------------------------------
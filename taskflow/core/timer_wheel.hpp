@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+@file timer_wheel.hpp
+@brief timer wheel include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: TimerWheel
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief class to create a hierarchical timer wheel of items that expire at
+       a given tick
+
+The wheel has four levels of 64 slots. An item expiring @c d ticks from now
+goes to the lowest level @c l with <tt>d < 64^(l+1)</tt>, and items further
+away than <tt>64^4</tt> ticks go to an overflow list.
+Whenever the current tick crosses the boundary of a slot on a higher level,
+the items of that slot cascade to the lower levels, such that insertion
+and expiration take amortized constant time regardless of the number of
+pending items, and a wheel with many pending items costs nothing while
+no slot is due.
+The wheel is not thread-safe.
+*/
+template <typename T>
+class TimerWheel {
+
+  static constexpr size_t   SLOT_BITS  {6};
+  static constexpr size_t   NUM_SLOTS  {size_t{1} << SLOT_BITS};
+  static constexpr size_t   NUM_LEVELS {4};
+  static constexpr uint64_t SLOT_MASK  {NUM_SLOTS - 1};
+
+  struct Item {
+    uint64_t tick;
+    T value;
+  };
+
+  public:
+
+  /**
+  @brief tick returned by tf::TimerWheel::next_tick when the wheel is empty
+  */
+  static constexpr uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+  /**
+  @brief queries the current tick
+  */
+  uint64_t now() const { return _now; }
+
+  /**
+  @brief queries the number of pending items
+  */
+  size_t size() const { return _size; }
+
+  /**
+  @brief queries if the wheel has no pending items
+  */
+  bool empty() const { return _size == 0; }
+
+  /**
+  @brief inserts an item that expires at the given tick
+
+  An item of a tick that is not after the current tick expires
+  at the next tick.
+  */
+  void insert(uint64_t tick, T value) {
+    _place(Item{std::max(tick, _now + 1), std::move(value)});
+    ++_size;
+  }
+
+  /**
+  @brief queries the earliest tick at which the wheel has work to do
+
+  The returned tick is the earliest tick after the current tick at which
+  an item expires or a slot cascades, or tf::TimerWheel::NO_TICK if the
+  wheel is empty. Advancing the wheel to an earlier tick does nothing.
+  */
+  uint64_t next_tick() const {
+
+    if(_size == 0) {
+      return NO_TICK;
+    }
+
+    uint64_t next = NO_TICK;
+
+    for(size_t l=0; l<NUM_LEVELS; ++l) {
+      if(_occupied[l] == 0) {
+        continue;
+      }
+      auto block = _now >> (SLOT_BITS * l);
+      for(uint64_t i=1; i<=NUM_SLOTS; ++i) {
+        if(_occupied[l] & (uint64_t{1} << ((block + i) & SLOT_MASK))) {
+          next = std::min(next, (block + i) << (SLOT_BITS * l));
+          break;
+        }
+      }
+    }
+
+    if(!_overflow.empty()) {
+      auto shift = SLOT_BITS * NUM_LEVELS;
+      next = std::min(next, ((_now >> shift) + 1) << shift);
+    }
+
+    return next;
+  }
+
+  /**
+  @brief advances the wheel to the given tick
+
+  @param tick tick to advance the wheel to
+  @param expire callable invoked with each expired item, in the order of ticks
+
+  The wheel skips ahead over the ticks at which it has no work to do.
+  The callable must not insert items into the wheel.
+  */
+  template <typename C>
+  void advance(uint64_t tick, C&& expire) {
+
+    while(_now < tick) {
+
+      auto next = next_tick();
+
+      if(next > tick) {
+        _now = tick;
+        return;
+      }
+
+      _now = next;
+
+      // cascade from the highest level down, such that items reach level 0
+      // in the same step if they expire at this tick
+      if(auto shift = SLOT_BITS * NUM_LEVELS; (_now & ((uint64_t{1} << shift) - 1)) == 0) {
+        auto items = std::move(_overflow);
+        _overflow.clear();
+        for(auto& item : items) {
+          _place(std::move(item));
+        }
+      }
+
+      for(size_t l=NUM_LEVELS-1; l>=1; --l) {
+        if((_now & ((uint64_t{1} << (SLOT_BITS * l)) - 1)) == 0) {
+          _cascade(l, (_now >> (SLOT_BITS * l)) & SLOT_MASK);
+        }
+      }
+
+      auto s = _now & SLOT_MASK;
+      if(_occupied[0] & (uint64_t{1} << s)) {
+        auto items = std::move(_slots[0][s]);
+        _slots[0][s].clear();
+        _occupied[0] &= ~(uint64_t{1} << s);
+        _size -= items.size();
+        for(auto& item : items) {
+          expire(std::move(item.value));
+        }
+      }
+    }
+  }
+
+  /**
+  @brief removes the pending items for which the predicate returns true
+         regardless of their ticks
+
+  @param pred callable invoked with a reference to each pending item, 
+              which may take the item if it returns @c true
+
+  The current tick stays unchanged.
+  */
+  template <typename C>
+  void remove_if(C&& pred) {
+    for(size_t l=0; l<NUM_LEVELS; ++l) {
+      for(uint64_t s=0; s<NUM_SLOTS; ++s) {
+        if(_occupied[l] & (uint64_t{1} << s)) {
+          if(_remove_if(_slots[l][s], pred); _slots[l][s].empty()) {
+            _occupied[l] &= ~(uint64_t{1} << s);
+          }
+        }
+      }
+    }
+    _remove_if(_overflow, pred);
+  }
+
+  private:
+
+  std::array<std::array<std::vector<Item>, NUM_SLOTS>, NUM_LEVELS> _slots;
+  std::array<uint64_t, NUM_LEVELS> _occupied {};
+  std::vector<Item> _overflow;
+
+  uint64_t _now {0};
+  size_t _size {0};
+
+  void _place(Item&& item) {
+    auto delta = item.tick - _now;
+    for(size_t l=0; l<NUM_LEVELS; ++l) {
+      if(delta < (uint64_t{1} << (SLOT_BITS * (l + 1)))) {
+        auto s = (item.tick >> (SLOT_BITS * l)) & SLOT_MASK;
+        _slots[l][s].push_back(std::move(item));
+        _occupied[l] |= (uint64_t{1} << s);
+        return;
+      }
+    }
+    _overflow.push_back(std::move(item));
+  }
+
+  template <typename C>
+  void _remove_if(std::vector<Item>& items, C& pred) {
+    size_t n = 0;
+    for(size_t i=0; i<items.size(); ++i) {
+      if(!pred(items[i].value)) {
+        if(n != i) {
+          items[n] = std::move(items[i]);
+        }
+        ++n;
+      }
+    }
+    _size -= items.size() - n;
+    items.erase(items.begin() + n, items.end());
+  }
+
+  void _cascade(size_t l, uint64_t s) {
+    if(_occupied[l] & (uint64_t{1} << s)) {
+      auto items = std::move(_slots[l][s]);
+      _slots[l][s].clear();
+      _occupied[l] &= ~(uint64_t{1} << s);
+      for(auto& item : items) {
+        _place(std::move(item));
+      }
+    }
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------
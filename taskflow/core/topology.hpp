@@ -8,6 +8,25 @@ class TopologyBase {
 
 };
 
+#if __cplusplus >= TF_CPP20
+// class: FutureAwaiters
+// coroutines suspended on a tf::Future until the run or the async task 
+// behind the future carries out its promise
+class FutureAwaiters {
+
+  friend class Executor;
+
+  std::mutex _mutex;
+  std::vector<CoroPromiseBase*> _promises;
+  bool _awaitable {true};
+};
+
+/**
+@private
+*/
+using FutureAwaitersAllocator = SlabStdAllocator<FutureAwaiters, 16384>;
+#endif
+
 // class: Topology
 class Topology {
 
@@ -16,6 +35,9 @@ class Topology {
   friend class Runtime;
   friend class Node;
 
+  friend class RunHandle;
+  friend class CoroPromiseBase;
+
   template <typename T>
   friend class Future;
   
@@ -30,19 +52,53 @@ class Topology {
 
     Taskflow& _taskflow;
 
-    std::promise<void> _promise;
+    // only runs returning a tf::Future carry a promise
+    std::optional<std::promise<void>> _promise;
     
-    std::function<bool()> _pred;
-    std::function<void()> _call;
+    SmallFunction<bool()> _pred;
+    SmallFunction<void()> _call;
 
     std::atomic<size_t> _join_counter {0};
     std::atomic<ESTATE::underlying_type> _estate {ESTATE::NONE};
 
     std::exception_ptr _exception_ptr {nullptr};
 
+    // tasks of a concurrent run indexed like the compiled graph, which
+    // keep the join counters, states and exceptions of this run, and
+    // the reference that keeps this topology alive until the run finishes
+    std::unique_ptr<Node[]> _nodes;
+    std::shared_ptr<Topology> _self;
+
+    // number of chunks left to reset when workers set up a run together
+    std::atomic<size_t> _num_set_up_chunks {0};
+
+    // arena of the taskflow at the time of the submission
+    size_t _arena;
+
+    // completion flag for runs returning a tf::RunHandle
+#if __cplusplus >= TF_CPP20
+    std::atomic<bool> _done {false};
+#else
+    mutable std::condition_variable _done_cv;
+    mutable std::mutex _done_mutex;
+    bool _done {false};
+#endif
+
+#if __cplusplus >= TF_CPP20
+    // coroutines suspended on the tf::Future of this topology
+    FutureAwaiters _awaiters;
+#endif
+
     void _carry_out_promise();
+    void _wait() const;
+    bool _is_done() const;
 };
 
+/**
+@private
+*/
+using TopologyAllocator = SlabStdAllocator<Topology, 16384>;
+
 // Constructor
 template <typename P, typename C>
 Topology::Topology(Taskflow& tf, P&& p, C&& c):
@@ -51,18 +107,54 @@ Topology::Topology(Taskflow& tf, P&& p, C&& c):
   _call {std::forward<C>(c)} {
 }
 
-// Procedure
+// Procedure: _carry_out_promise
 inline void Topology::_carry_out_promise() {
+
+  // the exception stays in the topology for tf::RunHandle::get
+  if(!_promise) {
+#if __cplusplus >= TF_CPP20
+    _done.store(true, std::memory_order_release);
+    _done.notify_all();
+#else
+    {
+      std::lock_guard<std::mutex> lock(_done_mutex);
+      _done = true;
+    }
+    _done_cv.notify_all();
+#endif
+    return;
+  }
+
   if(_exception_ptr) {
     auto e = _exception_ptr;
     _exception_ptr = nullptr;
-    _promise.set_exception(e);
+    _promise->set_exception(e);
   }
   else {
-    _promise.set_value();
+    _promise->set_value();
   }
 }
 
+// Procedure: _wait
+inline void Topology::_wait() const {
+#if __cplusplus >= TF_CPP20
+  _done.wait(false, std::memory_order_acquire);
+#else
+  std::unique_lock<std::mutex> lock(_done_mutex);
+  _done_cv.wait(lock, [this](){ return _done; });
+#endif
+}
+
+// Function: _is_done
+inline bool Topology::_is_done() const {
+#if __cplusplus >= TF_CPP20
+  return _done.load(std::memory_order_acquire);
+#else
+  std::lock_guard<std::mutex> lock(_done_mutex);
+  return _done;
+#endif
+}
+
 // Function: cancelled
 inline bool Topology::cancelled() const {
   return _estate.load(std::memory_order_relaxed) & ESTATE::CANCELLED;
@@ -2,6 +2,7 @@
 
 #include "../utility/macros.hpp"
 #include "../utility/traits.hpp"
+#include "../utility/mpmc.hpp"
 
 /**
 @file tsq.hpp
@@ -28,12 +29,85 @@
   #define TF_DEFAULT_UNBOUNDED_TASK_QUEUE_LOG_SIZE 10
 #endif
 
+#ifndef TF_DEFAULT_INJECTION_QUEUE_LOG_SIZE 
+  /**
+  @def TF_DEFAULT_INJECTION_QUEUE_LOG_SIZE
+  
+  This macro defines the default size of the ring buffer of 
+  the injection queue in Log2.
+  Injection queue is used by the executor to hold tasks submitted
+  by non-worker threads and tasks that overflow the queue of a worker.
+  */
+  #define TF_DEFAULT_INJECTION_QUEUE_LOG_SIZE 10
+#endif
+
 namespace tf {
 
+// ----------------------------------------------------------------------------
+// Task Priority
+// ----------------------------------------------------------------------------
+
+/**
+@enum TaskPriority
+
+@brief enumeration of all task priority values
+
+A priority is an enumerated value of type @c unsigned.
+Currently, %Taskflow defines three priority levels, 
+@c HIGH, @c NORMAL, and @c LOW, starting from 0, 1, to 2.
+That is, the lower the value, the higher the priority.
+*/
+enum class TaskPriority : unsigned {
+  /** @brief value of the highest priority (i.e., 0) */
+  HIGH = 0,
+  /** @brief value of the normal priority (i.e., 1) */
+  NORMAL = 1,
+  /** @brief value of the lowest priority (i.e., 2) */
+  LOW = 2,
+  /** @brief conventional value for iterating priority values */
+  MAX = 3
+};
+
 // ----------------------------------------------------------------------------
 // Task Queue
 // ----------------------------------------------------------------------------
 
+namespace detail {
+
+/**
+@private
+
+steals one item from the source queue and moves up to half of the remaining
+items into the destination queue, as many as the destination can hold
+*/
+template <typename S, typename D>
+auto steal_batch(S& src, D& dst) {
+
+  auto item = src.steal();
+
+  if(item == nullptr) {
+    return item;
+  }
+
+  // only the calling thread can insert items to dst, so dst has at least
+  // the space it has now
+  size_t n = std::min(src.size() / 2, static_cast<size_t>(dst.capacity()) - dst.size());
+
+  for(size_t i=0; i<n; ++i) {
+    auto other = src.steal();
+    if(other == nullptr) {
+      break;
+    }
+    // cannot fail since n does not exceed the space of dst
+    [[maybe_unused]] bool pushed = dst.try_push(other);
+    assert(pushed);
+  }
+
+  return item;
+}
+
+}  // end of namespace detail -------------------------------------------------
+
 
 /**
 @class: UnboundedTaskQueue
@@ -82,8 +156,8 @@ class UnboundedTaskQueue {
       return S[i & M].load(std::memory_order_relaxed);
     }
 
-    Array* resize(int64_t b, int64_t t) {
-      Array* ptr = new Array {2*C};
+    Array* resize(int64_t b, int64_t t, int64_t c) {
+      Array* ptr = new Array {c};
       for(int64_t i=t; i!=b; ++i) {
         ptr->push(i, pop(i));
       }
@@ -138,6 +212,20 @@ class UnboundedTaskQueue {
   if more space is required.
   */
   void push(T item);
+  
+  /**
+  @brief inserts a range of items to the queue
+
+  @tparam I random-access iterator type
+  @param first iterator to the first item
+  @param N number of items to insert
+
+  Only the owner thread can insert items to the queue.
+  The operation resizes the queue at most once and publishes all items 
+  with a single update of the bottom index.
+  */
+  template <typename I>
+  void bulk_push(I first, size_t N);
 
   /**
   @brief pops out an item from the queue
@@ -168,9 +256,25 @@ class UnboundedTaskQueue {
   */
   T steal_with_hint(size_t& num_empty_steals);
 
+  /**
+  @brief steals up to half of the items from the queue into another queue
+
+  @tparam Q type of the destination queue (tf::BoundedTaskQueue)
+  @param dst destination queue owned by the calling thread
+  @return one of the stolen items, or @c nullptr if this operation failed
+
+  Any threads can try to steal items from the queue.
+  The operation returns the first stolen item and moves up to half of the 
+  remaining items into @c dst, as many as @c dst can hold.
+  Each item is claimed with the same compare-and-swap as a single steal, 
+  since the owner can pop the bottom item without synchronization.
+  */
+  template <typename Q>
+  T steal_batch(Q& dst);
+
   private:
 
-  Array* resize_array(Array* a, int64_t b, int64_t t);
+  Array* resize_array(Array* a, int64_t b, int64_t t, int64_t c);
 };
 
 // Constructor
@@ -217,7 +321,7 @@ void UnboundedTaskQueue<T>::push(T o) {
 
   // queue is full with one additional item (b-t+1)
   if TF_UNLIKELY(a->capacity() - 1 < (b - t)) {
-    a = resize_array(a, b, t);
+    a = resize_array(a, b, t, 2*a->capacity());
   }
 
   a->push(b, o);
@@ -227,6 +331,38 @@ void UnboundedTaskQueue<T>::push(T o) {
   _bottom.store(b + 1, std::memory_order_release);
 }
 
+// Function: bulk_push
+template <typename T>
+template <typename I>
+void UnboundedTaskQueue<T>::bulk_push(I first, size_t N) {
+
+  if(N == 0) {
+    return;
+  }
+
+  int64_t n = static_cast<int64_t>(N);
+  int64_t b = _bottom.load(std::memory_order_relaxed);
+  int64_t t = _top.load(std::memory_order_acquire);
+  Array* a = _array.load(std::memory_order_relaxed);
+
+  // queue is full with n additional items (b-t+n)
+  if TF_UNLIKELY(a->capacity() < (b - t) + n) {
+    int64_t c = 2*a->capacity();
+    while(c < (b - t) + n) {
+      c *= 2;
+    }
+    a = resize_array(a, b, t, c);
+  }
+
+  for(int64_t i=0; i<n; ++i) {
+    a->push(b + i, first[static_cast<size_t>(i)]);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // original paper uses relaxed here but tsa complains
+  _bottom.store(b + n, std::memory_order_release);
+}
+
 // Function: pop
 template <typename T>
 T UnboundedTaskQueue<T>::pop() {
@@ -307,6 +443,14 @@ T UnboundedTaskQueue<T>::steal_with_hint(size_t& num_empty_steals) {
   return item;
 }
 
+// Function: steal_batch
+template <typename T>
+template <typename Q>
+T UnboundedTaskQueue<T>::steal_batch(Q& dst) {
+
+  return detail::steal_batch(*this, dst);
+}
+
 // Function: capacity
 template <typename T>
 int64_t UnboundedTaskQueue<T>::capacity() const noexcept {
@@ -315,7 +459,7 @@ int64_t UnboundedTaskQueue<T>::capacity() const noexcept {
 
 template <typename T>
 typename UnboundedTaskQueue<T>::Array*
-UnboundedTaskQueue<T>::resize_array(Array* a, int64_t b, int64_t t) {
+UnboundedTaskQueue<T>::resize_array(Array* a, int64_t b, int64_t t, int64_t c) {
 
   //Array* tmp = a->resize(b, t);
   //_garbage.push_back(a);
@@ -326,7 +470,7 @@ UnboundedTaskQueue<T>::resize_array(Array* a, int64_t b, int64_t t) {
   //return a;
   
 
-  Array* tmp = a->resize(b, t);
+  Array* tmp = a->resize(b, t, c);
   _garbage.push_back(a);
   _array.store(tmp, std::memory_order_release);
   // Note: the original paper using relaxed causes t-san to complain
@@ -421,6 +565,25 @@ class BoundedTaskQueue {
   template <typename O, typename C>
   void push(O&& item, C&& on_full);
   
+  /**
+  @brief inserts a range of items to the queue or invokes the callable on 
+         the items that do not fit
+
+  @tparam I random-access iterator type
+  @tparam C callable type
+  @param first iterator to the first item
+  @param N number of items to insert
+  @param on_full callable to invoke with the iterator to the first item that
+                 does not fit and the number of such items
+
+  Only the owner thread can insert items to the queue.
+  All items that fit into the queue are published with a single update
+  of the bottom index.
+  The callable is invoked only if the queue cannot hold all @c N items.
+  */
+  template <typename I, typename C>
+  void bulk_push(I first, size_t N, C&& on_full);
+  
   /**
   @brief pops out an item from the queue
 
@@ -448,6 +611,22 @@ class BoundedTaskQueue {
   otherwise, `num_empty_steals` is reset to zero.
   */
   T steal_with_hint(size_t& num_empty_steals);
+
+  /**
+  @brief steals up to half of the items from the queue into another queue
+
+  @tparam Q type of the destination queue (tf::BoundedTaskQueue)
+  @param dst destination queue owned by the calling thread
+  @return one of the stolen items, or @c nullptr if this operation failed
+
+  Any threads can try to steal items from the queue.
+  The operation returns the first stolen item and moves up to half of the 
+  remaining items into @c dst, as many as @c dst can hold.
+  Each item is claimed with the same compare-and-swap as a single steal, 
+  since the owner can pop the bottom item without synchronization.
+  */
+  template <typename Q>
+  T steal_batch(Q& dst);
 };
 
 // Function: empty
@@ -511,6 +690,37 @@ void BoundedTaskQueue<T, LogSize>::push(O&& o, C&& on_full) {
   _bottom.store(b + 1, std::memory_order_release);
 }
 
+// Function: bulk_push
+template <typename T, size_t LogSize>
+template <typename I, typename C>
+void BoundedTaskQueue<T, LogSize>::bulk_push(I first, size_t N, C&& on_full) {
+
+  int64_t b = _bottom.load(std::memory_order_relaxed);
+  int64_t t = _top.load(std::memory_order_acquire);
+
+  // number of items that fit into the queue
+  int64_t n = std::min(static_cast<int64_t>(N), BufferSize - (b - t));
+  
+  if(n > 0) {
+    for(int64_t i=0; i<n; ++i) {
+      _buffer[(b + i) & BufferMask].store(first[static_cast<size_t>(i)], std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    // original paper uses relaxed here but tsa complains
+    _bottom.store(b + n, std::memory_order_release);
+  }
+  else {
+    n = 0;
+  }
+
+  // the remaining items are not yet visible to other threads 
+  if TF_UNLIKELY(static_cast<size_t>(n) < N) {
+    on_full(first + static_cast<size_t>(n), N - static_cast<size_t>(n));
+  }
+}
+
 // Function: pop
 template <typename T, size_t LogSize>
 T BoundedTaskQueue<T, LogSize>::pop() {
@@ -586,6 +796,14 @@ T BoundedTaskQueue<T, LogSize>::steal_with_hint(size_t& num_empty_steals) {
   return item;
 }
 
+// Function: steal_batch
+template <typename T, size_t LogSize>
+template <typename Q>
+T BoundedTaskQueue<T, LogSize>::steal_batch(Q& dst) {
+
+  return detail::steal_batch(*this, dst);
+}
+
 // Function: capacity
 template <typename T, size_t LogSize>
 constexpr size_t BoundedTaskQueue<T, LogSize>::capacity() const {
@@ -594,6 +812,379 @@ constexpr size_t BoundedTaskQueue<T, LogSize>::capacity() const {
 
 
 
+// ----------------------------------------------------------------------------
+// InjectionQueue
+// ----------------------------------------------------------------------------
+
+/**
+@class: InjectionQueue
+
+@tparam T data type (must be a pointer type)
+@tparam LogSize the base-2 logarithm of the ring buffer size
+
+@brief class to create an unbounded multi-producer multi-consumer task queue
+
+Unlike a work-stealing queue, an injection queue has no owner:
+any thread can insert items into the queue and steal items from the queue
+concurrently.
+Items go to a lock-free bounded ring buffer (tf::MPMC), so concurrent 
+producers and consumers synchronize only on the indices of the ring.
+Only when the ring is full do the remaining items spill into 
+an unbounded work-stealing queue, where producers take turns 
+through a mutex and consumers steal without locking.
+*/
+template <typename T, size_t LogSize = TF_DEFAULT_INJECTION_QUEUE_LOG_SIZE>
+class InjectionQueue {
+
+  static_assert(std::is_pointer_v<T>, "T must be a pointer type");
+
+  public:
+
+  /**
+  @brief queries if the queue is empty at the time of this call
+  */
+  bool empty() const noexcept;
+
+  /**
+  @brief queries the number of items at the time of this call
+  */
+  size_t size() const noexcept;
+
+  /**
+  @brief queries the capacity of the queue before items spill
+  */
+  size_t capacity() const noexcept;
+
+  /**
+  @brief inserts an item to the queue
+
+  Any threads can insert items to the queue.
+  */
+  void push(T item);
+
+  /**
+  @brief inserts a range of items to the queue
+
+  @tparam I random-access iterator type
+  @param first iterator to the first item
+  @param N number of items to insert
+
+  Any threads can insert items to the queue.
+  The items that fit into the ring are claimed with a single
+  compare-and-swap.
+  */
+  template <typename I>
+  void bulk_push(I first, size_t N);
+
+  /**
+  @brief pops out an item from the queue
+
+  Since the queue has no owner, this is the same as tf::InjectionQueue::steal.
+  */
+  T pop();
+
+  /**
+  @brief steals an item from the queue
+
+  Any threads can try to steal an item from the queue.
+  The return can be a @c nullptr if this operation failed (not necessary empty).
+  */
+  T steal();
+
+  /**
+  @brief attempts to steal a task with a hint mechanism
+  
+  @param num_empty_steals a reference to a counter tracking consecutive empty steal attempts
+  
+  The counter is reset to zero if the queue is non-empty, 
+  or incremented if the queue is empty.
+  */
+  T steal_with_hint(size_t& num_empty_steals);
+
+  /**
+  @brief steals up to half of the items from the queue into another queue
+
+  @tparam Q type of the destination queue (tf::BoundedTaskQueue)
+  @param dst destination queue owned by the calling thread
+  @return one of the stolen items, or @c nullptr if this operation failed
+  */
+  template <typename Q>
+  T steal_batch(Q& dst);
+
+  private:
+
+  MPMC<T, LogSize> _ring;
+
+  std::mutex _mutex;
+  UnboundedTaskQueue<T> _spill;
+};
+
+// Function: empty
+template <typename T, size_t LogSize>
+bool InjectionQueue<T, LogSize>::empty() const noexcept {
+  return _ring.empty() && _spill.empty();
+}
+
+// Function: size
+template <typename T, size_t LogSize>
+size_t InjectionQueue<T, LogSize>::size() const noexcept {
+  return _ring.size() + _spill.size();
+}
+
+// Function: capacity
+template <typename T, size_t LogSize>
+size_t InjectionQueue<T, LogSize>::capacity() const noexcept {
+  return _ring.capacity();
+}
+
+// Procedure: push
+template <typename T, size_t LogSize>
+void InjectionQueue<T, LogSize>::push(T item) {
+  if TF_UNLIKELY(!_ring.try_enqueue(item)) {
+    std::scoped_lock lock(_mutex);
+    _spill.push(item);
+  }
+}
+
+// Procedure: bulk_push
+template <typename T, size_t LogSize>
+template <typename I>
+void InjectionQueue<T, LogSize>::bulk_push(I first, size_t N) {
+  
+  size_t n = 0;
+
+  // the ring may free up slots between two attempts
+  while(n < N) {
+    auto m = _ring.try_bulk_enqueue(first + n, N - n);
+    if(m == 0) {
+      break;
+    }
+    n += m;
+  }
+
+  if TF_UNLIKELY(n < N) {
+    std::scoped_lock lock(_mutex);
+    _spill.bulk_push(first + n, N - n);
+  }
+}
+
+// Function: pop
+template <typename T, size_t LogSize>
+T InjectionQueue<T, LogSize>::pop() {
+  return steal();
+}
+
+// Function: steal
+template <typename T, size_t LogSize>
+T InjectionQueue<T, LogSize>::steal() {
+  if(auto item = _ring.try_dequeue(); item) {
+    return item;
+  }
+  return _spill.steal();
+}
+
+// Function: steal_with_hint
+template <typename T, size_t LogSize>
+T InjectionQueue<T, LogSize>::steal_with_hint(size_t& num_empty_steals) {
+  if(empty()) {
+    ++num_empty_steals;
+    return nullptr;
+  }
+  num_empty_steals = 0;
+  return steal();
+}
+
+// Function: steal_batch
+template <typename T, size_t LogSize>
+template <typename Q>
+T InjectionQueue<T, LogSize>::steal_batch(Q& dst) {
+
+  return detail::steal_batch(*this, dst);
+}
+
+// ----------------------------------------------------------------------------
+// MultiLevelTaskQueue
+// ----------------------------------------------------------------------------
+
+/**
+@class: MultiLevelTaskQueue
+
+@tparam Q work-stealing queue type of each level
+@tparam L number of levels
+
+@brief class to create a multi-level work-stealing queue
+
+A multi-level queue keeps one work-stealing queue per priority level.
+Items are inserted into the level of their priority through 
+tf::MultiLevelTaskQueue::level, whereas pop and steal operations always
+drain a lower-numbered (i.e., higher-priority) level before moving to the next one.
+
+Only the queue owner can perform pop and push operations,
+while others can steal data from the queue simultaneously.
+*/
+template <typename Q, size_t L = static_cast<size_t>(TaskPriority::MAX)>
+class MultiLevelTaskQueue {
+
+  static_assert(L > 0, "L must be at least one level");
+
+  public:
+
+  /**
+  @brief item type of the queue
+  */
+  using value_type = decltype(std::declval<Q&>().pop());
+
+  /**
+  @brief queries the number of levels
+  */
+  constexpr size_t num_levels() const noexcept { return L; }
+
+  /**
+  @brief acquires the queue of the given level
+  */
+  Q& level(size_t p) noexcept { return _levels[p]; }
+  
+  /**
+  @brief acquires the queue of the given level
+  */
+  const Q& level(size_t p) const noexcept { return _levels[p]; }
+  
+  /**
+  @brief queries if all levels are empty at the time of this call
+  */
+  bool empty() const noexcept;
+  
+  /**
+  @brief queries the number of items over all levels at the time of this call
+  */
+  size_t size() const noexcept;
+  
+  /**
+  @brief queries the capacity over all levels
+  */
+  size_t capacity() const noexcept;
+  
+  /**
+  @brief pops out an item from the highest-priority non-empty level
+
+  Only the owner thread can pop out an item from the queue. 
+  The return can be a `nullptr` if this operation failed (empty queue).
+  */
+  value_type pop();
+  
+  /**
+  @brief steals an item from the highest-priority non-empty level
+
+  Any threads can try to steal an item from the queue.
+  The return can be a `nullptr` if this operation failed (not necessary empty).
+  */
+  value_type steal();
+  
+  /**
+  @brief attempts to steal a task with a hint mechanism
+  
+  @param num_empty_steals a reference to a counter tracking consecutive empty steal attempts
+  
+  The counter is reset to zero if any level is non-empty, 
+  or incremented if all levels are empty.
+  */
+  value_type steal_with_hint(size_t& num_empty_steals);
+  
+  /**
+  @brief steals up to half of the items of the highest-priority non-empty level
+         into the same level of another queue
+
+  @tparam D type of the destination multi-level queue
+  @param dst destination queue owned by the calling thread
+  @return one of the stolen items, or @c nullptr if this operation failed
+  */
+  template <typename D>
+  value_type steal_batch(D& dst);
+
+  private:
+
+  std::array<Q, L> _levels;
+};
+
+// Function: empty
+template <typename Q, size_t L>
+bool MultiLevelTaskQueue<Q, L>::empty() const noexcept {
+  for(size_t p=0; p<L; ++p) {
+    if(!_levels[p].empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Function: size
+template <typename Q, size_t L>
+size_t MultiLevelTaskQueue<Q, L>::size() const noexcept {
+  size_t s = 0;
+  for(size_t p=0; p<L; ++p) {
+    s += _levels[p].size();
+  }
+  return s;
+}
+
+// Function: capacity
+template <typename Q, size_t L>
+size_t MultiLevelTaskQueue<Q, L>::capacity() const noexcept {
+  size_t c = 0;
+  for(size_t p=0; p<L; ++p) {
+    c += static_cast<size_t>(_levels[p].capacity());
+  }
+  return c;
+}
+
+// Function: pop
+template <typename Q, size_t L>
+typename MultiLevelTaskQueue<Q, L>::value_type MultiLevelTaskQueue<Q, L>::pop() {
+  for(size_t p=0; p<L; ++p) {
+    if(auto item = _levels[p].pop(); item) {
+      return item;
+    }
+  }
+  return nullptr;
+}
+
+// Function: steal
+template <typename Q, size_t L>
+typename MultiLevelTaskQueue<Q, L>::value_type MultiLevelTaskQueue<Q, L>::steal() {
+  for(size_t p=0; p<L; ++p) {
+    if(auto item = _levels[p].steal(); item) {
+      return item;
+    }
+  }
+  return nullptr;
+}
+
+// Function: steal_with_hint
+template <typename Q, size_t L>
+typename MultiLevelTaskQueue<Q, L>::value_type 
+MultiLevelTaskQueue<Q, L>::steal_with_hint(size_t& num_empty_steals) {
+  for(size_t p=0; p<L; ++p) {
+    if(!_levels[p].empty()) {
+      num_empty_steals = 0;
+      return _levels[p].steal();
+    }
+  }
+  ++num_empty_steals;
+  return nullptr;
+}
+
+// Function: steal_batch
+template <typename Q, size_t L>
+template <typename D>
+typename MultiLevelTaskQueue<Q, L>::value_type MultiLevelTaskQueue<Q, L>::steal_batch(D& dst) {
+  for(size_t p=0; p<L; ++p) {
+    if(auto item = _levels[p].steal_batch(dst.level(p)); item) {
+      return item;
+    }
+  }
+  return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 
 //template <typename T>
@@ -4,6 +4,7 @@
 #include "tsq.hpp"
 #include "atomic_notifier.hpp"
 #include "nonblocking_notifier.hpp"
+#include "metrics.hpp"
 
 
 /**
@@ -54,6 +55,10 @@ class Worker {
   friend class Executor;
   friend class Runtime;
   friend class WorkerView;
+  friend class AsyncTask;
+  
+  template <typename T>
+  friend class Future;
 
   public:
 
@@ -66,6 +71,13 @@ class Worker {
     */
     inline size_t id() const { return _id; }
 
+    /**
+    @brief queries the id of the arena the worker belongs to
+
+    A worker of an executor constructed without arenas belongs to arena @c 0.
+    */
+    inline size_t arena() const { return _arena; }
+
     /**
     @brief queries the size of the queue (i.e., number of enqueued tasks to
            run) associated with the worker
@@ -97,6 +109,7 @@ class Worker {
 
     size_t _id;
     size_t _vtm;
+    size_t _arena {0};
     Executor* _executor {nullptr};
     DefaultNotifier::Waiter* _waiter;
     std::thread _thread;
@@ -104,7 +117,27 @@ class Worker {
     std::default_random_engine _rdgen;
     //std::uniform_int_distribution<size_t> _udist;
 
-    BoundedTaskQueue<Node*> _wsq;
+    // victim queues sorted by their distance to this worker, where
+    // _victim_tiers[0] and _victim_tiers[1] mark the ends of the 
+    // L3-local and the NUMA-local tiers, and _victim_tiers[2] marks the
+    // end of the queues of its arena, after which the queues of other 
+    // arenas follow if the arena steals from them
+    std::vector<size_t> _victims;
+    std::array<size_t, 3> _victim_tiers;
+
+    MultiLevelTaskQueue<BoundedTaskQueue<Node*>> _wsq;
+
+    // tasks delivered to this worker by their affinity, the steady-clock 
+    // time in nanoseconds since which the mailbox is non-empty (0 if empty),
+    // the time stamp for which a timer has been armed to wake up a worker 
+    // once the mailbox passes the threshold,
+    // and whether the worker is about to sleep or sleeping
+    InjectionQueue<Node*, 8> _mailbox;
+    std::atomic<int64_t> _mailbox_since {0};
+    std::atomic<int64_t> _mailbox_alarm {0};
+    std::atomic<bool> _sleeping {false};
+
+    MetricsCounter _metrics;
 
     //TF_FORCE_INLINE size_t _rdvtm() {
     //  auto r = _udist(_rdgen);
@@ -4,11 +4,15 @@
 // 
 // Disabled features by default:
 // + TF_ENABLE_TASK_POOL       : enable task pool optimization
+// + TF_ENABLE_TASK_SLAB       : enable per-thread slab allocation of tasks
+// + TF_ENABLE_SCHEDULER_METRICS : enable scheduler metrics (Executor::metrics)
+// + TF_ENABLE_BATCH_STEALING  : enable stealing up to half of a victim's tasks at once
 // + TF_ENABLE_ATOMIC_NOTIFIER : enable atomic notifier (required C++20)
 //
 
 #include "core/executor.hpp"
 #include "core/runtime.hpp"
+#include "core/coroutine.hpp"
 #include "core/async.hpp"
 #include "algorithm/algorithm.hpp"
 
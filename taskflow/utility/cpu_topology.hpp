@@ -0,0 +1,251 @@
+#pragma once
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+@file cpu_topology.hpp
+@brief cpu topology include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: CPUTopology
+// ----------------------------------------------------------------------------
+
+/**
+@class CPUTopology
+
+@brief class to describe the cache and NUMA domains of logical CPUs
+
+A CPU topology records, for each logical CPU, the identifier of the
+last-level (L3) cache domain and the identifier of the NUMA node it
+belongs to.
+The executor uses this information to build a hierarchical victim list
+for each worker such that a thief first steals from workers sharing
+the same L3 cache, then from workers on the same NUMA node,
+and finally from remote workers.
+Worker @c i is associated with the logical CPU at index
+<tt>i % num_cpus()</tt> of the topology.
+
+By default, an executor reads the topology of the running machine from
+Linux sysfs using tf::CPUTopology::from_sysfs.
+You can inject a different topology, for instance,
+to emulate a multi-socket machine on a single-socket box:
+
+@code{.cpp}
+// two NUMA nodes, each having two L3 domains of two CPUs
+tf::CPUTopology topology({
+  {0, 0}, {0, 0}, {1, 0}, {1, 0},
+  {2, 1}, {2, 1}, {3, 1}, {3, 1}
+});
+tf::Executor executor(8, topology);
+@endcode
+
+An empty topology places all workers in the same domain, which falls back
+to uniformly random victim selection.
+*/
+class CPUTopology {
+
+  public:
+
+  /**
+  @brief struct to describe the domains of a logical CPU
+  */
+  struct CPU {
+    /**
+    @brief identifier of the L3 cache domain
+    */
+    size_t l3 {0};
+    /**
+    @brief identifier of the NUMA node
+    */
+    size_t numa {0};
+  };
+
+  /**
+  @brief constructs an empty topology
+  */
+  CPUTopology() = default;
+
+  /**
+  @brief constructs a topology from the given per-CPU domains
+  */
+  explicit CPUTopology(std::vector<CPU> cpus) : _cpus {std::move(cpus)} {}
+
+  /**
+  @brief reads the topology from a Linux sysfs tree
+
+  @param root root of the sysfs system devices (default @c /sys/devices/system)
+
+  The function reads the list of present CPUs from <tt>root/cpu/present</tt>.
+  For each CPU @c N, the L3 domain is identified by the first CPU
+  listed in the @c shared_cpu_list of the level-3 cache under
+  <tt>root/cpu/cpuN/cache</tt>, and the NUMA node is the node @c M whose
+  <tt>root/node/nodeM/cpulist</tt> contains @c N.
+  Missing entries fall back to the physical package of the CPU.
+  If @c root cannot be read (e.g., on a non-Linux system),
+  the function returns an empty topology.
+  */
+  static CPUTopology from_sysfs(const std::string& root = "/sys/devices/system");
+
+  /**
+  @brief queries the topology of the running machine
+
+  The function calls tf::CPUTopology::from_sysfs once and caches the
+  result for subsequent calls.
+  */
+  static const CPUTopology& system();
+
+  /**
+  @brief queries the number of logical CPUs in the topology
+  */
+  size_t num_cpus() const { return _cpus.size(); }
+
+  /**
+  @brief queries if the topology is empty
+  */
+  bool empty() const { return _cpus.empty(); }
+
+  /**
+  @brief accesses the domains of the given CPU
+  */
+  const CPU& operator [] (size_t cpu) const { return _cpus[cpu]; }
+
+  /**
+  @brief queries the distance between two CPUs
+
+  @return @c 0 if both CPUs share the same L3 domain,
+          @c 1 if both CPUs reside in the same NUMA node,
+          or @c 2 otherwise
+  */
+  size_t distance(size_t a, size_t b) const;
+
+  private:
+
+  std::vector<CPU> _cpus;
+
+  static std::vector<size_t> _parse_cpu_list(const std::string&);
+  static bool _read_line(const std::string&, std::string&);
+};
+
+// Function: distance
+inline size_t CPUTopology::distance(size_t a, size_t b) const {
+  if(_cpus.empty()) {
+    return 0;
+  }
+  auto& x = _cpus[a % _cpus.size()];
+  auto& y = _cpus[b % _cpus.size()];
+  return (x.numa != y.numa) ? 2 : (x.l3 != y.l3) ? 1 : 0;
+}
+
+// Function: system
+inline const CPUTopology& CPUTopology::system() {
+  static const CPUTopology topology = from_sysfs();
+  return topology;
+}
+
+// Function: _read_line
+inline bool CPUTopology::_read_line(const std::string& path, std::string& line) {
+  std::ifstream ifs(path);
+  return static_cast<bool>(std::getline(ifs, line));
+}
+
+// Function: _parse_cpu_list
+// parses a cpu list such as "0-3,8,10-11" into {0, 1, 2, 3, 8, 10, 11}
+inline std::vector<size_t> CPUTopology::_parse_cpu_list(const std::string& str) {
+  std::vector<size_t> cpus;
+  size_t i = 0;
+  while(i < str.size()) {
+    if(str[i] < '0' || str[i] > '9') {
+      ++i;
+      continue;
+    }
+    size_t beg = 0;
+    while(i < str.size() && str[i] >= '0' && str[i] <= '9') {
+      beg = beg*10 + static_cast<size_t>(str[i++] - '0');
+    }
+    size_t end = beg;
+    if(i < str.size() && str[i] == '-') {
+      end = 0;
+      while(++i < str.size() && str[i] >= '0' && str[i] <= '9') {
+        end = end*10 + static_cast<size_t>(str[i] - '0');
+      }
+    }
+    for(size_t c=beg; c<=end; ++c) {
+      cpus.push_back(c);
+    }
+  }
+  return cpus;
+}
+
+// Function: from_sysfs
+inline CPUTopology CPUTopology::from_sysfs(const std::string& root) {
+
+  std::string line;
+
+  if(!_read_line(root + "/cpu/present", line)) {
+    return CPUTopology();
+  }
+
+  auto present = _parse_cpu_list(line);
+
+  if(present.empty()) {
+    return CPUTopology();
+  }
+
+  std::vector<CPU> cpus(present.back() + 1);
+
+  for(auto c : present) {
+
+    auto dir = root + "/cpu/cpu" + std::to_string(c);
+
+    // physical package serves as the fallback domain for both levels
+    size_t package = 0;
+    if(_read_line(dir + "/topology/physical_package_id", line)) {
+      if(auto id = _parse_cpu_list(line); !id.empty()) {
+        package = id.front();
+      }
+    }
+    cpus[c].l3 = package;
+    cpus[c].numa = package;
+
+    // the first cpu sharing the L3 cache identifies the domain
+    for(size_t k=0; _read_line(dir + "/cache/index" + std::to_string(k) + "/level", line); ++k) {
+      if(line == "3" && _read_line(dir + "/cache/index" + std::to_string(k) + "/shared_cpu_list", line)) {
+        if(auto shared = _parse_cpu_list(line); !shared.empty()) {
+          cpus[c].l3 = shared.front();
+        }
+        break;
+      }
+    }
+  }
+
+  // NUMA nodes, if any, override the package-based fallback
+  if(_read_line(root + "/node/possible", line)) {
+    for(auto n : _parse_cpu_list(line)) {
+      if(_read_line(root + "/node/node" + std::to_string(n) + "/cpulist", line)) {
+        for(auto c : _parse_cpu_list(line)) {
+          if(c < cpus.size()) {
+            cpus[c].numa = n;
+          }
+        }
+      }
+    }
+  }
+
+  // keep only the present CPUs such that worker i maps to the i-th one
+  std::vector<CPU> res;
+  res.reserve(present.size());
+  for(auto c : present) {
+    res.push_back(cpus[c]);
+  }
+
+  return CPUTopology(std::move(res));
+}
+
+}  // end of namespace tf -----------------------------------------------------
@@ -236,6 +236,51 @@ public:
     cell->sequence.store(pos + 1, std::memory_order_release);
   }
 
+  /**
+   * Enqueues up to N items of a range into the queue
+   *
+   * The items take consecutive slots claimed with a single
+   * compare-and-swap, as many as the queue has free slots.
+   *
+   * @param first random-access iterator to the first item
+   * @param N number of items
+   * @return number of items enqueued from the front of the range
+   */
+  template <typename I>
+  size_t try_bulk_enqueue(I first, size_t N) {
+    auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+    size_t n;
+    for (; ;) {
+      // only the producer that claims a free slot can fill it, so the slots
+      // that are free now remain free until the claim below
+      for (n = 0; n < N; ++n) {
+        auto seq = _buffer[(pos + n) & BufferMask].sequence.load(std::memory_order_acquire);
+        if (seq != pos + n) {
+          break;
+        }
+      }
+      if (n == 0) {
+        auto seq = _buffer[pos & BufferMask].sequence.load(std::memory_order_acquire);
+        if (seq < pos) {
+          return 0;
+        }
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+      else if (_enqueue_pos.compare_exchange_weak(pos, pos + n,
+                                                  std::memory_order_relaxed)) {
+        break;
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      auto& cell = _buffer[(pos + i) & BufferMask];
+      cell.data = first[i];
+      cell.sequence.store(pos + i + 1, std::memory_order_release);
+    }
+
+    return n;
+  }
+
   /**
    * Dequeues an item from the queue
    *
@@ -273,6 +318,12 @@ public:
     return beg >= end;
   }
 
+  size_t size() const {
+    auto beg = _dequeue_pos.load(std::memory_order_relaxed);
+    auto end = _enqueue_pos.load(std::memory_order_relaxed);
+    return beg >= end ? 0 : static_cast<size_t>(end - beg);
+  }
+
   size_t capacity() const {
     return BufferSize;
   }
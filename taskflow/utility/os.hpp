@@ -4,6 +4,7 @@
 #include <cstdio>
 #include <string>
 #include <thread>
+#include <vector>
 
 #define TF_OS_LINUX 0
 #define TF_OS_DRAGONFLY 0
@@ -90,6 +91,11 @@
 #define TF_OS_UNIX 1
 #endif
 
+#if TF_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 
 //-----------------------------------------------------------------------------
 // Cache line alignment
@@ -287,6 +293,77 @@ void spin_until(P&& predicate) {
   }
 }
 
+/**
+@brief queries the logical CPUs the calling process may run on
+
+On Linux, the function returns the CPUs in the affinity mask of the
+calling thread given by @c sched_getaffinity, which reflects the cpuset
+of a container or of @c taskset, in increasing order.
+On other systems, or if the mask cannot be read, the function returns
+the CPUs <tt>[0, std::thread::hardware_concurrency())</tt>.
+The result contains at least one CPU.
+*/
+inline std::vector<size_t> available_cpus() {
+
+  std::vector<size_t> cpus;
+
+#if TF_OS_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for(size_t c=0; c<CPU_SETSIZE; ++c) {
+      if(CPU_ISSET(c, &set)) {
+        cpus.push_back(c);
+      }
+    }
+  }
+#endif
+
+  if(cpus.empty()) {
+    size_t n = std::thread::hardware_concurrency();
+    for(size_t c=0; c<(n ? n : 1); ++c) {
+      cpus.push_back(c);
+    }
+  }
+
+  return cpus;
+}
+
+/**
+@brief queries the number of logical CPUs the calling process may run on
+
+The function returns the size of tf::available_cpus, which is the default
+number of workers of an executor.
+Unlike std::thread::hardware_concurrency, the number respects the cpuset
+of a container with restricted CPUs.
+*/
+inline size_t available_concurrency() {
+  return available_cpus().size();
+}
+
+/**
+@brief pins the calling thread to the given logical CPU
+
+@return @c true if the thread is pinned or @c false if the system 
+        does not support pinning or rejects the CPU
+
+Pinning is supported on Linux through @c pthread_setaffinity_np.
+*/
+inline bool pin_this_thread(size_t cpu) {
+#if TF_OS_LINUX
+  if(cpu >= CPU_SETSIZE) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
 
 
 }  // end of namespace tf -----------------------------------------------------
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "os.hpp"
+
+namespace tf {
+
+// Class: SlabAllocator
+//
+// The class implements a thread-caching slab allocator for objects of type T.
+// Each thread owns a heap of fixed-size slots carved out of slabs of
+// roughly S bytes:
+//
+// + Allocation pops a slot from the thread-local free list without
+//   any synchronization. When the free list is empty, the thread grabs
+//   all slots returned by other threads from its remote-free list using
+//   one atomic exchange, and only allocates a new slab if both lists are empty.
+// + Deallocation pushes the slot back to the free list if the calling thread
+//   owns the slot, or to the lock-free remote-free list (Treiber stack)
+//   of the owning heap otherwise. Since only the owner pops the remote-free
+//   list, and it always pops the entire list, the stack does not suffer
+//   from the ABA problem.
+//
+// Heaps are shared by all instances of SlabAllocator<T, S>. When a thread
+// exits, its heap is orphaned and later adopted by a new thread, such that
+// applications that repeatedly create and destroy threads (e.g., executors)
+// do not grow the number of heaps without bound. Slabs are never returned
+// to the system, and the heaps outlive static destruction, such that objects
+// recycled by destructors of static objects still find their heaps.
+// A thread whose heap has been orphaned recycles every slot through
+// the remote-free path, since the heap may already belong to another thread.
+template <typename T, size_t S = 65536>
+class SlabAllocator {
+
+  struct Heap;
+
+  struct Slot {
+    Heap* heap;
+    union {
+      Slot* next;
+      alignas(T) unsigned char data[sizeof(T)];
+    };
+  };
+
+  // number of slots per slab
+  constexpr static size_t M = (S / sizeof(Slot)) ? (S / sizeof(Slot)) : 1;
+
+  struct Heap {
+    Slot* free {nullptr};
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    alignas(2*TF_CACHELINE_SIZE) std::atomic<Slot*> remote {nullptr};
+  };
+
+  struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Heap>> heaps;
+    std::vector<Heap*> orphans;
+  };
+
+  struct Holder {
+    Heap* heap;
+    Holder();
+    ~Holder();
+  };
+
+  public:
+
+    /**
+    @brief allocates a slot and constructs an object in it
+    */
+    template <typename... ArgsT>
+    T* animate(ArgsT&&... args);
+
+    /**
+    @brief destroys the object pointed by @c ptr and recycles its slot
+    */
+    void recycle(T* ptr);
+
+    /**
+    @brief queries the number of slots per slab
+    */
+    constexpr static size_t num_slots_per_slab() { return M; }
+
+  private:
+
+    // heap of the calling thread, which is null before the first allocation
+    // of the thread and after the thread has orphaned its heap
+    inline static thread_local Heap* _heap {nullptr};
+
+    static Registry& _registry();
+    static Heap& _this_heap();
+    static Slot* _slot_of(T*);
+    static Slot* _refill(Heap&);
+};
+
+// Constructor
+template <typename T, size_t S>
+SlabAllocator<T, S>::Holder::Holder() {
+  auto& r = _registry();
+  std::scoped_lock lock(r.mutex);
+  if(r.orphans.empty()) {
+    heap = r.heaps.emplace_back(std::make_unique<Heap>()).get();
+  }
+  else {
+    heap = r.orphans.back();
+    r.orphans.pop_back();
+  }
+  _heap = heap;
+}
+
+// Destructor
+template <typename T, size_t S>
+SlabAllocator<T, S>::Holder::~Holder() {
+  _heap = nullptr;
+  auto& r = _registry();
+  std::scoped_lock lock(r.mutex);
+  r.orphans.push_back(heap);
+}
+
+// Function: _registry
+template <typename T, size_t S>
+typename SlabAllocator<T, S>::Registry& SlabAllocator<T, S>::_registry() {
+  // intentionally leaked - see the class description
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+// Function: _this_heap
+template <typename T, size_t S>
+typename SlabAllocator<T, S>::Heap& SlabAllocator<T, S>::_this_heap() {
+  if(_heap == nullptr) {
+    thread_local Holder holder;
+  }
+  return *_heap;
+}
+
+// Function: _slot_of
+template <typename T, size_t S>
+typename SlabAllocator<T, S>::Slot* SlabAllocator<T, S>::_slot_of(T* ptr) {
+  return reinterpret_cast<Slot*>(
+    reinterpret_cast<unsigned char*>(ptr) - offsetof(Slot, data)
+  );
+}
+
+// Function: _refill
+template <typename T, size_t S>
+typename SlabAllocator<T, S>::Slot* SlabAllocator<T, S>::_refill(Heap& h) {
+
+  // take all the slots returned by other threads
+  if(auto s = h.remote.exchange(nullptr, std::memory_order_acquire); s) {
+    return s;
+  }
+
+  // carve a new slab into a linked list of slots
+  auto& slab = h.slabs.emplace_back(std::make_unique<Slot[]>(M));
+  for(size_t i=0; i<M; ++i) {
+    slab[i].heap = &h;
+    slab[i].next = (i + 1 < M) ? &slab[i+1] : nullptr;
+  }
+  return &slab[0];
+}
+
+// Function: animate
+template <typename T, size_t S>
+template <typename... ArgsT>
+T* SlabAllocator<T, S>::animate(ArgsT&&... args) {
+
+  Heap& h = _this_heap();
+
+  Slot* s = h.free ? h.free : _refill(h);
+  h.free = s->next;
+
+  try {
+    return new (s->data) T(std::forward<ArgsT>(args)...);
+  }
+  catch(...) {
+    s->next = h.free;
+    h.free = s;
+    throw;
+  }
+}
+
+// Procedure: recycle
+template <typename T, size_t S>
+void SlabAllocator<T, S>::recycle(T* ptr) {
+
+  Slot* s = _slot_of(ptr);
+
+  ptr->~T();
+
+  Heap* h = s->heap;
+
+  // local free, where a thread without a heap never owns the slot
+  if(h == _heap) {
+    s->next = h->free;
+    h->free = s;
+  }
+  // remote free
+  else {
+    s->next = h->remote.load(std::memory_order_relaxed);
+    while(!h->remote.compare_exchange_weak(
+      s->next, s, std::memory_order_release, std::memory_order_relaxed
+    ));
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+// Class: SlabStdAllocator
+//
+// The class adapts SlabAllocator to the allocator requirements of
+// the standard library, such that objects owned by std::shared_ptr
+// can be pooled using std::allocate_shared. Single-object allocations
+// of the (rebound) type T take a slot of raw storage of the same size and
+// alignment from a SlabAllocator. Array allocations go to operator new.
+template <typename T, size_t S = 65536>
+class SlabStdAllocator {
+
+  struct alignas(T) Storage {
+    unsigned char data[sizeof(T)];
+  };
+
+  public:
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+      using other = SlabStdAllocator<U, S>;
+    };
+
+    SlabStdAllocator() = default;
+
+    template <typename U>
+    SlabStdAllocator(const SlabStdAllocator<U, S>&) noexcept {}
+
+    T* allocate(size_t n) {
+      if(n == 1) {
+        return reinterpret_cast<T*>(_slab.animate()->data);
+      }
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+      if(n == 1) {
+        _slab.recycle(reinterpret_cast<Storage*>(ptr));
+      }
+      else {
+        ::operator delete(ptr);
+      }
+    }
+
+    template <typename U>
+    bool operator == (const SlabStdAllocator<U, S>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator != (const SlabStdAllocator<U, S>&) const noexcept { return false; }
+
+  private:
+
+    inline static SlabAllocator<Storage, S> _slab;
+};
+
+}  // end of namespace tf -----------------------------------------------------
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+@file small_function.hpp
+@brief small function include file
+*/
+
+#ifndef TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE
+  /**
+  @def TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE
+
+  This macro defines the default size in bytes of the inline buffer
+  of tf::SmallFunction, which stores the work of each task.
+  Callables larger than the buffer are allocated on the heap.
+  The default size makes a tf::SmallFunction occupy 64 bytes.
+  */
+  #define TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE 48
+#endif
+
+namespace tf {
+
+// Class: SmallFunction
+//
+// The class implements a move-only, type-erased callable with small-buffer
+// optimization, which we use to store the work of tasks in place of
+// std::function:
+//
+// + A callable that fits in N bytes, needs no more than pointer alignment,
+//   and is nothrow move-constructible lives in the inline buffer, so creating
+//   a task with a moderately sized capture costs no heap allocation.
+//   Other callables are allocated on the heap.
+// + The callable need not be copyable, so move-only captures such as
+//   std::promise or std::packaged_task can be stored without wrappers.
+// + The invoker is stored in the object itself rather than behind a vtable,
+//   so a call costs a single indirect call.
+template <typename F, size_t N = TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE>
+class SmallFunction;
+
+/**
+@private
+*/
+template <typename R, typename... Args, size_t N>
+class SmallFunction<R(Args...), N> {
+
+  static_assert(N >= sizeof(void*), "buffer must be able to hold a pointer");
+
+  enum class Op { MOVE, DESTROY };
+
+  template <typename C>
+  constexpr static bool is_inline_v =
+    sizeof(C) <= N &&
+    alignof(void*) % alignof(C) == 0 &&
+    std::is_nothrow_move_constructible_v<C>;
+
+  public:
+
+    /**
+    @brief constructs an empty function
+    */
+    SmallFunction() = default;
+
+    /**
+    @brief constructs an empty function
+    */
+    SmallFunction(std::nullptr_t) noexcept {}
+
+    /**
+    @brief constructs a function that stores the callable @c c
+    */
+    template <
+      typename C,
+      typename D = std::decay_t<C>,
+      std::enable_if_t<
+        !std::is_same_v<D, SmallFunction> && std::is_invocable_r_v<R, D&, Args...>,
+        void
+      >* = nullptr
+    >
+    SmallFunction(C&& c) {
+      if constexpr (is_inline_v<D>) {
+        ::new (static_cast<void*>(_buffer)) D(std::forward<C>(c));
+      }
+      else {
+        *reinterpret_cast<D**>(_buffer) = new D(std::forward<C>(c));
+      }
+      _invoke = &_invoke_impl<D>;
+      _manage = &_manage_impl<D>;
+    }
+
+    /**
+    @brief move constructor
+    */
+    SmallFunction(SmallFunction&& rhs) noexcept {
+      _move_from(rhs);
+    }
+
+    /**
+    @brief move assignment operator
+    */
+    SmallFunction& operator = (SmallFunction&& rhs) noexcept {
+      if(this != &rhs) {
+        _reset();
+        _move_from(rhs);
+      }
+      return *this;
+    }
+
+    SmallFunction(const SmallFunction&) = delete;
+    SmallFunction& operator = (const SmallFunction&) = delete;
+
+    /**
+    @brief destroys the stored callable
+    */
+    ~SmallFunction() {
+      _reset();
+    }
+
+    /**
+    @brief invokes the stored callable, which must not be empty
+    */
+    R operator () (Args... args) const {
+      return _invoke(_buffer, std::forward<Args>(args)...);
+    }
+
+    /**
+    @brief queries if the function stores a callable
+    */
+    explicit operator bool () const noexcept {
+      return _invoke != nullptr;
+    }
+
+  private:
+
+    // pointer alignment keeps Node compact - over-aligned callables go to the heap
+    alignas(void*) mutable unsigned char _buffer[N];
+
+    R (*_invoke)(void*, Args&&...) {nullptr};
+    void (*_manage)(Op, void*, void*) noexcept {nullptr};
+
+    template <typename D>
+    static D& _get(void* buffer) {
+      if constexpr (is_inline_v<D>) {
+        return *std::launder(reinterpret_cast<D*>(buffer));
+      }
+      else {
+        return **reinterpret_cast<D**>(buffer);
+      }
+    }
+
+    template <typename D>
+    static R _invoke_impl(void* buffer, Args&&... args) {
+      if constexpr (std::is_void_v<R>) {
+        std::invoke(_get<D>(buffer), std::forward<Args>(args)...);
+      }
+      else {
+        return std::invoke(_get<D>(buffer), std::forward<Args>(args)...);
+      }
+    }
+
+    template <typename D>
+    static void _manage_impl(Op op, void* dst, void* src) noexcept {
+      if constexpr (is_inline_v<D>) {
+        auto& obj = _get<D>(src);
+        if(op == Op::MOVE) {
+          ::new (dst) D(std::move(obj));
+        }
+        obj.~D();
+      }
+      else {
+        if(op == Op::MOVE) {
+          *reinterpret_cast<D**>(dst) = *reinterpret_cast<D**>(src);
+        }
+        else {
+          delete *reinterpret_cast<D**>(src);
+        }
+      }
+    }
+
+    void _move_from(SmallFunction& rhs) noexcept {
+      if(rhs._manage) {
+        rhs._manage(Op::MOVE, _buffer, rhs._buffer);
+        _invoke = rhs._invoke;
+        _manage = rhs._manage;
+        rhs._invoke = nullptr;
+        rhs._manage = nullptr;
+      }
+    }
+
+    void _reset() noexcept {
+      if(_manage) {
+        _manage(Op::DESTROY, nullptr, _buffer);
+        _invoke = nullptr;
+        _manage = nullptr;
+      }
+    }
+};
+
+}  // end of namespace tf -----------------------------------------------------
@@ -0,0 +1,336 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+
+// ----------------------------------------------------------------------------
+// Basics
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Affinity.Basics" * doctest::timeout(300)) {
+
+  tf::Executor executor(2);
+  tf::Taskflow taskflow;
+
+  auto A = taskflow.emplace([](){});
+
+  REQUIRE(A.affinity() == tf::NO_AFFINITY);
+  A.affinity(1);
+  REQUIRE(A.affinity() == 1);
+  A.affinity(tf::NO_AFFINITY);
+  REQUIRE(A.affinity() == tf::NO_AFFINITY);
+
+  // an out-of-range affinity is clamped
+  A.affinity(std::numeric_limits<size_t>::max());
+  REQUIRE(A.affinity() == tf::NO_AFFINITY);
+
+  REQUIRE(executor.affinity_threshold() ==
+          std::chrono::nanoseconds(TF_DEFAULT_AFFINITY_THRESHOLD));
+  executor.affinity_threshold(std::chrono::microseconds(10));
+  REQUIRE(executor.affinity_threshold() == std::chrono::microseconds(10));
+}
+
+// ----------------------------------------------------------------------------
+// Static tasks: with a threshold that never passes, each task with an
+// affinity must run on its preferred worker
+// ----------------------------------------------------------------------------
+
+void affinity_static(unsigned W) {
+
+  tf::Executor executor(W);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  tf::Taskflow taskflow;
+
+  const size_t N = 1000;
+  std::vector<int> ids(N, -1);
+
+  // independent tasks and a chain of tasks that hops between workers
+  auto beg = taskflow.emplace([](){});
+  auto end = taskflow.emplace([](){});
+  tf::Task prev = beg;
+
+  for(size_t i=0; i<N; i++) {
+    auto task = taskflow.emplace([&, i](){
+      ids[i] = executor.this_worker_id();
+    }).affinity(i % W);
+    if(i % 2) {
+      beg.precede(task);
+      task.precede(end);
+    }
+    else {
+      prev.precede(task);
+      prev = task;
+    }
+  }
+  prev.precede(end);
+
+  for(size_t r=0; r<10; r++) {
+    std::fill(ids.begin(), ids.end(), -1);
+    executor.run(taskflow).wait();
+    for(size_t i=0; i<N; i++) {
+      REQUIRE(ids[i] == static_cast<int>(i % W));
+    }
+  }
+}
+
+TEST_CASE("Affinity.Static.1thread" * doctest::timeout(300)) {
+  affinity_static(1);
+}
+
+TEST_CASE("Affinity.Static.2threads" * doctest::timeout(300)) {
+  affinity_static(2);
+}
+
+TEST_CASE("Affinity.Static.4threads" * doctest::timeout(300)) {
+  affinity_static(4);
+}
+
+TEST_CASE("Affinity.Static.8threads" * doctest::timeout(300)) {
+  affinity_static(8);
+}
+
+// ----------------------------------------------------------------------------
+// Concurrent runs: each run executes on its own array of tasks, which
+// must keep the affinity of the tasks
+// ----------------------------------------------------------------------------
+
+void affinity_concurrent_runs(unsigned W) {
+
+  tf::Executor executor(W);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+
+  const size_t N = 100;
+  const size_t R = 8;
+  std::atomic<size_t> hits(0);
+  std::atomic<size_t> misses(0);
+
+  for(size_t i=0; i<N; i++) {
+    taskflow.emplace([&, i](){
+      if(executor.this_worker_id() == static_cast<int>(i % W)) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+      }
+      else {
+        misses.fetch_add(1, std::memory_order_relaxed);
+      }
+    }).affinity(i % W);
+  }
+
+  std::vector<tf::Future<void>> futures;
+  for(size_t r=0; r<R; r++) {
+    futures.push_back(executor.run(taskflow));
+  }
+  for(auto& fu : futures) {
+    fu.wait();
+  }
+
+  REQUIRE(hits == R*N);
+  REQUIRE(misses == 0);
+}
+
+TEST_CASE("Affinity.ConcurrentRuns.2threads" * doctest::timeout(300)) {
+  affinity_concurrent_runs(2);
+}
+
+TEST_CASE("Affinity.ConcurrentRuns.4threads" * doctest::timeout(300)) {
+  affinity_concurrent_runs(4);
+}
+
+// ----------------------------------------------------------------------------
+// Async tasks submitted from inside and outside the executor
+// ----------------------------------------------------------------------------
+
+void affinity_async(unsigned W) {
+
+  tf::Executor executor(W);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  const size_t N = 1000;
+  std::vector<int> ids(2*N, -1);
+
+  for(size_t i=0; i<N; i++) {
+    tf::TaskParams params;
+    params.affinity = i % W;
+    executor.silent_async(params, [&, i](){
+      ids[i] = executor.this_worker_id();
+      tf::TaskParams inner;
+      inner.affinity = (i + 1) % W;
+      executor.silent_async(inner, [&, i](){
+        ids[N + i] = executor.this_worker_id();
+      });
+    });
+  }
+  executor.wait_for_all();
+
+  for(size_t i=0; i<N; i++) {
+    REQUIRE(ids[i] == static_cast<int>(i % W));
+    REQUIRE(ids[N + i] == static_cast<int>((i + 1) % W));
+  }
+}
+
+TEST_CASE("Affinity.Async.1thread" * doctest::timeout(300)) {
+  affinity_async(1);
+}
+
+TEST_CASE("Affinity.Async.2threads" * doctest::timeout(300)) {
+  affinity_async(2);
+}
+
+TEST_CASE("Affinity.Async.4threads" * doctest::timeout(300)) {
+  affinity_async(4);
+}
+
+TEST_CASE("Affinity.Async.8threads" * doctest::timeout(300)) {
+  affinity_async(8);
+}
+
+// ----------------------------------------------------------------------------
+// Out of range: a task preferring a worker that does not run is
+// scheduled as usual
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Affinity.OutOfRange" * doctest::timeout(300)) {
+
+  tf::Executor executor(4, 8);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<1000; i++) {
+    taskflow.emplace([&](){ counter++; }).affinity(4 + i % 4);
+  }
+
+  executor.run(taskflow).wait();
+  REQUIRE(counter == 1000);
+}
+
+// ----------------------------------------------------------------------------
+// Fallback: tasks preferring a busy worker are stolen by others
+// once the threshold passes
+// ----------------------------------------------------------------------------
+
+void affinity_fallback(unsigned W) {
+
+  tf::Executor executor(W);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  const size_t N = 1000;
+  std::atomic<size_t> counter {0};
+
+  // worker 0 stays busy until all the other tasks preferring it have run,
+  // and the threshold passes right away only once it does, since otherwise
+  // another worker could steal the busy task itself
+  tf::TaskParams params;
+  params.affinity = 0;
+
+  std::atomic<int> started {-1};
+  executor.silent_async(params, [&](){
+    started = executor.this_worker_id();
+    while(counter != N);
+  });
+  while(started == -1);
+  REQUIRE(started == 0);
+  executor.affinity_threshold(std::chrono::nanoseconds(0));
+
+  for(size_t i=0; i<N; i++) {
+    executor.silent_async(params, [&](){
+      REQUIRE(executor.this_worker_id() != 0);
+      counter++;
+    });
+  }
+  executor.wait_for_all();
+
+  REQUIRE(counter == N);
+}
+
+TEST_CASE("Affinity.Fallback.2threads" * doctest::timeout(300)) {
+  affinity_fallback(2);
+}
+
+TEST_CASE("Affinity.Fallback.4threads" * doctest::timeout(300)) {
+  affinity_fallback(4);
+}
+
+// ----------------------------------------------------------------------------
+// Wakeup: an idle worker sleeping before the threshold passes must wake up
+// to take the task of a worker that stays busy
+// ----------------------------------------------------------------------------
+
+void affinity_wakeup(unsigned W) {
+
+  tf::Executor executor(W);
+
+  tf::TaskParams params;
+  params.affinity = 0;
+
+  for(size_t r=0; r<5; r++) {
+
+    std::atomic<int> started {-1};
+    std::atomic<bool> done {false};
+    std::atomic<int> id {-1};
+
+    // worker 0 stays busy until the mailed task runs or a long time passes
+    executor.affinity_threshold(std::chrono::hours(1));
+    executor.silent_async(params, [&](){
+      started = executor.this_worker_id();
+      auto beg = std::chrono::steady_clock::now();
+      while(!done && std::chrono::steady_clock::now() - beg < std::chrono::seconds(10)) {
+        std::this_thread::yield();
+      }
+    });
+    while(started == -1);
+    REQUIRE(started == 0);
+    executor.affinity_threshold(std::chrono::milliseconds(10));
+
+    // let the other workers fall asleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    executor.silent_async(params, [&](){
+      id = executor.this_worker_id();
+      done = true;
+    });
+    executor.wait_for_all();
+
+    REQUIRE(done == true);
+    REQUIRE(id != 0);
+  }
+}
+
+TEST_CASE("Affinity.Wakeup.2threads" * doctest::timeout(300)) {
+  affinity_wakeup(2);
+}
+
+TEST_CASE("Affinity.Wakeup.4threads" * doctest::timeout(300)) {
+  affinity_wakeup(4);
+}
+
+// ----------------------------------------------------------------------------
+// Resize: tasks left in the mailboxes of retired workers still run
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Affinity.Resize" * doctest::timeout(300)) {
+
+  tf::Executor executor(4, 4);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  std::atomic<size_t> counter {0};
+
+  for(size_t r=0; r<10; r++) {
+    std::thread producer([&](){
+      for(size_t i=0; i<1000; i++) {
+        tf::TaskParams params;
+        params.affinity = i % 4;
+        executor.silent_async(params, [&](){ counter++; });
+      }
+    });
+    executor.resize(1);
+    producer.join();
+    executor.wait_for_all();
+    executor.resize(4);
+  }
+
+  REQUIRE(counter == 10000);
+}
@@ -0,0 +1,311 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
+
+// ----------------------------------------------------------------------------
+// Basics
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Arenas.Basics" * doctest::timeout(300)) {
+
+  tf::Executor executor({{"interactive", 2}, {"background", 3}});
+
+  REQUIRE(executor.num_workers() == 5);
+  REQUIRE(executor.num_arenas() == 2);
+  REQUIRE(executor.arena_id("interactive") == 0);
+  REQUIRE(executor.arena_id("background") == 1);
+  REQUIRE_THROWS(executor.arena_id("batch"));
+  REQUIRE_THROWS(executor.resize(4));
+
+  // an executor without arenas has one arena of all workers
+  tf::Executor single(4);
+  REQUIRE(single.num_arenas() == 1);
+  REQUIRE_NOTHROW(single.resize(2));
+
+  // every arena needs at least one worker
+  REQUIRE_THROWS(tf::Executor({{"a", 1}, {"b", 0}}));
+  REQUIRE_THROWS(tf::Executor(std::vector<tf::ArenaParams>{}));
+
+  tf::Taskflow taskflow;
+  REQUIRE(taskflow.arena() == tf::NO_ARENA);
+  taskflow.arena(1);
+  REQUIRE(taskflow.arena() == 1);
+  taskflow.arena(std::numeric_limits<size_t>::max());
+  REQUIRE(taskflow.arena() == tf::NO_ARENA);
+}
+
+// ----------------------------------------------------------------------------
+// Taskflow: all tasks of a taskflow, including the tasks they spawn
+// without an arena, run on the workers of its arena
+// ----------------------------------------------------------------------------
+
+void arenas_taskflow(size_t A, size_t W) {
+
+  std::vector<tf::ArenaParams> params;
+  for(size_t a=0; a<A; a++) {
+    params.push_back({std::to_string(a), W});
+  }
+
+  tf::Executor executor(params);
+
+  for(size_t a=0; a<A; a++) {
+
+    tf::Taskflow taskflow;
+    taskflow.arena(a);
+
+    const size_t N = 100;
+    std::vector<int> ids(4*N, -1);
+
+    for(size_t i=0; i<N; i++) {
+      auto A1 = taskflow.emplace([&, i](){ ids[i] = executor.this_worker_id(); });
+      auto B1 = taskflow.emplace([&, i](tf::Subflow& sf){
+        sf.emplace([&, i](){ ids[N + i] = executor.this_worker_id(); });
+      });
+      auto C1 = taskflow.emplace([&, i](tf::Runtime&){
+        executor.silent_async([&, i](){ ids[2*N + i] = executor.this_worker_id(); });
+      });
+      A1.precede(B1, C1);
+    }
+    taskflow.for_each_index(size_t{0}, N, size_t{1}, [&](size_t i){
+      ids[3*N + i] = executor.this_worker_id();
+    });
+
+    for(size_t r=0; r<3; r++) {
+      std::fill(ids.begin(), ids.end(), -1);
+      executor.run(taskflow).wait();
+      executor.wait_for_all();
+      for(auto id : ids) {
+        REQUIRE(id >= static_cast<int>(a*W));
+        REQUIRE(id < static_cast<int>((a+1)*W));
+      }
+    }
+  }
+}
+
+TEST_CASE("Arenas.Taskflow.1x1threads" * doctest::timeout(300)) {
+  arenas_taskflow(1, 1);
+}
+
+TEST_CASE("Arenas.Taskflow.2x1threads" * doctest::timeout(300)) {
+  arenas_taskflow(2, 1);
+}
+
+TEST_CASE("Arenas.Taskflow.2x2threads" * doctest::timeout(300)) {
+  arenas_taskflow(2, 2);
+}
+
+TEST_CASE("Arenas.Taskflow.3x4threads" * doctest::timeout(300)) {
+  arenas_taskflow(3, 4);
+}
+
+// ----------------------------------------------------------------------------
+// Async: asynchronous tasks run in the arena of their parameters or
+// in the arena of the worker that submits them
+// ----------------------------------------------------------------------------
+
+void arenas_async(size_t W) {
+
+  tf::Executor executor({{"a", W}, {"b", W}});
+
+  const size_t N = 1000;
+  std::vector<int> ids(3*N, -1);
+
+  for(size_t i=0; i<N; i++) {
+    tf::TaskParams params;
+    params.arena = i % 2;
+    executor.silent_async(params, [&, i](){
+      ids[i] = executor.this_worker_id();
+      // inherits the arena of the worker
+      executor.silent_async([&, i](){
+        ids[N + i] = executor.this_worker_id();
+      });
+    });
+    // goes to the first arena
+    executor.silent_async([&, i](){
+      ids[2*N + i] = executor.this_worker_id();
+    });
+  }
+  executor.wait_for_all();
+
+  for(size_t i=0; i<N; i++) {
+    int beg = static_cast<int>((i % 2) * W);
+    REQUIRE(ids[i] >= beg);
+    REQUIRE(ids[i] < beg + static_cast<int>(W));
+    REQUIRE(ids[N + i] >= beg);
+    REQUIRE(ids[N + i] < beg + static_cast<int>(W));
+    REQUIRE(ids[2*N + i] >= 0);
+    REQUIRE(ids[2*N + i] < static_cast<int>(W));
+  }
+}
+
+TEST_CASE("Arenas.Async.1thread" * doctest::timeout(300)) {
+  arenas_async(1);
+}
+
+TEST_CASE("Arenas.Async.2threads" * doctest::timeout(300)) {
+  arenas_async(2);
+}
+
+TEST_CASE("Arenas.Async.4threads" * doctest::timeout(300)) {
+  arenas_async(4);
+}
+
+// ----------------------------------------------------------------------------
+// Isolation: a taskflow completes while all workers of another arena
+// are busy with a flood of tasks
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Arenas.Isolation" * doctest::timeout(300)) {
+
+  tf::Executor executor({{"interactive", 2}, {"background", 2}});
+
+  std::atomic<bool> stop {false};
+  std::atomic<size_t> num_blocked {0};
+
+  tf::TaskParams params;
+  params.arena = executor.arena_id("background");
+
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async(params, [&](){
+      num_blocked++;
+      while(!stop);
+    });
+  }
+  while(num_blocked != 2);
+
+  tf::Taskflow taskflow;
+  taskflow.arena(executor.arena_id("interactive"));
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([&](){ counter++; });
+  }
+
+  for(size_t r=0; r<10; r++) {
+    executor.run(taskflow).wait();
+  }
+  REQUIRE(counter == 1000);
+  REQUIRE(num_blocked == 2);
+
+  stop = true;
+  executor.wait_for_all();
+  REQUIRE(num_blocked == 1000);
+}
+
+// ----------------------------------------------------------------------------
+// Steal: workers of a stealing arena help other arenas once awake
+// ----------------------------------------------------------------------------
+
+void arenas_steal(size_t W) {
+
+  tf::Executor executor({{"helper", W, true}, {"busy", 1}});
+
+  const size_t N = 1000;
+  std::atomic<size_t> counter {0};
+  std::atomic<int> blocked {-1};
+
+  tf::TaskParams busy;
+  busy.arena = executor.arena_id("busy");
+
+  // the worker running the first task of the busy arena, which is either 
+  // its only worker or a helper, waits for the others to run the rest
+  executor.silent_async(busy, [&](){
+    blocked = executor.this_worker_id();
+    while(counter != N);
+  });
+  while(blocked == -1);
+
+  for(size_t i=0; i<N; i++) {
+    executor.silent_async(busy, [&](){
+      REQUIRE(executor.this_worker_id() != blocked);
+      counter++;
+    });
+  }
+
+  // wakes up the helpers, which are not woken up by the busy arena
+  tf::TaskParams helper;
+  helper.arena = executor.arena_id("helper");
+  executor.silent_async(helper, [](){});
+
+  executor.wait_for_all();
+  REQUIRE(counter == N);
+}
+
+TEST_CASE("Arenas.Steal.1thread" * doctest::timeout(300)) {
+  arenas_steal(1);
+}
+
+TEST_CASE("Arenas.Steal.2threads" * doctest::timeout(300)) {
+  arenas_steal(2);
+}
+
+TEST_CASE("Arenas.Steal.4threads" * doctest::timeout(300)) {
+  arenas_steal(4);
+}
+
+// ----------------------------------------------------------------------------
+// Fallback: a taskflow without a valid arena runs in the first arena
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Arenas.Fallback" * doctest::timeout(300)) {
+
+  tf::Executor executor({{"a", 2}, {"b", 2}});
+
+  tf::Taskflow taskflow;
+  std::vector<int> ids(100, -1);
+  for(size_t i=0; i<ids.size(); i++) {
+    taskflow.emplace([&, i](){ ids[i] = executor.this_worker_id(); });
+  }
+
+  for(size_t arena : {tf::NO_ARENA, size_t{2}, size_t{1000}}) {
+    taskflow.arena(arena);
+    std::fill(ids.begin(), ids.end(), -1);
+    executor.run(taskflow).wait();
+    for(auto id : ids) {
+      REQUIRE((id == 0 || id == 1));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Affinity: a task preferring a worker of another arena is scheduled 
+// as usual in its own arena
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Arenas.Affinity" * doctest::timeout(300)) {
+
+  tf::Executor executor({{"a", 2}, {"b", 2}});
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  tf::Taskflow taskflow;
+  taskflow.arena(executor.arena_id("b"));
+
+  std::vector<int> ids(100, -1);
+  for(size_t i=0; i<ids.size(); i++) {
+    taskflow.emplace([&, i](){ ids[i] = executor.this_worker_id(); }).affinity(i % 4);
+  }
+  executor.run(taskflow).wait();
+
+  for(size_t i=0; i<ids.size(); i++) {
+    if(i % 4 >= 2) {
+      REQUIRE(ids[i] == static_cast<int>(i % 4));
+    }
+    else {
+      REQUIRE((ids[i] == 2 || ids[i] == 3));
+    }
+  }
+
+  tf::TaskParams params;
+  params.arena = executor.arena_id("b");
+  for(size_t i=0; i<ids.size(); i++) {
+    params.affinity = i % 2;
+    executor.silent_async(params, [&, i](){ ids[i] = executor.this_worker_id(); });
+  }
+  executor.wait_for_all();
+
+  for(auto id : ids) {
+    REQUIRE((id == 2 || id == 3));
+  }
+}
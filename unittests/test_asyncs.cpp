@@ -381,3 +381,202 @@ TEST_CASE("RuntimeAsync.8threads") {
 TEST_CASE("RuntimeAsync.11threads") {
   runtime_async(11);
 }
+
+// --------------------------------------------------------
+// Testcase: WorkerAwareWait
+// --------------------------------------------------------
+
+// each async waits on its own children; with blocking waits, 
+// a small pool would deadlock once all workers are waiting
+void worker_aware_wait(unsigned W) {
+
+  tf::Executor executor(W);
+
+  std::atomic<int> counter(0);
+
+  std::function<int(int)> fib = [&](int n) -> int {
+    counter.fetch_add(1, std::memory_order_relaxed);
+    if(n < 2) {
+      return n;
+    }
+    auto fu1 = executor.async([&, n](){ return fib(n-1); });
+    auto fu2 = executor.async([&, n](){ return fib(n-2); });
+    return fu1.get() + fu2.get();
+  };
+
+  REQUIRE(executor.async([&](){ return fib(15); }).get() == 610);
+  REQUIRE(counter == 1973);
+
+  // waits on taskflow runs and dependent async tasks from workers
+  tf::Taskflow taskflow;
+  taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+
+  counter = 0;
+
+  for(int i=0; i<100; i++) {
+    executor.silent_async([&](){
+      executor.run(taskflow).wait();
+      auto A = executor.silent_dependent_async([&](){
+        counter.fetch_add(1, std::memory_order_relaxed);
+      });
+      auto [B, fu] = executor.dependent_async([&](){
+        return counter.fetch_add(1, std::memory_order_relaxed);
+      }, A);
+      A.wait();
+      B.wait();
+      REQUIRE(A.is_done());
+      REQUIRE(B.is_done());
+      fu.get();
+    });
+  }
+
+  executor.wait_for_all();
+
+  REQUIRE(counter == 300);
+  
+  // waits from a non-worker thread
+  auto A = executor.silent_dependent_async([&](){
+    counter.fetch_add(1, std::memory_order_relaxed);
+  });
+  A.wait();
+  REQUIRE(counter == 301);
+}
+
+TEST_CASE("WorkerAwareWait.1thread" * doctest::timeout(300)) {
+  worker_aware_wait(1);
+}
+
+TEST_CASE("WorkerAwareWait.2threads" * doctest::timeout(300)) {
+  worker_aware_wait(2);
+}
+
+TEST_CASE("WorkerAwareWait.4threads" * doctest::timeout(300)) {
+  worker_aware_wait(4);
+}
+
+TEST_CASE("WorkerAwareWait.8threads" * doctest::timeout(300)) {
+  worker_aware_wait(8);
+}
+
+// --------------------------------------------------------
+// Testcase: BulkSilentAsync
+// --------------------------------------------------------
+
+void bulk_silent_async(unsigned W) {
+
+  tf::Executor executor(W);
+
+  // each index runs exactly once
+  for(size_t n=0; n<=4096; n = (n == 0 ? 1 : n*2)) {
+    std::vector<std::atomic<int>> visits(n);
+    executor.bulk_silent_async(n, [&](size_t i){
+      visits[i].fetch_add(1, std::memory_order_relaxed);
+    });
+    executor.wait_for_all();
+    for(size_t i=0; i<n; i++) {
+      REQUIRE(visits[i] == 1);
+    }
+  }
+
+  // with task parameters
+  std::atomic<size_t> counter(0);
+  tf::TaskParams params;
+  params.name = "bulk";
+  executor.bulk_silent_async(params, 1000, [&](size_t){
+    counter.fetch_add(1, std::memory_order_relaxed);
+  });
+  executor.wait_for_all();
+  REQUIRE(counter == 1000);
+
+  // the callable is moved in once and destroyed by the last task
+  struct Callable {
+    std::atomic<size_t>* counter;
+    std::atomic<int>* alive;
+    Callable(std::atomic<size_t>* c, std::atomic<int>* a) : counter {c}, alive {a} { ++*alive; }
+    Callable(const Callable&) = delete;
+    Callable(Callable&& rhs) : counter {rhs.counter}, alive {rhs.alive} { ++*alive; }
+    ~Callable() { --*alive; }
+    void operator () (size_t) { counter->fetch_add(1, std::memory_order_relaxed); }
+  };
+  counter = 0;
+  std::atomic<int> alive(0);
+  executor.bulk_silent_async(5000, Callable(&counter, &alive));
+  executor.wait_for_all();
+  REQUIRE(counter == 5000);
+  REQUIRE(alive == 0);
+
+  // submitted by external threads and from workers at the same time
+  counter = 0;
+  std::vector<std::thread> threads;
+  for(size_t t=0; t<4; t++) {
+    threads.emplace_back([&](){
+      executor.bulk_silent_async(100, [&](size_t){
+        executor.bulk_silent_async(10, [&](size_t){
+          counter.fetch_add(1, std::memory_order_relaxed);
+        });
+      });
+    });
+  }
+  for(auto& thread : threads) {
+    thread.join();
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 4000);
+}
+
+TEST_CASE("BulkSilentAsync.1thread" * doctest::timeout(300)) {
+  bulk_silent_async(1);
+}
+
+TEST_CASE("BulkSilentAsync.2threads" * doctest::timeout(300)) {
+  bulk_silent_async(2);
+}
+
+TEST_CASE("BulkSilentAsync.4threads" * doctest::timeout(300)) {
+  bulk_silent_async(4);
+}
+
+TEST_CASE("BulkSilentAsync.8threads" * doctest::timeout(300)) {
+  bulk_silent_async(8);
+}
+
+// --------------------------------------------------------
+// Testcase: WorkerAwareWait.OtherExecutor
+// --------------------------------------------------------
+
+// a worker waiting on the result of another executor blocks instead of
+// running the tasks of its own executor, which would make no progress
+// on the result
+TEST_CASE("WorkerAwareWait.OtherExecutor" * doctest::timeout(300)) {
+
+  tf::Executor executor(1);
+  tf::Executor other(1);
+
+  std::atomic<bool> waiting {false};
+  std::atomic<size_t> nested {0};
+
+  for(int i=0; i<10; i++) {
+    executor.silent_async([&](){
+      auto fu = other.async([](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 1;
+      });
+      auto [A, fuA] = other.dependent_async([](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      });
+      waiting = true;
+      REQUIRE(fu.get() == 1);
+      A.wait();
+      REQUIRE(A.is_done());
+      waiting = false;
+    });
+    executor.silent_async([&](){
+      if(waiting) {
+        nested++;
+      }
+    });
+  }
+
+  executor.wait_for_all();
+  REQUIRE(nested == 0);
+}
@@ -4,6 +4,7 @@
 #include <taskflow/taskflow.hpp>
 #include <taskflow/algorithm/for_each.hpp>
 #include <taskflow/algorithm/reduce.hpp>
+#include <set>
 
 // --------------------------------------------------------
 // Testcase: Type
@@ -1035,3 +1036,782 @@ TEST_CASE("Observer.4threads" * doctest::timeout(300)) {
 }
 
 
+
+// --------------------------------------------------------
+// Testcase: Compile
+// --------------------------------------------------------
+
+void compile_random(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  const size_t N = 256;
+  const size_t R = 10;
+
+  std::vector<tf::Task> tasks;
+  std::vector<size_t> counters(N, 0);
+  std::vector<std::atomic<size_t>> stamps(N);
+  std::atomic<size_t> clock {0};
+
+  for(size_t i=0; i<N; i++) {
+    tasks.emplace_back(taskflow.emplace([&, i](){
+      counters[i]++;
+      stamps[i] = clock.fetch_add(1);
+    }));
+  }
+
+  std::vector<std::pair<size_t, size_t>> edges;
+  for(size_t i=0; i<N; i++) {
+    for(size_t j=i+1; j<N; j++) {
+      if(rand()%16 == 0) {
+        tasks[i].precede(tasks[j]);
+        edges.emplace_back(i, j);
+      }
+    }
+  }
+
+  REQUIRE(taskflow.compiled() == false);
+  taskflow.compile();
+  REQUIRE(taskflow.compiled() == true);
+  REQUIRE(taskflow.num_tasks() == N);
+
+  for(size_t r=1; r<=R; r++) {
+    executor.run(taskflow).wait();
+    for(size_t i=0; i<N; i++) {
+      REQUIRE(counters[i] == r);
+    }
+    for(auto [i, j] : edges) {
+      REQUIRE(stamps[i] < stamps[j]);
+    }
+  }
+
+  executor.run_n(taskflow, R).wait();
+  REQUIRE(taskflow.compiled() == true);
+
+  for(size_t i=0; i<N; i++) {
+    REQUIRE(counters[i] == 2*R);
+  }
+}
+
+TEST_CASE("Compile.Random.1thread" * doctest::timeout(300)) {
+  compile_random(1);
+}
+
+TEST_CASE("Compile.Random.2threads" * doctest::timeout(300)) {
+  compile_random(2);
+}
+
+TEST_CASE("Compile.Random.4threads" * doctest::timeout(300)) {
+  compile_random(4);
+}
+
+TEST_CASE("Compile.Random.8threads" * doctest::timeout(300)) {
+  compile_random(8);
+}
+
+TEST_CASE("Compile.Condition" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  size_t counter = 0, loops = 0, done = 0;
+
+  auto init = taskflow.emplace([&](){ loops = 0; });
+  auto body = taskflow.emplace([&](){ loops++; counter++; });
+  auto cond = taskflow.emplace([&](){ return loops < 10 ? 0 : 1; });
+  auto stop = taskflow.emplace([&](){ done++; });
+
+  init.precede(body);
+  body.precede(cond);
+  cond.precede(body, stop);
+
+  taskflow.compile();
+  executor.run_n(taskflow, 5).wait();
+
+  REQUIRE(taskflow.compiled() == true);
+  REQUIRE(counter == 50);
+  REQUIRE(done == 5);
+}
+
+TEST_CASE("Compile.Invalidate" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::vector<int> order;
+  std::mutex mutex;
+  auto log = [&](int i){
+    std::scoped_lock lock(mutex);
+    order.push_back(i);
+  };
+
+  auto A = taskflow.emplace([&](){ log(0); });
+  auto B = taskflow.emplace([&](){ log(1); });
+
+  taskflow.compile();
+  REQUIRE(taskflow.compiled() == true);
+
+  // new dependency
+  B.precede(A);
+  REQUIRE(taskflow.compiled() == false);
+  executor.run(taskflow).wait();
+  REQUIRE(order == std::vector<int>{1, 0});
+  
+  taskflow.compile();
+  REQUIRE(taskflow.compiled() == true);
+
+  // new task
+  auto C = taskflow.emplace([&](){ log(2); });
+  A.precede(C);
+  REQUIRE(taskflow.compiled() == false);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order == std::vector<int>{1, 0, 2});
+  REQUIRE(taskflow.compiled() == false);
+
+  // removed task without any dependency
+  auto D = taskflow.emplace([&](){ log(3); });
+  taskflow.compile();
+  taskflow.erase(D);
+  REQUIRE(taskflow.compiled() == false);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order == std::vector<int>{1, 0, 2});
+
+  // removed dependency
+  taskflow.compile();
+  taskflow.remove_dependency(B, A);
+  REQUIRE(taskflow.compiled() == false);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order.size() == 3);
+  REQUIRE(std::find(order.begin(), order.end(), 0) < std::find(order.begin(), order.end(), 2));
+
+  // clear and move
+  taskflow.compile();
+  tf::Taskflow moved(std::move(taskflow));
+  REQUIRE(taskflow.compiled() == false);
+  REQUIRE(moved.compiled() == true);
+  moved.clear();
+  REQUIRE(moved.compiled() == false);
+  executor.run(moved).wait();
+}
+
+TEST_CASE("Compile.Rewire" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::vector<int> order;
+  std::mutex mutex;
+  auto log = [&](int i){
+    std::scoped_lock lock(mutex);
+    order.push_back(i);
+  };
+  auto before = [&](int u, int v){
+    return std::find(order.begin(), order.end(), u) <
+           std::find(order.begin(), order.end(), v);
+  };
+
+  auto [A, B, C, D] = taskflow.emplace(
+    [&](){ log(0); }, [&](){ log(1); }, [&](){ log(2); }, [&](){ log(3); }
+  );
+
+  // A->B and C->D rewired to A->C and B->D keep the edge count of every task
+  A.precede(B);
+  C.precede(D);
+  taskflow.compile();
+  REQUIRE(taskflow.compiled() == true);
+
+  taskflow.remove_dependency(A, B);
+  taskflow.remove_dependency(C, D);
+  A.precede(C);
+  B.precede(D);
+  REQUIRE(taskflow.compiled() == false);
+
+  for(int r=0; r<10; r++) {
+    order.clear();
+    executor.run(taskflow).wait();
+    REQUIRE(order.size() == 4);
+    REQUIRE(before(0, 2));
+    REQUIRE(before(1, 3));
+  }
+
+  // new work of a task, which may change its type
+  taskflow.compile();
+  REQUIRE(taskflow.compiled() == true);
+  A.work([&](){ log(0); });
+  REQUIRE(taskflow.compiled() == false);
+
+  // a module run does not clear the modification of a compiled graph
+  taskflow.compile();
+  D.precede(A);
+  taskflow.remove_dependency(A, C);
+  tf::Taskflow parent;
+  parent.composed_of(taskflow);
+  executor.run(parent).wait();
+  REQUIRE(taskflow.compiled() == false);
+  order.clear();
+  executor.run(taskflow).wait();
+  REQUIRE(order.size() == 4);
+  REQUIRE(before(1, 3));
+  REQUIRE(before(3, 0));
+}
+
+TEST_CASE("Compile.Composition" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow1, taskflow2;
+
+  std::atomic<size_t> counter {0};
+
+  auto A = taskflow1.emplace([&](){ counter++; });
+  auto B = taskflow1.emplace([&](){ counter++; });
+  auto C = taskflow1.emplace([&](){ counter++; });
+  auto D = taskflow1.emplace([&](){ counter++; });
+  D.precede(B);
+  C.precede(A);
+
+  taskflow1.compile();
+
+  auto m = taskflow2.composed_of(taskflow1);
+  auto e = taskflow2.emplace([&](){ counter++; });
+  m.precede(e);
+
+  // running the module keeps the compiled graph valid
+  executor.run_n(taskflow2, 10).wait();
+  REQUIRE(counter == 50);
+  REQUIRE(taskflow1.compiled() == true);
+
+  executor.run_n(taskflow1, 10).wait();
+  REQUIRE(counter == 90);
+  REQUIRE(taskflow1.compiled() == true);
+}
+
+// --------------------------------------------------------
+// Testcase: RepeatedRuns
+// --------------------------------------------------------
+
+void repeated_runs(unsigned W, size_t N) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  const size_t R = 10;
+  const size_t L = 16;
+
+  // layers of tasks, each depending on up to two tasks of the previous layer
+  std::vector<tf::Task> tasks;
+  std::vector<std::vector<size_t>> preds(N);
+  std::vector<std::atomic<size_t>> runs(N);
+  std::atomic<size_t> violations {0};
+
+  for(size_t i=0; i<N; i++) {
+    tasks.emplace_back(taskflow.emplace([&, i](){
+      auto r = runs[i].load() + 1;
+      for(auto p : preds[i]) {
+        if(runs[p] != r) {
+          violations++;
+        }
+      }
+      runs[i] = r;
+    }));
+  }
+
+  const size_t layer = N / L;
+  for(size_t i=layer; i<N; i++) {
+    for(size_t k=0; k<2; k++) {
+      auto p = (i/layer - 1)*layer + rand()%layer;
+      if(std::find(preds[i].begin(), preds[i].end(), p) == preds[i].end()) {
+        tasks[p].precede(tasks[i]);
+        preds[i].push_back(p);
+      }
+    }
+  }
+
+  executor.run_n(taskflow, R).wait();
+
+  REQUIRE(violations == 0);
+  for(size_t i=0; i<N; i++) {
+    REQUIRE(runs[i] == R);
+  }
+
+  // the graph recorded for the repeated runs is not kept
+  REQUIRE(taskflow.compiled() == false);
+
+  // runs of explicitly compiled graphs are set up the same way
+  taskflow.compile();
+  executor.run_until(taskflow, [&, r=0]() mutable { return r++ == R; }).wait();
+  
+  REQUIRE(violations == 0);
+  REQUIRE(taskflow.compiled() == true);
+  for(size_t i=0; i<N; i++) {
+    REQUIRE(runs[i] == 2*R);
+  }
+}
+
+TEST_CASE("RepeatedRuns.1thread" * doctest::timeout(300)) {
+  repeated_runs(1, 1024);
+  repeated_runs(1, 4*TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE);
+}
+
+TEST_CASE("RepeatedRuns.2threads" * doctest::timeout(300)) {
+  repeated_runs(2, 1024);
+  repeated_runs(2, 4*TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE);
+}
+
+TEST_CASE("RepeatedRuns.4threads" * doctest::timeout(300)) {
+  repeated_runs(4, 1024);
+  repeated_runs(4, 4*TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE);
+}
+
+TEST_CASE("RepeatedRuns.8threads" * doctest::timeout(300)) {
+  repeated_runs(8, 1024);
+  repeated_runs(8, 4*TF_DEFAULT_PARALLEL_SET_UP_GRAIN_SIZE);
+}
+
+TEST_CASE("RepeatedRuns.Modify" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::vector<int> order;
+
+  auto A = taskflow.emplace([&](){ order.push_back(0); });
+  auto B = taskflow.emplace([&](){ order.push_back(1); });
+  A.precede(B);
+
+  executor.run_n(taskflow, 3).wait();
+  REQUIRE(order == std::vector<int>{0, 1, 0, 1, 0, 1});
+
+  // reversing the dependency keeps the number of edges of every task
+  taskflow.remove_dependency(A, B);
+  B.precede(A);
+
+  order.clear();
+  executor.run_n(taskflow, 3).wait();
+  REQUIRE(order == std::vector<int>{1, 0, 1, 0, 1, 0});
+}
+
+TEST_CASE("RepeatedRuns.Condition" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  size_t counter = 0, loops = 0, done = 0;
+
+  auto init = taskflow.emplace([&](){ loops = 0; });
+  auto body = taskflow.emplace([&](){ loops++; counter++; });
+  auto cond = taskflow.emplace([&](){ return loops < 10 ? 0 : 1; });
+  auto stop = taskflow.emplace([&](){ done++; });
+
+  init.precede(body);
+  body.precede(cond);
+  cond.precede(body, stop);
+
+  executor.run_n(taskflow, 5).wait();
+
+  REQUIRE(counter == 50);
+  REQUIRE(done == 5);
+}
+
+TEST_CASE("RepeatedRuns.Exception" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  size_t runs = 0;
+  auto A = taskflow.emplace([&](){ 
+    if(++runs == 3) {
+      throw std::runtime_error("x");
+    }
+  });
+  auto B = taskflow.emplace([](){});
+  A.precede(B);
+
+  REQUIRE_THROWS_WITH_AS(executor.run_n(taskflow, 5).get(), "x", std::runtime_error);
+  REQUIRE(runs == 3);
+
+  runs = 10;
+  executor.run_n(taskflow, 5).get();
+  REQUIRE(runs == 15);
+}
+
+// --------------------------------------------------------
+// Testcase: ConcurrentRuns
+// --------------------------------------------------------
+
+void concurrent_runs(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+  REQUIRE(taskflow.concurrent_runs() == true);
+
+  std::atomic<size_t> counter {0};
+  std::atomic<size_t> active {0};
+  std::atomic<size_t> max_active {0};
+
+  // A -> B -> D, A -> C -> D, where B stays busy for a while
+  auto A = taskflow.emplace([&](){ counter++; });
+  auto B = taskflow.emplace([&](){
+    auto a = ++active;
+    for(auto m = max_active.load(); m < a && !max_active.compare_exchange_weak(m, a););
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    --active;
+    counter++;
+  });
+  auto C = taskflow.emplace([&](){ counter++; });
+  auto D = taskflow.emplace([&](){ counter++; });
+  A.precede(B, C);
+  D.succeed(B, C);
+
+  const size_t R = 16;
+
+  // submissions from one thread
+  std::vector<tf::Future<void>> futures;
+  for(size_t r=0; r<R; r++) {
+    futures.push_back(executor.run_n(taskflow, 2));
+  }
+  for(auto& fu : futures) {
+    fu.get();
+  }
+  REQUIRE(counter == R*2*4);
+
+  // submissions from many threads
+  counter = 0;
+  std::vector<std::thread> threads;
+  for(size_t t=0; t<8; t++) {
+    threads.emplace_back([&](){
+      for(size_t r=0; r<R; r++) {
+        executor.run(taskflow).wait();
+      }
+    });
+  }
+  for(auto& t : threads) {
+    t.join();
+  }
+  REQUIRE(counter == 8*R*4);
+
+  // runs of the same taskflow overlap
+  if(W > 1) {
+    REQUIRE(max_active > 1);
+  }
+}
+
+TEST_CASE("ConcurrentRuns.1thread" * doctest::timeout(300)) {
+  concurrent_runs(1);
+}
+
+TEST_CASE("ConcurrentRuns.2threads" * doctest::timeout(300)) {
+  concurrent_runs(2);
+}
+
+TEST_CASE("ConcurrentRuns.4threads" * doctest::timeout(300)) {
+  concurrent_runs(4);
+}
+
+TEST_CASE("ConcurrentRuns.8threads" * doctest::timeout(300)) {
+  concurrent_runs(8);
+}
+
+TEST_CASE("ConcurrentRuns.Condition" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+
+  std::atomic<size_t> loops {0}, taken {0}, skipped {0};
+
+  // each run loops over A until the condition picks its second successor
+  auto A = taskflow.emplace([&](){ loops++; });
+  auto cond = taskflow.emplace([&](){ return 1; });
+  auto B = taskflow.emplace([&](){ skipped++; });
+  auto C = taskflow.emplace([&](){ taken++; });
+  A.precede(cond);
+  cond.precede(B, C);
+
+  for(int i=0; i<10; i++) {
+    executor.run(taskflow);
+  }
+  executor.wait_for_all();
+
+  REQUIRE(loops == 10);
+  REQUIRE(taken == 10);
+  REQUIRE(skipped == 0);
+}
+
+TEST_CASE("ConcurrentRuns.Subflow" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+
+  std::atomic<size_t> counter {0};
+
+  auto A = taskflow.emplace([&](tf::Subflow& sf){
+    for(int i=0; i<10; i++) {
+      sf.emplace([&](){ counter++; });
+    }
+  });
+  auto B = taskflow.emplace([&](tf::Runtime& rt){
+    for(int i=0; i<10; i++) {
+      rt.silent_async([&](){ counter++; });
+    }
+    rt.corun_all();
+  });
+  A.precede(B);
+
+  for(int i=0; i<10; i++) {
+    executor.run_n(taskflow, 10);
+  }
+  executor.wait_for_all();
+
+  REQUIRE(counter == 10*10*20);
+}
+
+TEST_CASE("ConcurrentRuns.Exception" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+
+  taskflow.emplace([](){ throw std::runtime_error("x"); });
+
+  std::vector<tf::Future<void>> futures;
+  for(int i=0; i<10; i++) {
+    futures.push_back(executor.run(taskflow));
+  }
+  for(auto& fu : futures) {
+    REQUIRE_THROWS_WITH_AS(fu.get(), "x", std::runtime_error);
+  }
+}
+
+struct ConcurrentRunsNames : public tf::ObserverInterface {
+  std::mutex mutex;
+  std::multiset<std::string> names;
+  void set_up(size_t) override final {}
+  void on_entry(tf::WorkerView, tf::TaskView tv) override final {
+    std::lock_guard<std::mutex> lock(mutex);
+    names.insert(tv.name());
+  }
+  void on_exit(tf::WorkerView, tf::TaskView) override final {}
+};
+
+TEST_CASE("ConcurrentRuns.Reuse" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+  taskflow.concurrent_runs(true);
+
+  auto observer = executor.make_observer<ConcurrentRunsNames>();
+
+  std::atomic<size_t> counter {0};
+
+  auto A = taskflow.emplace([&](){ counter++; }).name("A");
+  auto B = taskflow.emplace([&](){ counter++; }).name("B");
+  A.precede(B);
+
+  auto run_all = [&](size_t R){
+    std::vector<tf::Future<void>> futures;
+    for(size_t r=0; r<R; r++) {
+      futures.push_back(executor.run(taskflow));
+    }
+    for(auto& fu : futures) {
+      fu.get();
+    }
+  };
+
+  // the tasks of finished runs are reused by the subsequent runs
+  for(size_t i=0; i<10; i++) {
+    run_all(8);
+  }
+  REQUIRE(counter == 80*2);
+  REQUIRE(observer->names.count("A") == 80);
+  REQUIRE(observer->names.count("B") == 80);
+
+  // a modified task is never run with the tasks of the old graph
+  counter = 0;
+  observer->names.clear();
+  B.name("B2");
+  auto C = taskflow.emplace([&](){ counter++; }).name("C");
+  B.precede(C);
+  run_all(8);
+  REQUIRE(counter == 8*3);
+  REQUIRE(observer->names.count("B") == 0);
+  REQUIRE(observer->names.count("B2") == 8);
+  REQUIRE(observer->names.count("C") == 8);
+}
+
+TEST_CASE("ConcurrentRuns.Module" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow1, taskflow2;
+
+  taskflow1.emplace([](){});
+  taskflow2.composed_of(taskflow1);
+  taskflow2.concurrent_runs(true);
+
+  REQUIRE_THROWS_AS(executor.run(taskflow2), std::runtime_error);
+
+  // the failed submission leaves nothing behind to wait for
+  executor.wait_for_all();
+
+  taskflow2.concurrent_runs(false);
+  executor.run(taskflow2).wait();
+}
+
+// --------------------------------------------------------
+// Testcase: RunHandle
+// --------------------------------------------------------
+
+void run_handle(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  auto A = taskflow.emplace([&](){ counter++; });
+  auto B = taskflow.emplace([&](){ counter++; });
+  auto C = taskflow.emplace([&](){ counter++; });
+  A.precede(B, C);
+
+  // submit and wait one after another
+  for(size_t i=0; i<100; i++) {
+    auto handle = executor.submit(taskflow);
+    REQUIRE(handle.valid());
+    handle.wait();
+    REQUIRE(handle.done());
+  }
+  REQUIRE(counter == 300);
+
+  // queue up submissions of the same taskflow from many threads
+  counter = 0;
+  std::vector<std::thread> threads;
+  for(size_t t=0; t<4; t++) {
+    threads.emplace_back([&](){
+      std::vector<tf::RunHandle> handles;
+      for(size_t i=0; i<100; i++) {
+        handles.push_back(executor.submit_n(taskflow, 2));
+      }
+      for(auto& handle : handles) {
+        handle.get();
+      }
+    });
+  }
+  for(auto& t : threads) {
+    t.join();
+  }
+  REQUIRE(counter == 4*100*2*3);
+
+  // run until with a callback
+  counter = 0;
+  size_t calls = 0;
+  executor.submit_until(
+    taskflow, [n=5]() mutable { return n-- == 0; }, [&](){ calls++; }
+  ).wait();
+  REQUIRE(counter == 15);
+  REQUIRE(calls == 1);
+
+  // handles and futures of the same taskflow interleave
+  counter = 0;
+  auto fu = executor.run_n(taskflow, 10);
+  auto handle = executor.submit_n(taskflow, 10);
+  handle.wait();
+  fu.wait();
+  REQUIRE(counter == 60);
+
+  // concurrent runs complete through handles too
+  counter = 0;
+  taskflow.concurrent_runs(true);
+  std::vector<tf::RunHandle> handles;
+  for(size_t i=0; i<100; i++) {
+    handles.push_back(executor.submit(taskflow));
+  }
+  for(auto& h : handles) {
+    h.get();
+  }
+  REQUIRE(counter == 300);
+}
+
+TEST_CASE("RunHandle.1thread" * doctest::timeout(300)) {
+  run_handle(1);
+}
+
+TEST_CASE("RunHandle.2threads" * doctest::timeout(300)) {
+  run_handle(2);
+}
+
+TEST_CASE("RunHandle.4threads" * doctest::timeout(300)) {
+  run_handle(4);
+}
+
+TEST_CASE("RunHandle.8threads" * doctest::timeout(300)) {
+  run_handle(8);
+}
+
+TEST_CASE("RunHandle.Empty" * doctest::timeout(300)) {
+
+  tf::Executor executor(2);
+  tf::Taskflow taskflow;
+
+  tf::RunHandle handle;
+  REQUIRE(!handle.valid());
+  REQUIRE(handle.done());
+  REQUIRE(!handle.cancel());
+  handle.get();
+
+  // an empty taskflow completes immediately but still invokes the callback
+  size_t calls = 0;
+  handle = executor.submit_until(taskflow, [](){ return false; }, [&](){ calls++; });
+  REQUIRE(!handle.valid());
+  REQUIRE(handle.done());
+  REQUIRE(calls == 1);
+
+  // so does a predicate that is already satisfied
+  taskflow.emplace([](){ FAIL("must not run"); });
+  handle = executor.submit_n(taskflow, 0);
+  REQUIRE(!handle.valid());
+  REQUIRE(executor.num_topologies() == 0);
+}
+
+TEST_CASE("RunHandle.Exception" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  taskflow.emplace([](){ throw std::runtime_error("x"); });
+
+  auto handle = executor.submit(taskflow);
+  REQUIRE_THROWS_WITH_AS(handle.get(), "x", std::runtime_error);
+
+  // the exception stays with the handle
+  REQUIRE_THROWS_WITH_AS(handle.get(), "x", std::runtime_error);
+
+  // the exception of a run does not leak into the next run
+  taskflow.clear();
+  taskflow.emplace([](){});
+  executor.submit(taskflow).get();
+}
+
+TEST_CASE("RunHandle.Cancel" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([&](){
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      counter++;
+    });
+  }
+
+  auto handle = executor.submit_n(taskflow, 1000);
+  REQUIRE(handle.cancel());
+  handle.wait();
+  REQUIRE(counter < 100*1000);
+  REQUIRE(!handle.cancel());
+}
@@ -0,0 +1,419 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+
+#if __cplusplus >= TF_CPP20
+
+// ----------------------------------------------------------------------------
+// AsyncTask: a coroutine awaiting async tasks does not block its worker,
+// so a single worker runs both the coroutine and the awaited tasks
+// ----------------------------------------------------------------------------
+
+void coroutines_async_task(unsigned W) {
+
+  tf::Executor executor(W);
+
+  const size_t N = 100;
+
+  std::vector<std::future<size_t>> futures;
+
+  for(size_t i=0; i<N; i++) {
+    futures.push_back(executor.async([&executor, i]() -> tf::Coro<size_t> {
+      size_t sum = 0;
+      for(size_t j=0; j<=i%10; j++) {
+        auto task = executor.silent_dependent_async([&sum, j](){ sum += j; });
+        co_await task;
+      }
+      co_return sum;
+    }));
+  }
+
+  for(size_t i=0; i<N; i++) {
+    auto k = i % 10;
+    REQUIRE(futures[i].get() == k * (k + 1) / 2);
+  }
+
+  // awaiting a finished or an empty task does not suspend
+  std::atomic<size_t> counter {0};
+  executor.silent_async([&]() -> tf::Coro<void> {
+    auto task = executor.silent_dependent_async([&](){ counter++; });
+    co_await task;
+    co_await task;
+    co_await tf::AsyncTask();
+    counter++;
+  });
+  executor.wait_for_all();
+  REQUIRE(counter == 2);
+}
+
+TEST_CASE("Coroutines.AsyncTask.1thread" * doctest::timeout(300)) {
+  coroutines_async_task(1);
+}
+
+TEST_CASE("Coroutines.AsyncTask.2threads" * doctest::timeout(300)) {
+  coroutines_async_task(2);
+}
+
+TEST_CASE("Coroutines.AsyncTask.4threads" * doctest::timeout(300)) {
+  coroutines_async_task(4);
+}
+
+// ----------------------------------------------------------------------------
+// Nested: coroutines awaiting coroutines, with results and exceptions
+// ----------------------------------------------------------------------------
+
+tf::Coro<int> coroutines_fibonacci(tf::Executor& executor, int n) {
+  if(n < 2) {
+    co_return n;
+  }
+  int x = 0;
+  auto task = executor.silent_dependent_async([&x](){ x = 1; });
+  co_await task;
+  int a = co_await coroutines_fibonacci(executor, n-1);
+  int b = co_await coroutines_fibonacci(executor, n-2);
+  co_return a + b + x - 1;
+}
+
+tf::Coro<void> coroutines_throw(tf::Executor& executor) {
+  co_await executor.silent_dependent_async([](){});
+  throw std::runtime_error("x");
+}
+
+void coroutines_nested(unsigned W) {
+
+  tf::Executor executor(W);
+
+  auto f1 = executor.async([&]() -> tf::Coro<int> {
+    co_return co_await coroutines_fibonacci(executor, 15);
+  });
+  REQUIRE(f1.get() == 610);
+
+  // an exception of a nested coroutine is rethrown at the co_await
+  auto f2 = executor.async([&]() -> tf::Coro<bool> {
+    try {
+      co_await coroutines_throw(executor);
+    }
+    catch(const std::runtime_error& e) {
+      co_return std::string(e.what()) == "x";
+    }
+    co_return false;
+  });
+  REQUIRE(f2.get());
+
+  // an exception escaping the coroutine goes to the future
+  auto f3 = executor.async([&]() -> tf::Coro<void> {
+    co_await coroutines_throw(executor);
+  });
+  REQUIRE_THROWS_WITH_AS(f3.get(), "x", std::runtime_error);
+
+  // move-only results
+  auto f4 = executor.async([]() -> tf::Coro<std::unique_ptr<int>> {
+    co_return std::make_unique<int>(4);
+  });
+  REQUIRE(*f4.get() == 4);
+}
+
+TEST_CASE("Coroutines.Nested.1thread" * doctest::timeout(300)) {
+  coroutines_nested(1);
+}
+
+TEST_CASE("Coroutines.Nested.4threads" * doctest::timeout(300)) {
+  coroutines_nested(4);
+}
+
+// ----------------------------------------------------------------------------
+// Future: a coroutine awaiting the run of another taskflow
+// ----------------------------------------------------------------------------
+
+void coroutines_future(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow inner;
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<10; i++) {
+    inner.emplace([&](){ counter++; });
+  }
+
+  const size_t N = 20;
+
+  auto fu = executor.async([&]() -> tf::Coro<size_t> {
+    for(size_t i=0; i<N; i++) {
+      co_await executor.run(inner);
+      auto fu1 = executor.run_n(inner, 2);
+      co_await fu1;
+    }
+    co_return counter.load();
+  });
+
+  REQUIRE(fu.get() == 30*N);
+
+  // exceptions of the run are rethrown at the co_await
+  tf::Taskflow faulty;
+  faulty.emplace([](){ throw std::runtime_error("y"); });
+
+  auto fu2 = executor.async([&]() -> tf::Coro<void> {
+    co_await executor.run(faulty);
+  });
+  REQUIRE_THROWS_WITH_AS(fu2.get(), "y", std::runtime_error);
+
+  // the run of an empty taskflow is ready right away
+  tf::Taskflow empty;
+  auto fu3 = executor.async([&]() -> tf::Coro<int> {
+    co_await executor.run(empty);
+    co_return 3;
+  });
+  REQUIRE(fu3.get() == 3);
+}
+
+TEST_CASE("Coroutines.Future.1thread" * doctest::timeout(300)) {
+  coroutines_future(1);
+}
+
+TEST_CASE("Coroutines.Future.4threads" * doctest::timeout(300)) {
+  coroutines_future(4);
+}
+
+// ----------------------------------------------------------------------------
+// AsyncFuture: a coroutine awaiting the future of an async task, which
+// resumes the coroutine as the task finishes
+// ----------------------------------------------------------------------------
+
+void coroutines_async_future(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Executor other(1);
+
+  const size_t N = 100;
+
+  std::atomic<bool> flag {false};
+
+  auto fu = executor.async([&]() -> tf::Coro<size_t> {
+    size_t sum = 0;
+    for(size_t i=0; i<N; i++) {
+      sum += co_await executor.async([i](){ return i; });
+    }
+    // the task of the other executor needs the workers of this executor
+    // to run a task while the coroutine awaits
+    auto fu1 = other.async([&](){
+      while(!flag);
+      return size_t{1};
+    });
+    executor.silent_async([&](){ flag = true; });
+    sum += co_await fu1;
+    // the future of a dependent async task
+    auto [task, fu3] = executor.dependent_async([](){ return size_t{2}; });
+    sum += co_await fu3;
+    co_return sum;
+  });
+  REQUIRE(fu.get() == N*(N-1)/2 + 3);
+
+  // exceptions of the async task are rethrown at the co_await
+  auto fu2 = executor.async([&]() -> tf::Coro<void> {
+    co_await executor.async([](){ throw std::runtime_error("z"); });
+  });
+  REQUIRE_THROWS_WITH_AS(fu2.get(), "z", std::runtime_error);
+}
+
+TEST_CASE("Coroutines.AsyncFuture.1thread" * doctest::timeout(300)) {
+  coroutines_async_future(1);
+}
+
+TEST_CASE("Coroutines.AsyncFuture.4threads" * doctest::timeout(300)) {
+  coroutines_async_future(4);
+}
+
+// ----------------------------------------------------------------------------
+// DroppedFuture: a coroutine awaiting the future of a timed task that the
+// destruction of the executor drops
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Coroutines.DroppedFuture" * doctest::timeout(300)) {
+
+  std::atomic<bool> broken {false};
+  {
+    tf::Executor executor(2);
+    executor.silent_async([&]() -> tf::Coro<void> {
+      try {
+        co_await executor.async_after(std::chrono::hours(1), [](){ return 1; });
+      }
+      catch(const std::future_error& e) {
+        broken = (e.code() == std::future_errc::broken_promise);
+      }
+    });
+  }
+  REQUIRE(broken == true);
+}
+
+// ----------------------------------------------------------------------------
+// Taskflow: coroutine tasks in a graph, rerun and run concurrently
+// ----------------------------------------------------------------------------
+
+void coroutines_taskflow(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+  tf::Taskflow child;
+
+  std::atomic<size_t> num_children {0};
+  for(size_t i=0; i<8; i++) {
+    child.emplace([&](){ num_children++; });
+  }
+
+  std::atomic<size_t> counter {0};
+
+  auto A = taskflow.emplace([&](){ counter++; });
+  auto B = taskflow.emplace([&]() -> tf::Coro<void> {
+    REQUIRE(counter % 4 == 1);
+    co_await executor.silent_dependent_async([&](){ counter++; });
+    co_await tf::corun(child);
+    REQUIRE(num_children % 8 == 0);
+    counter++;
+  });
+  auto C = taskflow.emplace([&](){
+    REQUIRE(counter % 4 == 3);
+    counter++;
+  });
+  A.precede(B);
+  B.precede(C);
+
+  REQUIRE(B.type() == tf::TaskType::COROUTINE);
+
+  for(size_t r=1; r<=10; r++) {
+    counter = 0;
+    executor.run(taskflow).wait();
+    REQUIRE(counter == 4);
+    REQUIRE(num_children == 8*r);
+  }
+
+  counter = 0;
+  executor.run_n(taskflow, 3).wait();
+  REQUIRE(counter == 12);
+  REQUIRE(num_children == 8*13);
+
+  // concurrent runs each run a coroutine of their own
+  tf::Taskflow concurrent;
+  std::atomic<size_t> num_coroutines {0};
+  concurrent.emplace([&]() -> tf::Coro<void> {
+    co_await executor.silent_dependent_async([](){});
+    num_coroutines++;
+  });
+
+  std::vector<tf::Future<void>> futures;
+  for(size_t i=0; i<100; i++) {
+    futures.push_back(executor.run(concurrent));
+  }
+  for(auto& fu : futures) {
+    fu.get();
+  }
+  REQUIRE(num_coroutines == 100);
+}
+
+TEST_CASE("Coroutines.Taskflow.1thread" * doctest::timeout(300)) {
+  coroutines_taskflow(1);
+}
+
+TEST_CASE("Coroutines.Taskflow.2threads" * doctest::timeout(300)) {
+  coroutines_taskflow(2);
+}
+
+TEST_CASE("Coroutines.Taskflow.4threads" * doctest::timeout(300)) {
+  coroutines_taskflow(4);
+}
+
+// ----------------------------------------------------------------------------
+// Exception: exceptions of coroutine tasks and of their coruns
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Coroutines.Exception" * doctest::timeout(300)) {
+
+  tf::Executor executor(2);
+
+  // an exception escaping a coroutine task cancels its taskflow
+  tf::Taskflow taskflow1;
+  std::atomic<size_t> counter {0};
+  auto A = taskflow1.emplace([&]() -> tf::Coro<void> {
+    co_await executor.silent_dependent_async([](){});
+    throw std::runtime_error("a");
+  });
+  auto B = taskflow1.emplace([&](){ counter++; });
+  A.precede(B);
+  REQUIRE_THROWS_WITH_AS(executor.run(taskflow1).get(), "a", std::runtime_error);
+  REQUIRE(counter == 0);
+
+  // an exception of a corun target is rethrown at the co_await
+  tf::Taskflow faulty;
+  faulty.emplace([](){ throw std::runtime_error("b"); });
+
+  tf::Taskflow taskflow2;
+  taskflow2.emplace([&]() -> tf::Coro<void> {
+    try {
+      co_await tf::corun(faulty);
+    }
+    catch(const std::runtime_error& e) {
+      REQUIRE(std::string(e.what()) == "b");
+      counter++;
+    }
+  });
+  executor.run(taskflow2).get();
+  REQUIRE(counter == 1);
+
+  auto fu = executor.async([&]() -> tf::Coro<void> {
+    co_await tf::corun(faulty);
+  });
+  REQUIRE_THROWS_WITH_AS(fu.get(), "b", std::runtime_error);
+}
+
+// ----------------------------------------------------------------------------
+// Many: many coroutines suspended at the same time
+// ----------------------------------------------------------------------------
+
+void coroutines_many(unsigned W) {
+
+  tf::Executor executor(W);
+
+  const size_t N = 10000;
+
+  std::atomic<bool> go {false};
+  std::atomic<size_t> counter {0};
+
+  // a gate that every coroutine waits for
+  auto gate = executor.silent_dependent_async([&](){
+    while(!go);
+  });
+
+  for(size_t i=0; i<N; i++) {
+    executor.silent_async([&, gate]() -> tf::Coro<void> {
+      co_await gate;
+      counter++;
+    });
+  }
+
+  go = true;
+  executor.wait_for_all();
+  REQUIRE(counter == N);
+
+  // coroutines spawned by a runtime
+  counter = 0;
+  executor.async([&](tf::Runtime& rt){
+    for(size_t i=0; i<N; i++) {
+      rt.silent_async([&]() -> tf::Coro<void> {
+        co_await executor.silent_dependent_async([](){});
+        counter++;
+      });
+    }
+    rt.corun();
+  }).get();
+  REQUIRE(counter == N);
+}
+
+TEST_CASE("Coroutines.Many.1thread" * doctest::timeout(300)) {
+  coroutines_many(1);
+}
+
+TEST_CASE("Coroutines.Many.4threads" * doctest::timeout(300)) {
+  coroutines_many(4);
+}
+
+#endif
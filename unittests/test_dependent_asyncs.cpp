@@ -1248,3 +1248,224 @@ TEST_CASE("SilentDependentAsync.MixedAlgorithms.8threads" * doctest::timeout(300
 }
 
 
+
+// ----------------------------------------------------------------------------
+// Hot Predecessor
+// ----------------------------------------------------------------------------
+
+// threads link successors to the same predecessor while it finishes,
+// and a sink task fans in all successors
+void hot_predecessor(unsigned W) {
+
+  const size_t T = 4;
+  const size_t N = 10000;
+
+  tf::Executor executor(W);
+
+  std::atomic<size_t> counter {0};
+  std::atomic<size_t> ready {0};
+
+  auto hot = executor.silent_dependent_async([&](){
+    while(ready != T);
+  });
+
+  std::vector<std::vector<tf::AsyncTask>> successors(T);
+  std::vector<std::thread> threads;
+
+  for(size_t t=0; t<T; t++) {
+    threads.emplace_back([&, t](){
+      ++ready;
+      for(size_t i=0; i<N; i++) {
+        successors[t].push_back(executor.silent_dependent_async([&](){
+          REQUIRE(hot.is_done());
+          counter.fetch_add(1, std::memory_order_relaxed);
+        }, hot));
+      }
+    });
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  std::vector<tf::AsyncTask> all;
+  for(auto& s : successors) {
+    all.insert(all.end(), s.begin(), s.end());
+  }
+
+  auto sink = executor.silent_dependent_async([&](){
+    REQUIRE(counter == T*N);
+  }, all.begin(), all.end());
+
+  sink.wait();
+  
+  executor.wait_for_all();
+
+  REQUIRE(counter == T*N);
+}
+
+TEST_CASE("DependentAsync.HotPredecessor.1thread" * doctest::timeout(300)) {
+  hot_predecessor(1);
+}
+
+TEST_CASE("DependentAsync.HotPredecessor.2threads" * doctest::timeout(300)) {
+  hot_predecessor(2);
+}
+
+TEST_CASE("DependentAsync.HotPredecessor.4threads" * doctest::timeout(300)) {
+  hot_predecessor(4);
+}
+
+TEST_CASE("DependentAsync.HotPredecessor.8threads" * doctest::timeout(300)) {
+  hot_predecessor(8);
+}
+
+// ----------------------------------------------------------------------------
+// When All
+// ----------------------------------------------------------------------------
+
+void when_all(unsigned W) {
+
+  const int N = 1000;
+
+  tf::Executor executor(W);
+
+  std::atomic<int> counter {0};
+
+  // range of async tasks
+  std::vector<tf::AsyncTask> tasks;
+  for(int i=0; i<N; i++) {
+    tasks.push_back(executor.silent_dependent_async([&](){ counter++; }));
+  }
+  auto [A, fuA] = executor.when_all(tasks.begin(), tasks.end());
+  fuA.get();
+  A.wait();
+  REQUIRE(A.is_done());
+  REQUIRE(counter == N);
+
+  // range of async tasks and futures
+  std::vector<std::pair<tf::AsyncTask, tf::Future<int>>> pairs;
+  for(int i=0; i<N; i++) {
+    pairs.push_back(executor.dependent_async([i](){ return i; }));
+  }
+  auto [B, fuB] = executor.when_all(pairs.begin(), pairs.end());
+  auto results = fuB.get();
+  REQUIRE(results.size() == N);
+  for(int i=0; i<N; i++) {
+    REQUIRE(results[i] == i);
+  }
+
+  // the combined task as a dependency of other tasks
+  std::vector<std::pair<tf::AsyncTask, tf::Future<void>>> voids;
+  for(int i=0; i<N; i++) {
+    voids.push_back(executor.dependent_async([&](){ counter++; }));
+  }
+  auto [C, fuC] = executor.when_all(voids.begin(), voids.end());
+  executor.silent_dependent_async([&](){ REQUIRE(counter == 2*N); }, C);
+
+  // empty range
+  auto [D, fuD] = executor.when_all(tasks.end(), tasks.end());
+  fuD.get();
+
+  // exception
+  std::vector<std::pair<tf::AsyncTask, tf::Future<int>>> throws;
+  throws.push_back(executor.dependent_async([](){ return 1; }));
+  throws.push_back(executor.dependent_async([]() -> int { throw std::runtime_error("x"); }));
+  auto [E, fuE] = executor.when_all(throws.begin(), throws.end());
+  REQUIRE_THROWS_WITH_AS(fuE.get(), "x", std::runtime_error);
+
+  executor.wait_for_all();
+}
+
+TEST_CASE("WhenAll.1thread" * doctest::timeout(300)) {
+  when_all(1);
+}
+
+TEST_CASE("WhenAll.2threads" * doctest::timeout(300)) {
+  when_all(2);
+}
+
+TEST_CASE("WhenAll.4threads" * doctest::timeout(300)) {
+  when_all(4);
+}
+
+TEST_CASE("WhenAll.8threads" * doctest::timeout(300)) {
+  when_all(8);
+}
+
+// ----------------------------------------------------------------------------
+// When Any
+// ----------------------------------------------------------------------------
+
+void when_any(unsigned W) {
+
+  tf::Executor executor(W);
+
+  // hedged query: the fastest replica wins and the others are ignored
+  std::atomic<bool> answered {false};
+  std::vector<std::pair<tf::AsyncTask, tf::Future<int>>> replicas;
+  for(int r=0; r<static_cast<int>(W); r++) {
+    replicas.push_back(executor.dependent_async([r, &answered](){
+      if(r != 0) {
+        while(!answered);
+      }
+      return r + 100;
+    }));
+  }
+  auto [A, fuA] = executor.when_any(replicas.begin(), replicas.end());
+  auto [winner, answer] = fuA.get();
+  REQUIRE(winner == 0);
+  REQUIRE(answer == 100);
+  answered = true;
+  
+  // tasks that have finished before the combinator is created
+  std::vector<tf::AsyncTask> tasks;
+  for(int i=0; i<10; i++) {
+    tasks.push_back(executor.silent_dependent_async([](){}));
+  }
+  executor.wait_for_all();
+  auto [B, fuB] = executor.when_any(tasks.begin(), tasks.end());
+  REQUIRE(fuB.get() == 0);
+
+  // many combinators racing on the same tasks
+  const size_t N = 1000;
+  std::atomic<size_t> counter {0};
+  std::vector<std::pair<tf::AsyncTask, tf::Future<size_t>>> anys;
+  for(size_t i=0; i<N; i++) {
+    tasks.clear();
+    for(size_t j=0; j<4; j++) {
+      tasks.push_back(executor.silent_dependent_async([&](){ counter++; }));
+    }
+    anys.push_back(executor.when_any(tasks.begin(), tasks.end()));
+  }
+  for(auto& [task, fu] : anys) {
+    REQUIRE(fu.get() < 4);
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 4*N);
+
+  // void results and exceptions
+  std::vector<std::pair<tf::AsyncTask, tf::Future<void>>> voids;
+  voids.push_back(executor.dependent_async([](){ throw std::runtime_error("x"); }));
+  auto [C, fuC] = executor.when_any(voids.begin(), voids.end());
+  REQUIRE_THROWS_WITH_AS(fuC.get(), "x", std::runtime_error);
+
+  // empty range
+  REQUIRE_THROWS(executor.when_any(tasks.end(), tasks.end()));
+}
+
+TEST_CASE("WhenAny.1thread" * doctest::timeout(300)) {
+  when_any(1);
+}
+
+TEST_CASE("WhenAny.2threads" * doctest::timeout(300)) {
+  when_any(2);
+}
+
+TEST_CASE("WhenAny.4threads" * doctest::timeout(300)) {
+  when_any(4);
+}
+
+TEST_CASE("WhenAny.8threads" * doctest::timeout(300)) {
+  when_any(8);
+}
@@ -1250,3 +1250,46 @@ TEST_CASE("Exception.Semaphore.4threads" * doctest::timeout(300)) {
   semaphore1(4);
 }
 
+
+// ----------------------------------------------------------------------------
+// Exception in a run that is followed by another run of the same taskflow
+// ----------------------------------------------------------------------------
+
+void queued_runs(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<bool> queued(false);
+
+  taskflow.emplace([&](){
+    // make sure the first run finishes after the second run is queued
+    while(!queued.load()) {
+      std::this_thread::yield();
+    }
+    throw std::runtime_error("x");
+  });
+
+  auto f1 = executor.run(taskflow);
+  auto f2 = executor.run(taskflow);
+  queued = true;
+
+  REQUIRE_THROWS_WITH_AS(f1.get(), "x", std::runtime_error);
+  REQUIRE_THROWS_WITH_AS(f2.get(), "x", std::runtime_error);
+}
+
+TEST_CASE("Exception.QueuedRuns.1thread" * doctest::timeout(300)) {
+  queued_runs(1);
+}
+
+TEST_CASE("Exception.QueuedRuns.2threads" * doctest::timeout(300)) {
+  queued_runs(2);
+}
+
+TEST_CASE("Exception.QueuedRuns.3threads" * doctest::timeout(300)) {
+  queued_runs(3);
+}
+
+TEST_CASE("Exception.QueuedRuns.4threads" * doctest::timeout(300)) {
+  queued_runs(4);
+}
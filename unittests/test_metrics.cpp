@@ -0,0 +1,230 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define TF_ENABLE_SCHEDULER_METRICS
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+
+// ----------------------------------------------------------------------------
+// Executed Tasks
+// ----------------------------------------------------------------------------
+
+void metrics_executed_tasks(unsigned W) {
+
+  tf::Executor executor(W);
+
+  auto metrics = executor.metrics();
+  REQUIRE(metrics.workers.size() == W);
+  REQUIRE(metrics.total().num_executed_tasks == 0);
+
+  tf::Taskflow taskflow;
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<1000; i++) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  executor.run_n(taskflow, 10).wait();
+
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+  executor.wait_for_all();
+
+  REQUIRE(counter == 11000);
+
+  metrics = executor.metrics();
+  auto total = metrics.total();
+
+  REQUIRE(total.num_executed_tasks == 11000);
+
+  // tasks submitted from outside go through the shared buffers,
+  // so at least one of them must have been stolen
+  REQUIRE(total.num_steals > 0);
+  REQUIRE(total.busy_time.count() > 0);
+
+  size_t sum = 0;
+  for(auto& w : metrics.workers) {
+    sum += w.num_executed_tasks;
+  }
+  REQUIRE(sum == total.num_executed_tasks);
+}
+
+TEST_CASE("Metrics.ExecutedTasks.1thread" * doctest::timeout(300)) {
+  metrics_executed_tasks(1);
+}
+
+TEST_CASE("Metrics.ExecutedTasks.2threads" * doctest::timeout(300)) {
+  metrics_executed_tasks(2);
+}
+
+TEST_CASE("Metrics.ExecutedTasks.4threads" * doctest::timeout(300)) {
+  metrics_executed_tasks(4);
+}
+
+TEST_CASE("Metrics.ExecutedTasks.8threads" * doctest::timeout(300)) {
+  metrics_executed_tasks(8);
+}
+
+// ----------------------------------------------------------------------------
+// Overflow
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Metrics.Overflow" * doctest::timeout(300)) {
+
+  tf::Executor executor(1);
+
+  // a worker spawning more tasks than its queue can hold spills them
+  // into the shared buffers
+  const size_t N = 100000;
+  std::atomic<size_t> counter {0};
+
+  executor.silent_async([&](){
+    for(size_t i=0; i<N; i++) {
+      executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+  });
+
+  executor.wait_for_all();
+  REQUIRE(counter == N);
+
+  auto total = executor.metrics().total();
+
+  REQUIRE(total.num_executed_tasks == N + 1);
+  REQUIRE(total.num_overflows > 0);
+  REQUIRE(total.num_overflows < N);
+  REQUIRE(total.num_wakeups == N);
+}
+
+// ----------------------------------------------------------------------------
+// Sleeps
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Metrics.Sleeps" * doctest::timeout(300)) {
+
+  tf::Executor executor(2);
+
+  // workers run out of tasks and eventually go to sleep
+  while(executor.metrics().total().num_sleeps < 2) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto total = executor.metrics().total();
+  REQUIRE(total.num_failed_steals > 0);
+  REQUIRE(total.num_yields > 0);
+  REQUIRE(total.idle_time.count() >= 0);
+  REQUIRE(total.num_executed_tasks == 0);
+}
+
+// ----------------------------------------------------------------------------
+// Affinity: a task mailed to a sleeping worker wakes up that worker only
+// ----------------------------------------------------------------------------
+
+// nonblocking_notifier does not support num_waiters
+#if __cplusplus >= TF_CPP20
+TEST_CASE("Metrics.AffinityWakeup" * doctest::timeout(300)) {
+
+  const size_t W = 4;
+
+  tf::Executor executor(W);
+  executor.affinity_threshold(std::chrono::hours(1));
+
+  // waits until all workers sleep and have counted their sleeps
+  auto all_asleep = [&](){
+    size_t sleeps = 0;
+    while(executor.num_waiters() != W || executor.metrics().total().num_sleeps != sleeps) {
+      sleeps = executor.metrics().total().num_sleeps;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  };
+
+  for(size_t r=0; r<10; r++) {
+
+    all_asleep();
+    auto before = executor.metrics();
+
+    tf::TaskParams params;
+    params.affinity = r % W;
+    std::atomic<int> id {-1};
+    executor.silent_async(params, [&](){ id = executor.this_worker_id(); });
+    executor.wait_for_all();
+    REQUIRE(id == static_cast<int>(r % W));
+
+    all_asleep();
+    auto after = executor.metrics();
+
+    for(size_t i=0; i<W; i++) {
+      if(i == r % W) {
+        REQUIRE(after.workers[i].num_sleeps == before.workers[i].num_sleeps + 1);
+      }
+      else {
+        REQUIRE(after.workers[i].num_sleeps == before.workers[i].num_sleeps);
+      }
+    }
+  }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// BusyPoll: an idle poller takes new tasks without waking up a sleeping worker
+// ----------------------------------------------------------------------------
+
+#if __cplusplus >= TF_CPP20
+TEST_CASE("Metrics.BusyPollWakeup" * doctest::timeout(300)) {
+
+  const size_t W = 4;
+
+  tf::Executor executor(W, nullptr, std::make_shared<tf::BusyPollSpinPolicy>(1));
+
+  // waits until all workers but the poller sleep and have counted their sleeps
+  auto all_asleep = [&](){
+    size_t sleeps = 0;
+    while(executor.num_waiters() != W - 1 || executor.metrics().total().num_sleeps != sleeps) {
+      sleeps = executor.metrics().total().num_sleeps;
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  };
+
+  std::atomic<size_t> counter {0};
+
+  for(size_t r=0; r<10; r++) {
+
+    all_asleep();
+    auto before = executor.metrics();
+
+    executor.silent_async([&](){ counter++; });
+    executor.wait_for_all();
+    REQUIRE(counter == r + 1);
+
+    all_asleep();
+    auto after = executor.metrics();
+
+    REQUIRE(after.workers[0].num_sleeps == 0);
+    REQUIRE(after.workers[0].num_executed_tasks == before.workers[0].num_executed_tasks + 1);
+    for(size_t i=1; i<W; i++) {
+      REQUIRE(after.workers[i].num_sleeps == before.workers[i].num_sleeps);
+    }
+  }
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// Resize
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Metrics.Resize" * doctest::timeout(300)) {
+
+  tf::Executor executor(4, 4);
+
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+  executor.wait_for_all();
+
+  // retired workers keep their counters
+  executor.resize(1);
+
+  auto metrics = executor.metrics();
+  REQUIRE(metrics.workers.size() == 4);
+  REQUIRE(metrics.total().num_executed_tasks == 1000);
+}
@@ -111,3 +111,67 @@ TEST_CASE("RandomPriority.Parallel" * doctest::timeout(300)) {
 
 
 
+
+// ----------------------------------------------------------------------------
+// Fan-out of independent tasks with random priorities
+// ----------------------------------------------------------------------------
+
+void random_priority_fan_out(unsigned W) {
+  
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  const auto MAX_P = static_cast<unsigned>(tf::TaskPriority::MAX);
+  const size_t N = 10000;
+
+  std::atomic<size_t> counters[MAX_P];
+  size_t priorities[MAX_P];
+
+  for(unsigned p=0; p<MAX_P; p++) {
+    counters[p] = 0;
+    priorities[p] = 0;
+  }
+
+  // sources scheduled from the caller thread
+  for(size_t i=0; i<N; i++) {
+    unsigned p = ::rand() % MAX_P;
+    taskflow.emplace([p, &counters](){ counters[p]++; })
+            .priority(static_cast<tf::TaskPriority>(p));
+    priorities[p]++;
+  }
+
+  // children scheduled from a worker in runs of equal priority
+  taskflow.emplace([&](tf::Subflow& sf){
+    for(size_t i=0; i<N; i++) {
+      unsigned p = (i / 7) % MAX_P;
+      sf.emplace([p, &counters](){ counters[p]++; })
+        .priority(static_cast<tf::TaskPriority>(p));
+    }
+  });
+
+  for(size_t i=0; i<N; i++) {
+    priorities[(i / 7) % MAX_P]++;
+  }
+
+  executor.run_n(taskflow, 3).wait();
+
+  for(unsigned p=0; p<MAX_P; p++) {
+    REQUIRE(counters[p] == 3*priorities[p]);
+  }
+}
+
+TEST_CASE("RandomPriority.FanOut.1thread" * doctest::timeout(300)) {
+  random_priority_fan_out(1);
+}
+
+TEST_CASE("RandomPriority.FanOut.2threads" * doctest::timeout(300)) {
+  random_priority_fan_out(2);
+}
+
+TEST_CASE("RandomPriority.FanOut.4threads" * doctest::timeout(300)) {
+  random_priority_fan_out(4);
+}
+
+TEST_CASE("RandomPriority.FanOut.8threads" * doctest::timeout(300)) {
+  random_priority_fan_out(8);
+}
@@ -375,6 +375,373 @@ TEST_CASE("UnboundedTSQ.8Consumers" * doctest::timeout(300)) {
   unbounded_tsq_n_consumers(8);
 }
 
+// ----------------------------------------------------------------------------
+// Bulk Push
+// ----------------------------------------------------------------------------
+
+// Procedure: bounded_tsq_bulk_push
+template <size_t LogSize>
+void bounded_tsq_bulk_push() {
+
+  tf::BoundedTaskQueue<size_t*, LogSize> queue;
+
+  constexpr size_t C = (1 << LogSize);
+
+  std::vector<size_t> data(3*C);
+  std::vector<size_t*> gold(data.size());
+  for(size_t i=0; i<data.size(); ++i) {
+    gold[i] = &data[i];
+  }
+
+  // m items already in the queue before pushing n items in bulk
+  for(size_t m=0; m<=C; ++m) {
+    for(size_t n=0; n<=2*C; ++n) {
+
+      REQUIRE(queue.empty());
+
+      for(size_t i=0; i<m; ++i) {
+        REQUIRE(queue.try_push(gold[i]) == true);
+      }
+
+      size_t num_full = 0;
+      size_t num_rest = 0;
+      size_t* first_rest = nullptr;
+
+      queue.bulk_push(gold.begin() + m, n, [&](auto rest, size_t k){
+        ++num_full;
+        num_rest = k;
+        first_rest = rest[0];
+      });
+
+      size_t num_pushed = std::min(n, C - m);
+
+      REQUIRE(queue.size() == m + num_pushed);
+      REQUIRE(num_full == (num_pushed < n ? 1 : 0));
+      REQUIRE(num_rest == n - num_pushed);
+      REQUIRE(first_rest == (num_pushed < n ? gold[m + num_pushed] : nullptr));
+
+      // steal the first half in FIFO order and pop the rest in LIFO order
+      size_t total = m + num_pushed;
+      for(size_t i=0; i<total/2; ++i) {
+        REQUIRE(queue.steal() == gold[i]);
+      }
+      for(size_t i=total; i>total/2; --i) {
+        REQUIRE(queue.pop() == gold[i-1]);
+      }
+      REQUIRE(queue.pop() == nullptr);
+      REQUIRE(queue.steal() == nullptr);
+    }
+  }
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.LogSize=2" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push<2>();
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.LogSize=3" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push<3>();
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.LogSize=4" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push<4>();
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.LogSize=5" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push<5>();
+}
+
+// Procedure: unbounded_tsq_bulk_push
+void unbounded_tsq_bulk_push() {
+
+  std::vector<size_t> data(100000);
+  std::vector<size_t*> gold(data.size());
+  for(size_t i=0; i<data.size(); ++i) {
+    gold[i] = &data[i];
+  }
+
+  // m items already in the queue before pushing n items in bulk
+  for(size_t m=0; m<=100; m=m*2+1) {
+    for(size_t n=0; m+n<=gold.size(); n=n*3+1) {
+
+      tf::UnboundedTaskQueue<size_t*> queue(2);
+
+      for(size_t i=0; i<m; ++i) {
+        queue.push(gold[i]);
+      }
+      queue.bulk_push(gold.begin() + m, n);
+
+      REQUIRE(queue.size() == m + n);
+      REQUIRE(queue.capacity() >= static_cast<int64_t>(m + n));
+
+      // steal the first half in FIFO order and pop the rest in LIFO order
+      size_t total = m + n;
+      for(size_t i=0; i<total/2; ++i) {
+        REQUIRE(queue.steal() == gold[i]);
+      }
+      for(size_t i=total; i>total/2; --i) {
+        REQUIRE(queue.pop() == gold[i-1]);
+      }
+      REQUIRE(queue.pop() == nullptr);
+      REQUIRE(queue.empty());
+    }
+  }
+}
+
+TEST_CASE("UnboundedTSQ.BulkPush" * doctest::timeout(300)) {
+  unbounded_tsq_bulk_push();
+}
+
+// Procedure: bounded_tsq_bulk_push_n_consumers
+void bounded_tsq_bulk_push_n_consumers(size_t M) {
+
+  tf::BoundedTaskQueue<size_t*> queue;
+
+  const size_t N = 100000;
+
+  std::vector<size_t> data(N);
+  std::vector<size_t*> gold(N);
+  for(size_t i=0; i<N; ++i) {
+    gold[i] = &data[i];
+  }
+
+  std::atomic<size_t> consumed {0};
+
+  // thieves
+  std::vector<std::thread> threads;
+  std::vector<std::vector<size_t*>> stolens(M);
+  for(size_t i=0; i<M; ++i) {
+    threads.emplace_back([&, i](){
+      while(consumed != N) {
+        auto ptr = queue.steal();
+        if(ptr != nullptr) {
+          stolens[i].push_back(ptr);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+
+  // master thread pushes chunks of growing sizes and pops some items 
+  std::vector<size_t*> items;
+  for(size_t i=0, k=1; i<N; k=k%1000+1) {
+    size_t n = std::min(k, N-i);
+    size_t num_pushed = n;
+    queue.bulk_push(gold.begin() + i, n, [&](auto, size_t rest){
+      num_pushed = n - rest;
+    });
+    i += num_pushed;
+    if(auto ptr = queue.pop(); ptr != nullptr) {
+      items.push_back(ptr);
+      consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  while(consumed != N) {
+    if(auto ptr = queue.pop(); ptr != nullptr) {
+      items.push_back(ptr);
+      consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  for(auto& thread : threads) thread.join();
+
+  REQUIRE(queue.empty());
+
+  for(size_t i=0; i<M; ++i) {
+    items.insert(items.end(), stolens[i].begin(), stolens[i].end());
+  }
+
+  std::sort(items.begin(), items.end());
+  REQUIRE(items == gold);
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.1Consumer" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push_n_consumers(1);
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.2Consumers" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push_n_consumers(2);
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.4Consumers" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push_n_consumers(4);
+}
+
+TEST_CASE("BoundedTSQ.BulkPush.8Consumers" * doctest::timeout(300)) {
+  bounded_tsq_bulk_push_n_consumers(8);
+}
+
+// ----------------------------------------------------------------------------
+// Steal Batch
+// ----------------------------------------------------------------------------
+
+// Procedure: tsq_push
+template <typename Q, typename T>
+void tsq_push(Q& queue, T item) {
+  if constexpr (std::is_same_v<Q, tf::UnboundedTaskQueue<T>>) {
+    queue.push(item);
+  }
+  else {
+    while(!queue.try_push(item));
+  }
+}
+
+// Procedure: tsq_steal_batch
+template <typename Q>
+void tsq_steal_batch(Q& queue) {
+
+  std::vector<size_t> data(1000);
+  std::vector<size_t*> gold(data.size());
+  for(size_t i=0; i<data.size(); ++i) {
+    gold[i] = &data[i];
+  }
+
+  tf::BoundedTaskQueue<size_t*, 4> dst;
+  
+  REQUIRE(queue.steal_batch(dst) == nullptr);
+  REQUIRE(dst.empty());
+
+  for(size_t N=1; N<=std::min(gold.size(), static_cast<size_t>(queue.capacity())); N=N*2+1) {
+
+    for(size_t i=0; i<N; ++i) {
+      tsq_push(queue, gold[i]);
+    }
+
+    // the first item is returned and half of the rest are moved to dst
+    REQUIRE(queue.steal_batch(dst) == gold[0]);
+
+    size_t n = std::min((N-1)/2, dst.capacity());
+    REQUIRE(dst.size() == n);
+    REQUIRE(queue.size() == N - 1 - n);
+
+    // stolen items keep their order
+    for(size_t i=0; i<n; ++i) {
+      REQUIRE(dst.steal() == gold[1+i]);
+    }
+    for(size_t i=1+n; i<N; ++i) {
+      REQUIRE(queue.steal() == gold[i]);
+    }
+    REQUIRE(queue.empty());
+    REQUIRE(dst.empty());
+  }
+
+  // dst has limited space
+  for(size_t i=0; i<dst.capacity()-1; ++i) {
+    REQUIRE(dst.try_push(gold[i]));
+  }
+  for(size_t i=0; i<100; ++i) {
+    tsq_push(queue, gold[i]);
+  }
+  REQUIRE(queue.steal_batch(dst) == gold[0]);
+  REQUIRE(dst.size() == dst.capacity());
+  REQUIRE(queue.size() == 98);
+}
+
+TEST_CASE("BoundedTSQ.StealBatch" * doctest::timeout(300)) {
+  tf::BoundedTaskQueue<size_t*> queue;
+  tsq_steal_batch(queue);
+}
+
+TEST_CASE("UnboundedTSQ.StealBatch" * doctest::timeout(300)) {
+  tf::UnboundedTaskQueue<size_t*> queue;
+  tsq_steal_batch(queue);
+}
+
+// Procedure: tsq_steal_batch_n_consumers
+// the owner pushes and pops while M thieves steal in batches into their own 
+// queues and drain them
+template <typename Q>
+void tsq_steal_batch_n_consumers(size_t M) {
+
+  const size_t N = 100000;
+
+  Q queue;
+
+  std::vector<size_t> data(N);
+  std::vector<size_t*> gold(N);
+  for(size_t i=0; i<N; ++i) {
+    gold[i] = &data[i];
+  }
+
+  std::atomic<size_t> consumed {0};
+
+  std::vector<std::thread> threads;
+  std::vector<std::vector<size_t*>> stolens(M);
+  for(size_t i=0; i<M; ++i) {
+    threads.emplace_back([&, i](){
+      tf::BoundedTaskQueue<size_t*> dst;
+      while(consumed != N) {
+        for(auto ptr = queue.steal_batch(dst); ptr != nullptr; ptr = dst.pop()) {
+          stolens[i].push_back(ptr);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      REQUIRE(dst.empty());
+    });
+  }
+
+  std::vector<size_t*> items;
+  for(size_t i=0; i<N; ++i) {
+    tsq_push(queue, gold[i]);
+    if(i % 3 == 0) {
+      if(auto ptr = queue.pop(); ptr != nullptr) {
+        items.push_back(ptr);
+        consumed.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  while(consumed != N) {
+    if(auto ptr = queue.pop(); ptr != nullptr) {
+      items.push_back(ptr);
+      consumed.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  for(auto& thread : threads) thread.join();
+
+  REQUIRE(queue.empty());
+
+  for(size_t i=0; i<M; ++i) {
+    items.insert(items.end(), stolens[i].begin(), stolens[i].end());
+  }
+
+  std::sort(items.begin(), items.end());
+  REQUIRE(items == gold);
+}
+
+TEST_CASE("BoundedTSQ.StealBatch.1Consumer" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::BoundedTaskQueue<size_t*>>(1);
+}
+
+TEST_CASE("BoundedTSQ.StealBatch.2Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::BoundedTaskQueue<size_t*>>(2);
+}
+
+TEST_CASE("BoundedTSQ.StealBatch.4Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::BoundedTaskQueue<size_t*>>(4);
+}
+
+TEST_CASE("BoundedTSQ.StealBatch.8Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::BoundedTaskQueue<size_t*>>(8);
+}
+
+TEST_CASE("UnboundedTSQ.StealBatch.1Consumer" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::UnboundedTaskQueue<size_t*>>(1);
+}
+
+TEST_CASE("UnboundedTSQ.StealBatch.2Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::UnboundedTaskQueue<size_t*>>(2);
+}
+
+TEST_CASE("UnboundedTSQ.StealBatch.4Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::UnboundedTaskQueue<size_t*>>(4);
+}
+
+TEST_CASE("UnboundedTSQ.StealBatch.8Consumers" * doctest::timeout(300)) {
+  tsq_steal_batch_n_consumers<tf::UnboundedTaskQueue<size_t*>>(8);
+}
+
 
 // ----------------------------------------------------------------------------
 // BoundedMPMC
@@ -666,3 +1033,156 @@ TEST_CASE("BoundedMPMC.Pointer.Basics.LogSize=10") {
 }
 
 
+
+TEST_CASE("BoundedMPMC.Pointer.BulkEnqueue") {
+
+  tf::MPMC<int*, 4> mpmc;
+  std::vector<int> data(40);
+  std::vector<int*> ptrs;
+  for(auto& d : data) {
+    ptrs.push_back(&d);
+  }
+
+  // the ring takes as many items as it has free slots
+  REQUIRE(mpmc.try_bulk_enqueue(ptrs.begin(), 10) == 10);
+  REQUIRE(mpmc.size() == 10);
+  REQUIRE(mpmc.try_bulk_enqueue(ptrs.begin() + 10, 10) == 6);
+  REQUIRE(mpmc.size() == 16);
+  REQUIRE(mpmc.try_bulk_enqueue(ptrs.begin() + 16, 10) == 0);
+
+  for(size_t i=0; i<5; i++) {
+    REQUIRE(mpmc.try_dequeue() == ptrs[i]);
+  }
+
+  // wraps around the ring
+  REQUIRE(mpmc.try_bulk_enqueue(ptrs.begin() + 16, 10) == 5);
+
+  for(size_t i=5; i<21; i++) {
+    REQUIRE(mpmc.try_dequeue() == ptrs[i]);
+  }
+  REQUIRE(mpmc.empty() == true);
+  REQUIRE(mpmc.size() == 0);
+}
+
+// ----------------------------------------------------------------------------
+// InjectionQueue
+// ----------------------------------------------------------------------------
+
+TEST_CASE("InjectionQueue.Basics") {
+
+  tf::InjectionQueue<int*, 4> queue;
+  std::vector<int> data(1000);
+
+  REQUIRE(queue.empty() == true);
+  REQUIRE(queue.steal() == nullptr);
+
+  // items beyond the capacity of the ring spill
+  for(auto& d : data) {
+    queue.push(&d);
+  }
+  REQUIRE(queue.size() == data.size());
+  REQUIRE(queue.empty() == false);
+
+  std::set<int*> set;
+  while(!queue.empty()) {
+    auto item = queue.steal();
+    REQUIRE(item != nullptr);
+    REQUIRE(set.insert(item).second == true);
+  }
+  REQUIRE(set.size() == data.size());
+
+  // the same holds for a bulk insertion
+  std::vector<int*> ptrs;
+  for(auto& d : data) {
+    ptrs.push_back(&d);
+  }
+  queue.bulk_push(ptrs.begin(), ptrs.size());
+  REQUIRE(queue.size() == data.size());
+
+  set.clear();
+  tf::BoundedTaskQueue<int*> dst;
+  while(auto item = queue.steal_batch(dst)) {
+    REQUIRE(set.insert(item).second == true);
+    while(auto other = dst.pop()) {
+      REQUIRE(set.insert(other).second == true);
+    }
+  }
+  REQUIRE(set.size() == data.size());
+  REQUIRE(queue.empty() == true);
+}
+
+// Procedure: injection_queue
+// M producers push items, half of them in bulk, while N consumers steal them
+void injection_queue(unsigned M, unsigned N) {
+
+  const size_t P = 10000;
+
+  tf::InjectionQueue<size_t*, 6> queue;
+  std::vector<size_t> data(M*P);
+  std::vector<std::atomic<size_t>> counts(M*P);
+  std::atomic<size_t> consumed {0};
+  std::vector<std::thread> threads;
+
+  for(unsigned n=0; n<N; n++) {
+    threads.emplace_back([&](){
+      tf::BoundedTaskQueue<size_t*> dst;
+      while(consumed != M*P) {
+        auto item = (rand() % 2) ? queue.steal() : queue.steal_batch(dst);
+        while(item) {
+          counts[*item]++;
+          consumed++;
+          item = dst.pop();
+        }
+      }
+    });
+  }
+
+  for(unsigned m=0; m<M; m++) {
+    threads.emplace_back([&, m](){
+      std::vector<size_t*> ptrs;
+      for(size_t i=m*P; i<(m+1)*P; i++) {
+        data[i] = i;
+        if(i % 2) {
+          queue.push(&data[i]);
+        }
+        else {
+          ptrs.push_back(&data[i]);
+          if(ptrs.size() == 16) {
+            queue.bulk_push(ptrs.begin(), ptrs.size());
+            ptrs.clear();
+          }
+        }
+      }
+      queue.bulk_push(ptrs.begin(), ptrs.size());
+    });
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  for(auto& c : counts) {
+    REQUIRE(c == 1);
+  }
+  REQUIRE(queue.empty() == true);
+}
+
+TEST_CASE("InjectionQueue.1P1C" * doctest::timeout(300)) {
+  injection_queue(1, 1);
+}
+
+TEST_CASE("InjectionQueue.4P1C" * doctest::timeout(300)) {
+  injection_queue(4, 1);
+}
+
+TEST_CASE("InjectionQueue.1P4C" * doctest::timeout(300)) {
+  injection_queue(1, 4);
+}
+
+TEST_CASE("InjectionQueue.4P4C" * doctest::timeout(300)) {
+  injection_queue(4, 4);
+}
+
+TEST_CASE("InjectionQueue.8P8C" * doctest::timeout(300)) {
+  injection_queue(8, 8);
+}
@@ -0,0 +1,184 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#define TF_ENABLE_BATCH_STEALING
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+
+// ----------------------------------------------------------------------------
+// Binary Tree
+// ----------------------------------------------------------------------------
+
+void steal_batch_binary_tree(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  std::vector<tf::Task> tasks(1 << 16);
+
+  for(size_t i=1; i<tasks.size(); i++) {
+    tasks[i] = taskflow.emplace([&](){
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+
+  for(size_t i=1; i<tasks.size(); i++) {
+    size_t l = i << 1;
+    size_t r = l + 1;
+    if(r < tasks.size()) {
+      tasks[i].precede(tasks[l], tasks[r]);
+    }
+  }
+
+  executor.run_n(taskflow, 10).wait();
+
+  REQUIRE(counter == 10 * (tasks.size() - 1));
+}
+
+TEST_CASE("StealBatch.BinaryTree.1thread" * doctest::timeout(300)) {
+  steal_batch_binary_tree(1);
+}
+
+TEST_CASE("StealBatch.BinaryTree.2threads" * doctest::timeout(300)) {
+  steal_batch_binary_tree(2);
+}
+
+TEST_CASE("StealBatch.BinaryTree.4threads" * doctest::timeout(300)) {
+  steal_batch_binary_tree(4);
+}
+
+TEST_CASE("StealBatch.BinaryTree.8threads" * doctest::timeout(300)) {
+  steal_batch_binary_tree(8);
+}
+
+// ----------------------------------------------------------------------------
+// Burst of tasks submitted from outside the executor
+// ----------------------------------------------------------------------------
+
+void steal_batch_burst(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<10000; i++) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  for(size_t i=0; i<10000; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  executor.run_n(taskflow, 10);
+  executor.wait_for_all();
+
+  REQUIRE(counter == 110000);
+}
+
+TEST_CASE("StealBatch.Burst.1thread" * doctest::timeout(300)) {
+  steal_batch_burst(1);
+}
+
+TEST_CASE("StealBatch.Burst.2threads" * doctest::timeout(300)) {
+  steal_batch_burst(2);
+}
+
+TEST_CASE("StealBatch.Burst.4threads" * doctest::timeout(300)) {
+  steal_batch_burst(4);
+}
+
+TEST_CASE("StealBatch.Burst.8threads" * doctest::timeout(300)) {
+  steal_batch_burst(8);
+}
+
+// ----------------------------------------------------------------------------
+// Corun
+// ----------------------------------------------------------------------------
+
+void steal_batch_corun(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  // each subflow joins its children while other workers steal them in batches
+  for(size_t i=0; i<100; i++) {
+    taskflow.emplace([&](tf::Subflow& sf){
+      for(size_t j=0; j<500; j++) {
+        sf.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+      }
+      sf.join();
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+  }
+
+  executor.run(taskflow).wait();
+
+  REQUIRE(counter == 100 * 501);
+}
+
+TEST_CASE("StealBatch.Corun.1thread" * doctest::timeout(300)) {
+  steal_batch_corun(1);
+}
+
+TEST_CASE("StealBatch.Corun.2threads" * doctest::timeout(300)) {
+  steal_batch_corun(2);
+}
+
+TEST_CASE("StealBatch.Corun.4threads" * doctest::timeout(300)) {
+  steal_batch_corun(4);
+}
+
+TEST_CASE("StealBatch.Corun.8threads" * doctest::timeout(300)) {
+  steal_batch_corun(8);
+}
+
+// ----------------------------------------------------------------------------
+// Starvation
+// ----------------------------------------------------------------------------
+
+// Half of the workers busy-wait on tasks that may sit in their own queues 
+// after a batch steal, which other workers must still be able to steal.
+void steal_batch_starvation(unsigned W) {
+
+  tf::Executor executor(W);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  const size_t N = 1000;
+
+  auto source = taskflow.emplace([](){});
+
+  for(size_t i=0; i<N; i++) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); })
+            .succeed(source);
+  }
+
+  for(size_t i=0; i<W/2; i++) {
+    taskflow.emplace([&](){
+      while(counter.load(std::memory_order_relaxed) < N) {
+        std::this_thread::yield();
+      }
+    }).succeed(source);
+  }
+
+  executor.run(taskflow).wait();
+
+  REQUIRE(counter == N);
+}
+
+TEST_CASE("StealBatch.Starvation.2threads" * doctest::timeout(300)) {
+  steal_batch_starvation(2);
+}
+
+TEST_CASE("StealBatch.Starvation.4threads" * doctest::timeout(300)) {
+  steal_batch_starvation(4);
+}
+
+TEST_CASE("StealBatch.Starvation.8threads" * doctest::timeout(300)) {
+  steal_batch_starvation(8);
+}
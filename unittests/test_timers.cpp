@@ -0,0 +1,401 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+
+#include <doctest.h>
+#include <taskflow/taskflow.hpp>
+
+#include <map>
+#include <random>
+
+// ----------------------------------------------------------------------------
+// TimerWheel: items expire exactly at their ticks in the order of ticks
+// ----------------------------------------------------------------------------
+
+TEST_CASE("TimerWheel" * doctest::timeout(300)) {
+
+  std::mt19937_64 rng(0);
+
+  for(size_t trial=0; trial<20; trial++) {
+
+    tf::TimerWheel<size_t> wheel;
+    std::multimap<uint64_t, size_t> expected;
+    size_t id = 0;
+
+    REQUIRE(wheel.empty());
+    REQUIRE(wheel.next_tick() == tf::TimerWheel<size_t>::NO_TICK);
+
+    for(size_t step=0; step<1000; step++) {
+
+      // mostly near timers and a few far ones beyond the last level
+      for(size_t k=rng()%5; k>0; k--) {
+        uint64_t range = (rng() % 4 == 0) ? (uint64_t{1} << (rng() % 30)) : 200;
+        uint64_t tick = std::max(wheel.now() + rng() % range, wheel.now() + 1);
+        wheel.insert(tick, id);
+        expected.emplace(tick, id++);
+      }
+
+      uint64_t to = wheel.now() + ((rng() % 10 == 0) ? rng() % (uint64_t{1} << 26) : rng() % 100);
+      uint64_t last = 0;
+
+      wheel.advance(to, [&](size_t i){
+        REQUIRE(wheel.now() >= last);
+        last = wheel.now();
+        auto [beg, end] = expected.equal_range(wheel.now());
+        auto itr = std::find_if(beg, end, [i](auto& e){ return e.second == i; });
+        REQUIRE(itr != end);
+        expected.erase(itr);
+      });
+
+      REQUIRE(wheel.now() == to);
+      REQUIRE(wheel.size() == expected.size());
+      REQUIRE((expected.empty() || expected.begin()->first > to));
+    }
+  }
+}
+
+TEST_CASE("TimerWheel.RemoveIf" * doctest::timeout(300)) {
+
+  tf::TimerWheel<size_t> wheel;
+
+  // items on every level and in the overflow list
+  for(size_t i=0; i<1000; i++) {
+    wheel.insert(1 + (uint64_t{1} << (i % 30)) + i, i);
+  }
+
+  std::vector<size_t> removed;
+  wheel.remove_if([&](size_t& i){
+    if(i % 2) {
+      removed.push_back(i);
+      return true;
+    }
+    return false;
+  });
+
+  REQUIRE(removed.size() == 500);
+  REQUIRE(wheel.size() == 500);
+
+  size_t n = 0;
+  wheel.advance(uint64_t{1} << 32, [&](size_t i){
+    REQUIRE(i % 2 == 0);
+    n++;
+  });
+  REQUIRE(n == 500);
+  REQUIRE(wheel.empty());
+}
+
+// ----------------------------------------------------------------------------
+// AsyncAfter: tasks never run before their deadline
+// ----------------------------------------------------------------------------
+
+void timers_async_after(unsigned W) {
+
+  tf::Executor executor(W);
+
+  const size_t N = 1000;
+
+  std::vector<std::future<bool>> futures;
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<N; i++) {
+    auto delay = std::chrono::microseconds((i * 7919) % 20000);
+    auto deadline = std::chrono::steady_clock::now() + delay;
+    futures.push_back(executor.async_after(delay, [&, deadline](){
+      counter++;
+      return std::chrono::steady_clock::now() >= deadline;
+    }));
+    executor.silent_async([&](){ counter++; });
+  }
+
+  for(auto& fu : futures) {
+    REQUIRE(fu.get());
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 2*N);
+}
+
+TEST_CASE("Timers.AsyncAfter.1thread" * doctest::timeout(300)) {
+  timers_async_after(1);
+}
+
+TEST_CASE("Timers.AsyncAfter.2threads" * doctest::timeout(300)) {
+  timers_async_after(2);
+}
+
+TEST_CASE("Timers.AsyncAfter.4threads" * doctest::timeout(300)) {
+  timers_async_after(4);
+}
+
+// ----------------------------------------------------------------------------
+// AsyncAt: time points of any clock, past time points, runtime tasks,
+// and task parameters
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.AsyncAt" * doctest::timeout(300)) {
+
+  tf::Executor executor({{"a", 1}, {"b", 2}});
+
+  auto beg = std::chrono::steady_clock::now();
+
+  auto f1 = executor.async_at(beg + std::chrono::milliseconds(10), [](){
+    return std::chrono::steady_clock::now();
+  });
+  REQUIRE(f1.get() >= beg + std::chrono::milliseconds(10));
+
+  auto f2 = executor.async_at(
+    std::chrono::system_clock::now() + std::chrono::milliseconds(10), [](){ return 2; }
+  );
+  REQUIRE(f2.get() == 2);
+
+  // a time point in the past runs right away
+  auto f3 = executor.async_at(beg - std::chrono::hours(1), [](){ return 3; });
+  REQUIRE(f3.get() == 3);
+
+  // runtime tasks can spawn subtasks
+  std::atomic<size_t> counter {0};
+  auto f4 = executor.async_after(std::chrono::milliseconds(1), [&](tf::Runtime& rt){
+    for(size_t i=0; i<10; i++) {
+      rt.silent_async([&](){ counter++; });
+    }
+    rt.corun();
+  });
+  f4.get();
+  REQUIRE(counter == 10);
+
+  // parameters choose the arena
+  tf::TaskParams params;
+  params.arena = executor.arena_id("b");
+  auto f5 = executor.async_after(params, std::chrono::milliseconds(1), [&](){
+    return executor.this_worker_id();
+  });
+  auto id = f5.get();
+  REQUIRE((id == 1 || id == 2));
+
+  // exceptions are propagated through the future
+  auto f6 = executor.async_after(std::chrono::milliseconds(1), [](){
+    throw std::runtime_error("x");
+  });
+  REQUIRE_THROWS_WITH_AS(f6.get(), "x", std::runtime_error);
+}
+
+// ----------------------------------------------------------------------------
+// WaitForAll: pending timers count towards wait_for_all
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.WaitForAll" * doctest::timeout(300)) {
+
+  std::atomic<size_t> counter {0};
+
+  tf::Executor executor(2);
+
+  for(size_t r=1; r<=2; r++) {
+    for(size_t i=0; i<100; i++) {
+      executor.async_after(std::chrono::milliseconds(i % 10), [&](){ counter++; });
+    }
+    executor.wait_for_all();
+    REQUIRE(counter == 100*r);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Destructor: the destruction of the executor drops the tasks of pending 
+// timers instead of waiting for their time
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.Destructor" * doctest::timeout(300)) {
+
+  std::atomic<size_t> counter {0};
+  std::atomic<bool> armed {false};
+  tf::Future<int> future;
+
+  auto beg = std::chrono::steady_clock::now();
+  {
+    tf::Executor executor(2);
+    future = executor.async_after(std::chrono::hours(1), [&](){ 
+      counter++; 
+      return 1;
+    });
+    for(size_t i=0; i<100; i++) {
+      executor.async_after(std::chrono::hours(1 + i), [&](){ counter++; });
+    }
+    // a task running at the destruction can still arm a timer
+    executor.silent_async([&](){
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      executor.async_after(std::chrono::hours(1), [&](){ counter++; });
+      armed = true;
+    });
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  REQUIRE(armed == true);
+  REQUIRE(counter == 0);
+  REQUIRE_THROWS_AS(future.get(), std::future_error);
+  REQUIRE(end - beg < std::chrono::minutes(1));
+}
+
+// ----------------------------------------------------------------------------
+// Saturation: deadlines beyond the range of the steady clock do not overflow
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.Saturation" * doctest::timeout(300)) {
+
+  std::atomic<size_t> counter {0};
+  std::vector<tf::Future<void>> futures;
+  tf::Taskflow taskflow;
+  taskflow.emplace([&](){ counter++; });
+  {
+    tf::Executor executor(2);
+
+    futures.push_back(executor.async_after(std::chrono::nanoseconds::max(), [&](){ counter++; }));
+    futures.push_back(executor.async_after(std::chrono::hours::max(), [&](){ counter++; }));
+    futures.push_back(executor.async_after(std::chrono::duration<double>(1e300), [&](){ counter++; }));
+    futures.push_back(executor.async_at(std::chrono::steady_clock::time_point::max(), [&](){ counter++; }));
+    futures.push_back(executor.async_at(
+      std::chrono::time_point<std::chrono::steady_clock, std::chrono::hours>::max(), [&](){ counter++; }
+    ));
+    futures.push_back(executor.async_at(std::chrono::system_clock::time_point::max(), [&](){ counter++; }));
+    
+    executor.run_every(std::chrono::nanoseconds::max(), taskflow);
+
+    // negative delays run right away
+    executor.async_after(std::chrono::nanoseconds::min(), [&](){ counter++; }).get();
+    executor.async_after(std::chrono::hours::min(), [&](){ counter++; }).get();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    REQUIRE(counter == 2);
+  }
+
+  for(auto& fu : futures) {
+    REQUIRE_THROWS_AS(fu.get(), std::future_error);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Many: tens of thousands of pending timers
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.Many" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+
+  const size_t N = 50000;
+  std::atomic<size_t> counter {0};
+
+  std::vector<std::thread> producers;
+  for(size_t p=0; p<4; p++) {
+    producers.emplace_back([&, p](){
+      for(size_t i=p; i<N; i+=4) {
+        executor.async_after(std::chrono::microseconds(i % 50000), [&](){ counter++; });
+      }
+    });
+  }
+  for(auto& p : producers) {
+    p.join();
+  }
+
+  executor.wait_for_all();
+  REQUIRE(counter == N);
+}
+
+// ----------------------------------------------------------------------------
+// RunEvery
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.RunEvery" * doctest::timeout(300)) {
+
+  tf::Executor executor(2);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+  taskflow.emplace([&](){ counter++; });
+
+  REQUIRE_THROWS(executor.run_every(std::chrono::milliseconds(0), taskflow));
+
+  tf::PeriodicRun empty;
+  REQUIRE(empty.cancelled());
+  REQUIRE_NOTHROW(empty.cancel());
+
+  auto handle = executor.run_every(std::chrono::milliseconds(2), taskflow);
+  REQUIRE(!handle.cancelled());
+
+  while(counter < 10);
+
+  handle.cancel();
+  REQUIRE(handle.cancelled());
+  executor.wait_for_all();
+
+  // no run starts after the cancellation
+  auto n = counter.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  REQUIRE(counter == n);
+}
+
+// ----------------------------------------------------------------------------
+// RunEvery.Skip: runs of a slow taskflow do not overlap
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.RunEvery.Skip" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> running {0};
+  std::atomic<size_t> counter {0};
+
+  taskflow.emplace([&](){
+    REQUIRE(running.fetch_add(1) == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    running--;
+    counter++;
+  });
+
+  auto handle = executor.run_every(std::chrono::milliseconds(1), taskflow);
+  while(counter < 5);
+  handle.cancel();
+  executor.wait_for_all();
+
+  REQUIRE(running == 0);
+}
+
+// ----------------------------------------------------------------------------
+// RunEvery.Cancel: no run starts once the cancellation returns, even if
+// a start is underway at the time of the call
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.RunEvery.Cancel" * doctest::timeout(300)) {
+
+  tf::Executor executor(4);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+  taskflow.emplace([&](){ counter++; });
+
+  for(size_t r=0; r<100; r++) {
+    auto handle = executor.run_every(std::chrono::microseconds(100), taskflow);
+    std::this_thread::sleep_for(std::chrono::microseconds(100 * (r % 10)));
+    handle.cancel();
+    executor.wait_for_all();
+    auto n = counter.load();
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    executor.wait_for_all();
+    REQUIRE(counter == n);
+  }
+}
+
+// ----------------------------------------------------------------------------
+// RunEvery.Destructor: the executor stops the periodic runs it is
+// destroyed with
+// ----------------------------------------------------------------------------
+
+TEST_CASE("Timers.RunEvery.Destructor" * doctest::timeout(300)) {
+
+  tf::Taskflow taskflow;
+  std::atomic<size_t> counter {0};
+  taskflow.emplace([&](){ counter++; });
+
+  for(size_t r=0; r<10; r++) {
+    tf::Executor executor(2);
+    for(size_t i=0; i<10; i++) {
+      executor.run_every(std::chrono::microseconds(100 * (i + 1)), taskflow);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(r));
+  }
+}
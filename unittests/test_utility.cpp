@@ -5,9 +5,15 @@
 #include <taskflow/utility/traits.hpp>
 //#include <taskflow/utility/object_pool.hpp>
 #include <taskflow/utility/small_vector.hpp>
+#include <taskflow/utility/small_function.hpp>
 #include <taskflow/utility/uuid.hpp>
 #include <taskflow/utility/iterator.hpp>
 #include <taskflow/utility/math.hpp>
+#include <taskflow/utility/slab_allocator.hpp>
+
+#include <array>
+#include <set>
+#include <thread>
 
 // --------------------------------------------------------
 // Testcase: SmallVector
@@ -184,6 +190,106 @@ TEST_CASE("SmallVector" * doctest::timeout(300)) {
   }
 }
 
+// --------------------------------------------------------
+// Testcase: SmallFunction
+// --------------------------------------------------------
+
+// callable of S bytes that counts its heap allocations and live objects
+template <size_t S>
+struct SmallFunctionCallable {
+
+  inline static int num_allocations = 0;
+  inline static int num_objects = 0;
+
+  std::array<char, S> data {};
+  int* counter;
+
+  SmallFunctionCallable(int* c) : counter {c} { ++num_objects; }
+  SmallFunctionCallable(SmallFunctionCallable&& rhs) noexcept : 
+    data {rhs.data}, counter {rhs.counter} { ++num_objects; }
+  SmallFunctionCallable(const SmallFunctionCallable&) = delete;
+  ~SmallFunctionCallable() { --num_objects; }
+
+  int operator () (int v) { return *counter += v; }
+
+  static void* operator new (size_t n) {
+    ++num_allocations;
+    return ::operator new(n);
+  }
+
+  static void operator delete (void* p) {
+    ::operator delete(p);
+  }
+};
+
+template <size_t S>
+void small_function(bool is_inline) {
+
+  using C = SmallFunctionCallable<S>;
+
+  int counter = 0;
+
+  {
+    tf::SmallFunction<int(int)> f1(C{&counter});
+    REQUIRE(static_cast<bool>(f1) == true);
+    REQUIRE(C::num_allocations == (is_inline ? 0 : 1));
+    REQUIRE(C::num_objects == 1);
+    REQUIRE(f1(2) == 2);
+    REQUIRE(counter == 2);
+
+    // move construction keeps the same callable alive
+    tf::SmallFunction<int(int)> f2(std::move(f1));
+    REQUIRE(static_cast<bool>(f1) == false);
+    REQUIRE(static_cast<bool>(f2) == true);
+    REQUIRE(C::num_objects == 1);
+    REQUIRE(f2(3) == 5);
+
+    // move assignment destroys the replaced callable
+    tf::SmallFunction<int(int)> f3(C{&counter});
+    REQUIRE(C::num_objects == 2);
+    f3 = std::move(f2);
+    REQUIRE(C::num_objects == 1);
+    REQUIRE(f3(5) == 10);
+    REQUIRE(C::num_allocations == (is_inline ? 0 : 2));
+  }
+
+  REQUIRE(C::num_objects == 0);
+  REQUIRE(counter == 10);
+}
+
+TEST_CASE("SmallFunction.Inline" * doctest::timeout(300)) {
+  small_function<8>(true);
+  small_function<TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE - sizeof(int*)>(true);
+}
+
+TEST_CASE("SmallFunction.Heap" * doctest::timeout(300)) {
+  small_function<TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE>(false);
+  small_function<1024>(false);
+}
+
+TEST_CASE("SmallFunction.MoveOnly" * doctest::timeout(300)) {
+
+  auto ptr = std::make_unique<int>(1);
+
+  tf::SmallFunction<int()> f([p=std::move(ptr)](){ return ++*p; });
+  REQUIRE(f() == 2);
+  REQUIRE(f() == 3);
+
+  // void signature discards the result
+  tf::SmallFunction<void(int&)> g([](int& v){ return v *= 2; });
+  int v = 4;
+  g(v);
+  REQUIRE(v == 8);
+
+  // function pointer
+  tf::SmallFunction<int(int)> h(+[](int x){ return x + 1; });
+  REQUIRE(h(1) == 2);
+
+  tf::SmallFunction<void()> e;
+  REQUIRE(static_cast<bool>(e) == false);
+  REQUIRE(sizeof(e) == TF_DEFAULT_SMALL_FUNCTION_BUFFER_SIZE + 2*sizeof(void*));
+}
+
 // --------------------------------------------------------
 // Testcase: distance
 // --------------------------------------------------------
@@ -444,6 +550,221 @@ TEST_CASE("ObjectPool.16threads" * doctest::timeout(300)) {
 }
 */
 
+// --------------------------------------------------------
+// Testcase: SlabAllocator.Sequential
+// --------------------------------------------------------
+
+struct Slabable {
+  std::string str;
+  std::vector<int> vec;
+  int a;
+  char b;
+
+  Slabable(int v) : str(std::to_string(v)), vec(4, v), a {v}, b {'x'} {}
+};
+
+TEST_CASE("SlabAllocator.Sequential" * doctest::timeout(300)) {
+
+  tf::SlabAllocator<Slabable> slab;
+
+  REQUIRE(slab.num_slots_per_slab() > 0);
+
+  size_t N = 10*slab.num_slots_per_slab() + 1;
+
+  std::set<Slabable*> set;
+
+  for(size_t i=0; i<N; ++i) {
+    auto item = slab.animate(static_cast<int>(i));
+    REQUIRE(item->a == static_cast<int>(i));
+    REQUIRE(item->str == std::to_string(i));
+    REQUIRE(reinterpret_cast<uintptr_t>(item) % alignof(Slabable) == 0);
+    REQUIRE(set.find(item) == set.end());
+    set.insert(item);
+  }
+
+  for(auto s : set) {
+    slab.recycle(s);
+  }
+
+  // all slots are reused by the same thread
+  for(size_t i=0; i<N; ++i) {
+    auto item = slab.animate(static_cast<int>(i));
+    REQUIRE(set.find(item) != set.end());
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: SlabAllocator.RemoteFree
+// --------------------------------------------------------
+
+void slab_remote_free(unsigned W) {
+
+  tf::SlabAllocator<Slabable> slab;
+
+  // each thread allocates items that are freed by its right neighbor
+  std::vector<std::vector<Slabable*>> items(W);
+  std::vector<std::thread> threads;
+  std::atomic<size_t> ready {0};
+  
+  for(unsigned w=0; w<W; ++w) {
+    threads.emplace_back([&, w](){
+      for(int i=0; i<10000; ++i) {
+        items[w].push_back(slab.animate(i));
+      }
+      ready++;
+      while(ready != W);
+      for(auto item : items[(w + 1) % W]) {
+        REQUIRE(item->vec.size() == 4);
+        slab.recycle(item);
+      }
+      // reuse both local and remotely freed slots
+      std::vector<Slabable*> local;
+      for(int i=0; i<20000; ++i) {
+        local.push_back(slab.animate(i));
+      }
+      std::set<Slabable*> unique(local.begin(), local.end());
+      REQUIRE(unique.size() == local.size());
+      for(auto item : local) {
+        slab.recycle(item);
+      }
+    });
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST_CASE("SlabAllocator.RemoteFree.1thread" * doctest::timeout(300)) {
+  slab_remote_free(1);
+}
+
+TEST_CASE("SlabAllocator.RemoteFree.2threads" * doctest::timeout(300)) {
+  slab_remote_free(2);
+}
+
+TEST_CASE("SlabAllocator.RemoteFree.4threads" * doctest::timeout(300)) {
+  slab_remote_free(4);
+}
+
+TEST_CASE("SlabAllocator.RemoteFree.8threads" * doctest::timeout(300)) {
+  slab_remote_free(8);
+}
+
+TEST_CASE("SlabAllocator.RemoteFree.16threads" * doctest::timeout(300)) {
+  slab_remote_free(16);
+}
+
+// --------------------------------------------------------
+// Testcase: SlabAllocator.ThreadChurn
+// --------------------------------------------------------
+
+TEST_CASE("SlabAllocator.ThreadChurn" * doctest::timeout(300)) {
+
+  tf::SlabAllocator<Slabable> slab;
+
+  // items outlive the threads that allocated them
+  std::vector<Slabable*> items;
+  std::mutex mutex;
+
+  for(int r=0; r<100; r++) {
+    std::thread([&, r](){
+      auto item = slab.animate(r);
+      std::scoped_lock lock(mutex);
+      items.push_back(item);
+    }).join();
+  }
+
+  for(int r=0; r<100; r++) {
+    REQUIRE(items[r]->a == r);
+    slab.recycle(items[r]);
+  }
+}
+
+// --------------------------------------------------------
+// Testcase: SlabAllocator.ThreadExit
+// --------------------------------------------------------
+
+// recycles its items when its thread exits, after the heap of the thread
+// has been orphaned since the heap is created later
+struct SlabDeferredRecycle {
+  tf::SlabAllocator<Slabable>* slab {nullptr};
+  std::vector<Slabable*> items;
+  ~SlabDeferredRecycle() {
+    for(auto item : items) {
+      slab->recycle(item);
+    }
+  }
+};
+
+TEST_CASE("SlabAllocator.ThreadExit" * doctest::timeout(300)) {
+
+  tf::SlabAllocator<Slabable> slab;
+
+  std::atomic<size_t> counter {0};
+
+  // other threads adopt the orphaned heaps while the exiting threads
+  // still recycle into them
+  for(int r=0; r<100; r++) {
+    std::thread exiting([&](){
+      thread_local SlabDeferredRecycle deferred;
+      deferred.slab = &slab;
+      for(int i=0; i<64; i++) {
+        deferred.items.push_back(slab.animate(i));
+      }
+    });
+    std::thread adopting([&](){
+      for(int i=0; i<1000; i++) {
+        auto item = slab.animate(i);
+        counter.fetch_add(item->a == i, std::memory_order_relaxed);
+        slab.recycle(item);
+      }
+    });
+    exiting.join();
+    adopting.join();
+  }
+
+  REQUIRE(counter == 100*1000);
+}
+
+// --------------------------------------------------------
+// Testcase: SlabAllocator.SharedPtr
+// --------------------------------------------------------
+
+TEST_CASE("SlabAllocator.SharedPtr" * doctest::timeout(300)) {
+
+  tf::SlabStdAllocator<Slabable> alloc;
+
+  // slots of released objects are reused by later objects
+  std::set<const void*> slots;
+  for(int i=0; i<1000; i++) {
+    auto ptr = std::allocate_shared<Slabable>(alloc, i);
+    REQUIRE(ptr->a == i);
+    REQUIRE(ptr->vec.size() == 4);
+    slots.insert(ptr.get());
+  }
+  REQUIRE(slots.size() == 1);
+
+  // objects released by other threads
+  std::vector<std::shared_ptr<Slabable>> items;
+  for(int i=0; i<1000; i++) {
+    items.push_back(std::allocate_shared<Slabable>(alloc, i));
+  }
+  std::thread([&](){ items.clear(); }).join();
+
+  for(int i=0; i<1000; i++) {
+    items.push_back(std::allocate_shared<Slabable>(alloc, i));
+    REQUIRE(items.back()->a == i);
+  }
+
+  // array allocations bypass the slabs
+  std::vector<Slabable, tf::SlabStdAllocator<Slabable>> vec(alloc);
+  for(int i=0; i<100; i++) {
+    vec.emplace_back(i);
+  }
+  REQUIRE(vec[99].a == 99);
+}
+
 
 // --------------------------------------------------------
 // Testcase: Reference Wrapper
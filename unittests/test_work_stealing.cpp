@@ -2,6 +2,9 @@
 
 #include <doctest.h>
 #include <taskflow/taskflow.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
 
 // ----------------------------------------------------------------------------
 // Starvation Test
@@ -1058,3 +1061,130 @@ TEST_CASE("WorkStealing.Continuation.8threads" * doctest::timeout(300)) {
 }
 
 
+
+// ----------------------------------------------------------------------------
+// CPU Topology
+// ----------------------------------------------------------------------------
+
+TEST_CASE("WorkStealing.CPUTopology.Sysfs") {
+
+  // emulate a two-socket machine of 8 CPUs, each socket having two L3 domains
+  // a unique directory such that concurrent runs of the test do not collide
+  auto root = std::filesystem::temp_directory_path() / 
+              ("tf_cpu_topology_" + std::to_string(std::random_device{}()));
+  std::filesystem::remove_all(root);
+
+  auto write = [&](const std::filesystem::path& path, const std::string& line){
+    std::filesystem::create_directories((root / path).parent_path());
+    std::ofstream(root / path) << line << '\n';
+  };
+
+  write("cpu/present", "0-7");
+  for(size_t c=0; c<8; c++) {
+    auto cpu = "cpu/cpu" + std::to_string(c);
+    write(cpu + "/topology/physical_package_id", std::to_string(c/4));
+    write(cpu + "/cache/index0/level", "1");
+    write(cpu + "/cache/index1/level", "2");
+    write(cpu + "/cache/index2/level", "3");
+    write(cpu + "/cache/index2/shared_cpu_list", c < 2 ? "0-1" : c < 4 ? "2-3" : c < 6 ? "4-5" : "6-7");
+  }
+  write("node/possible", "0-1");
+  write("node/node0/cpulist", "0-3");
+  write("node/node1/cpulist", "4-7");
+
+  auto topology = tf::CPUTopology::from_sysfs(root.string());
+
+  REQUIRE(topology.num_cpus() == 8);
+
+  for(size_t c=0; c<8; c++) {
+    REQUIRE(topology[c].l3 == c/2*2);
+    REQUIRE(topology[c].numa == c/4);
+  }
+
+  REQUIRE(topology.distance(0, 1) == 0);
+  REQUIRE(topology.distance(0, 2) == 1);
+  REQUIRE(topology.distance(0, 4) == 2);
+  REQUIRE(topology.distance(5, 4) == 0);
+  REQUIRE(topology.distance(5, 7) == 1);
+  REQUIRE(topology.distance(5, 3) == 2);
+
+  // workers beyond the number of CPUs wrap around
+  REQUIRE(topology.distance(8, 1) == 0);
+  REQUIRE(topology.distance(12, 0) == 2);
+
+  // without NUMA information, the package is used
+  std::filesystem::remove_all(root / "node");
+  topology = tf::CPUTopology::from_sysfs(root.string());
+  REQUIRE(topology.num_cpus() == 8);
+  REQUIRE(topology.distance(0, 2) == 1);
+  REQUIRE(topology.distance(0, 4) == 2);
+
+  std::filesystem::remove_all(root);
+
+  // unreadable root gives an empty topology
+  topology = tf::CPUTopology::from_sysfs(root.string());
+  REQUIRE(topology.empty());
+  REQUIRE(topology.distance(0, 100) == 0);
+}
+
+void topology_starvation(size_t W) {
+
+  // emulate two NUMA nodes, each having two L3 domains of two CPUs
+  tf::CPUTopology topology({
+    {0, 0}, {0, 0}, {1, 0}, {1, 0},
+    {2, 1}, {2, 1}, {3, 1}, {3, 1}
+  });
+
+  tf::Taskflow taskflow;
+  tf::Executor executor(W, topology);
+  std::atomic<size_t> counter{0};
+
+  // every worker must eventually reach every other worker's queue
+  for(size_t r=0; r<10; r++) {
+    taskflow.clear();
+    counter = 0;
+    auto source = taskflow.placeholder();
+    for(size_t b=0; b<W; b++) {
+      taskflow.emplace([&](){
+        counter.fetch_add(1, std::memory_order_relaxed);
+        while(counter.load(std::memory_order_relaxed) < W) {
+          std::this_thread::yield();
+        }
+      }).succeed(source);
+    }
+    executor.run(taskflow).wait();
+    REQUIRE(counter == W);
+  }
+
+  // async tasks go through the shared buffers
+  counter = 0;
+  for(size_t i=0; i<10000; i++) {
+    executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 10000);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.1thread" * doctest::timeout(300)) {
+  topology_starvation(1);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.2threads" * doctest::timeout(300)) {
+  topology_starvation(2);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.3threads" * doctest::timeout(300)) {
+  topology_starvation(3);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.4threads" * doctest::timeout(300)) {
+  topology_starvation(4);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.8threads" * doctest::timeout(300)) {
+  topology_starvation(8);
+}
+
+TEST_CASE("WorkStealing.CPUTopology.Starvation.13threads" * doctest::timeout(300)) {
+  topology_starvation(13);
+}
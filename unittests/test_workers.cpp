@@ -2,6 +2,7 @@
 
 #include <doctest.h>
 #include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
 
 class CustomWorkerBehavior : public tf::WorkerInterface {
 
@@ -80,3 +81,433 @@ TEST_CASE("WorkerInterface.Basics.7threads" * doctest::timeout(300)) {
 TEST_CASE("WorkerInterface.Basics.8threads" * doctest::timeout(300)) {
   worker_interface_basics(8);
 }
+
+// ----------------------------------------------------------------------------
+// Resize
+// ----------------------------------------------------------------------------
+
+void resize_under_load(unsigned M) {
+
+  tf::Executor executor(1, M);
+
+  REQUIRE(executor.num_workers() == 1);
+  REQUIRE(executor.max_num_workers() == M);
+
+  std::atomic<size_t> counter{0};
+
+  tf::Taskflow taskflow;
+  for(size_t i=0; i<1000; i++) {
+    taskflow.emplace([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+
+  // resize while topologies and async tasks are running
+  size_t expected = 0;
+  for(size_t r=0; r<2*M; r++) {
+    auto fu = executor.run_n(taskflow, 2);
+    for(size_t i=0; i<1000; i++) {
+      executor.silent_async([&](){ counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+    auto N = (r*7 + 3) % M + 1;
+    executor.resize(N);
+    REQUIRE(executor.num_workers() == N);
+    fu.wait();
+    executor.wait_for_all();
+    expected += 3000;
+    REQUIRE(counter == expected);
+  }
+
+  // only the running workers take tasks
+  for(size_t N=M; N>=1; N--) {
+    executor.resize(N);
+    std::atomic<size_t> invalid {0};
+    tf::Taskflow parallel;
+    parallel.for_each_index(0, 1000, 1, [&](int){
+      if(executor.this_worker_id() >= static_cast<int>(N)) {
+        invalid++;
+      }
+    });
+    executor.run(parallel).wait();
+    REQUIRE(invalid == 0);
+  }
+}
+
+TEST_CASE("Executor.Resize.1thread" * doctest::timeout(300)) {
+  resize_under_load(1);
+}
+
+TEST_CASE("Executor.Resize.2threads" * doctest::timeout(300)) {
+  resize_under_load(2);
+}
+
+TEST_CASE("Executor.Resize.3threads" * doctest::timeout(300)) {
+  resize_under_load(3);
+}
+
+TEST_CASE("Executor.Resize.4threads" * doctest::timeout(300)) {
+  resize_under_load(4);
+}
+
+TEST_CASE("Executor.Resize.8threads" * doctest::timeout(300)) {
+  resize_under_load(8);
+}
+
+TEST_CASE("Executor.Resize.WorkerInterface" * doctest::timeout(300)) {
+
+  std::atomic<size_t> counter{0};
+  std::vector<size_t> ids;
+
+  {
+    tf::Executor executor(2, 4, tf::make_worker_interface<CustomWorkerBehavior>(counter, ids));
+    REQUIRE(executor.num_workers() == 2);
+    executor.resize(4);   // spawns workers 2 and 3
+    executor.resize(1);   // retires workers 1, 2, and 3
+    REQUIRE(counter == 4 + 3);
+    executor.resize(3);   // spawns workers 1 and 2 again
+    REQUIRE(executor.num_workers() == 3);
+  }
+
+  // 6 prologues and 6 epilogues
+  REQUIRE(counter == 12);
+  REQUIRE(ids.size() == 6);
+
+  std::sort(ids.begin(), ids.end());
+  REQUIRE(ids == std::vector<size_t>{0, 1, 1, 2, 2, 3});
+}
+
+TEST_CASE("Executor.Resize.Exceptions" * doctest::timeout(300)) {
+
+  REQUIRE_THROWS(tf::Executor(5, 4));
+
+  tf::Executor executor(2, 4);
+
+  REQUIRE_THROWS(executor.resize(0));
+  REQUIRE_THROWS(executor.resize(5));
+  REQUIRE(executor.num_workers() == 2);
+
+  executor.async([&](){
+    REQUIRE_THROWS(executor.resize(1));
+  }).get();
+
+  REQUIRE(executor.num_workers() == 2);
+}
+
+// ----------------------------------------------------------------------------
+// Spin Policy
+// ----------------------------------------------------------------------------
+
+class CountingSpinPolicy : public tf::SpinPolicy {
+
+  public:
+
+  std::atomic<size_t> num_budgets {0};
+  std::atomic<size_t> num_tasks {0};
+  std::atomic<size_t> num_sleeps {0};
+
+  tf::SpinBudget budget(const tf::Worker&, size_t num_queues) override {
+    num_budgets.fetch_add(1, std::memory_order_relaxed);
+    return {num_queues + 1, 0};
+  }
+
+  void on_task(const tf::Worker&, std::chrono::nanoseconds latency, size_t, bool slept) override {
+    REQUIRE(latency.count() >= 0);
+    num_tasks.fetch_add(1, std::memory_order_relaxed);
+    if(slept) {
+      num_sleeps.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+void spin_policy(size_t W, std::shared_ptr<tf::SpinPolicy> policy) {
+
+  tf::Executor executor(W, nullptr, policy);
+  tf::Taskflow taskflow;
+
+  std::atomic<size_t> counter {0};
+
+  taskflow.for_each_index(size_t{0}, size_t{1000}, size_t{1}, [&](size_t){
+    counter.fetch_add(1, std::memory_order_relaxed);
+  });
+
+  for(size_t i=0; i<10; i++) {
+    executor.run(taskflow).wait();
+    // leave time for the workers to go to sleep
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  REQUIRE(counter == 10000);
+}
+
+TEST_CASE("SpinPolicy.Custom" * doctest::timeout(300)) {
+  
+  for(size_t W=1; W<=4; W++) {
+    auto policy = std::make_shared<CountingSpinPolicy>();
+    spin_policy(W, policy);
+    REQUIRE(policy->num_budgets > 0);
+    REQUIRE(policy->num_tasks > 0);
+    REQUIRE(policy->num_sleeps > 0);
+    REQUIRE(policy->num_sleeps <= policy->num_tasks);
+  }
+}
+
+TEST_CASE("SpinPolicy.Fixed" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    spin_policy(W, std::make_shared<tf::FixedSpinPolicy>());
+    spin_policy(W, std::make_shared<tf::FixedSpinPolicy>(1, 0));
+    spin_policy(W, std::make_shared<tf::FixedSpinPolicy>(64, 1000));
+  }
+}
+
+TEST_CASE("SpinPolicy.Adaptive" * doctest::timeout(300)) {
+  for(size_t W=1; W<=4; W++) {
+    spin_policy(W, std::make_shared<tf::AdaptiveSpinPolicy>());
+  }
+}
+
+TEST_CASE("SpinPolicy.Adaptive.Budget" * doctest::timeout(300)) {
+
+  using namespace std::chrono_literals;
+
+  tf::AdaptiveSpinPolicy policy(100us);
+  tf::Worker worker;
+
+  const size_t Q = 8;
+
+  // no history: one round of stealing
+  auto budget = policy.budget(worker, Q);
+  REQUIRE(budget.max_steals == Q + 1);
+  REQUIRE(budget.max_yields == 0);
+
+  // tasks arrive shortly after workers become idle: spin longer
+  for(size_t i=0; i<100; i++) {
+    policy.on_task(worker, 20us, 200, false);
+  }
+  REQUIRE(policy.latency() > 10us);
+  REQUIRE(policy.latency() <= 20us);
+  
+  budget = policy.budget(worker, Q);
+  REQUIRE(budget.max_steals == 2*(Q + 1));
+  REQUIRE(budget.max_steals + budget.max_yields > 200);
+  REQUIRE(budget.max_steals + budget.max_yields <= 1000);
+
+  // tasks arrive long after workers become idle: sleep early
+  for(size_t i=0; i<100; i++) {
+    policy.on_task(worker, 10ms, 0, true);
+  }
+  REQUIRE(policy.latency() > 100us);
+
+  budget = policy.budget(worker, Q);
+  REQUIRE(budget.max_steals == Q + 1);
+  REQUIRE(budget.max_yields == 0);
+  
+  // and adapt back
+  for(size_t i=0; i<100; i++) {
+    policy.on_task(worker, 1us, 10, false);
+  }
+  REQUIRE(policy.latency() < 100us);
+}
+
+// pollers must never go to sleep
+class CheckedBusyPollSpinPolicy : public tf::BusyPollSpinPolicy {
+
+  public:
+
+  using tf::BusyPollSpinPolicy::BusyPollSpinPolicy;
+
+  std::atomic<size_t> num_polls {0};
+  std::atomic<size_t> num_sleeps {0};
+
+  tf::SpinBudget budget(const tf::Worker& worker, size_t num_queues) override {
+    auto b = tf::BusyPollSpinPolicy::budget(worker, num_queues);
+    REQUIRE(b.poll == (worker.id() < num_pollers()));
+    REQUIRE(b.max_steals == 2*(num_queues + 1));
+    return b;
+  }
+
+  void on_task(const tf::Worker& worker, std::chrono::nanoseconds, size_t, bool slept) override {
+    if(worker.id() < num_pollers()) {
+      REQUIRE(slept == false);
+      num_polls.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if(slept) {
+      num_sleeps.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+};
+
+void busy_poll(size_t W, size_t K) {
+
+  auto policy = std::make_shared<CheckedBusyPollSpinPolicy>(K);
+
+  spin_policy(W, policy);
+
+  // tasks submitted one at a time, with the workers idle in between
+  tf::Executor executor(W, nullptr, policy);
+  std::atomic<size_t> counter {0};
+  for(size_t i=0; i<100; i++) {
+    executor.silent_async([&](){ counter++; });
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  executor.wait_for_all();
+  REQUIRE(counter == 100);
+
+  if(K > 0) {
+    REQUIRE(policy->num_polls > 0);
+  }
+}
+
+TEST_CASE("SpinPolicy.BusyPoll.1thread" * doctest::timeout(300)) {
+  busy_poll(1, 0);
+  busy_poll(1, 1);
+}
+
+TEST_CASE("SpinPolicy.BusyPoll.2threads" * doctest::timeout(300)) {
+  busy_poll(2, 1);
+  busy_poll(2, 2);
+}
+
+TEST_CASE("SpinPolicy.BusyPoll.4threads" * doctest::timeout(300)) {
+  busy_poll(4, 1);
+  busy_poll(4, 3);
+}
+
+// ----------------------------------------------------------------------------
+// CPU Pinning
+// ----------------------------------------------------------------------------
+
+TEST_CASE("CPUPinning.AvailableCPUs" * doctest::timeout(300)) {
+
+  auto cpus = tf::available_cpus();
+
+  REQUIRE(cpus.size() >= 1);
+  REQUIRE(std::is_sorted(cpus.begin(), cpus.end()));
+  REQUIRE(std::adjacent_find(cpus.begin(), cpus.end()) == cpus.end());
+  REQUIRE(tf::available_concurrency() == cpus.size());
+
+  tf::Executor executor;
+  REQUIRE(executor.num_workers() == cpus.size());
+}
+
+// runs tasks on W workers pinned by the given pinning and checks each
+// task runs on the CPU of its worker
+void cpu_pinning(size_t W, std::shared_ptr<tf::CPUPinning> pinning) {
+
+  tf::Executor executor(W, pinning->topology(), pinning);
+
+  std::atomic<size_t> counter {0};
+
+  for(size_t i=0; i<1000; i++) {
+    executor.silent_async([&](){
+#if TF_OS_LINUX
+      REQUIRE(sched_getcpu() == static_cast<int>(pinning->cpu(executor.this_worker_id())));
+#endif
+      counter++;
+    });
+  }
+  executor.wait_for_all();
+
+  REQUIRE(counter == 1000);
+}
+
+TEST_CASE("CPUPinning.Explicit" * doctest::timeout(300)) {
+
+  auto cpus = tf::available_cpus();
+
+  // unavailable CPUs are dropped
+  std::vector<size_t> list(cpus.rbegin(), cpus.rend());
+  list.push_back(cpus.back() + 1000);
+
+  auto pinning = std::make_shared<tf::CPUPinning>(list);
+  REQUIRE(pinning->cpus() == std::vector<size_t>(cpus.rbegin(), cpus.rend()));
+  REQUIRE(pinning->cpu(0) == cpus.back());
+  REQUIRE(pinning->cpu(cpus.size()) == cpus.back());
+
+  REQUIRE_THROWS(tf::CPUPinning(std::vector<size_t>{cpus.back() + 1000}));
+
+  for(size_t W=1; W<=4; W++) {
+    cpu_pinning(W, pinning);
+  }
+}
+
+TEST_CASE("CPUPinning.Compact" * doctest::timeout(300)) {
+
+  auto cpus = tf::available_cpus();
+
+  // each pair of CPUs shares an L3 domain and each four a NUMA node,
+  // numbered in the opposite order of the CPU ids
+  std::vector<tf::CPUTopology::CPU> domains(cpus.back() + 1);
+  for(size_t c=0; c<domains.size(); c++) {
+    domains[c] = {(domains.size() - c) / 2, (domains.size() - c) / 4};
+  }
+  tf::CPUTopology topology(domains);
+
+  auto pinning = std::make_shared<tf::CompactCPUPinning>(topology);
+  auto order = pinning->cpus();
+  
+  REQUIRE(std::is_permutation(order.begin(), order.end(), cpus.begin(), cpus.end()));
+
+  auto t = pinning->topology(topology);
+  REQUIRE(t.num_cpus() == order.size());
+  for(size_t i=0; i<order.size(); i++) {
+    REQUIRE(t[i].l3 == topology[order[i]].l3);
+    REQUIRE(t[i].numa == topology[order[i]].numa);
+    if(i) {
+      REQUIRE(std::make_pair(t[i-1].numa, t[i-1].l3) <= std::make_pair(t[i].numa, t[i].l3));
+    }
+  }
+
+  for(size_t W=1; W<=4; W++) {
+    cpu_pinning(W, pinning);
+  }
+}
+
+TEST_CASE("CPUPinning.Scatter" * doctest::timeout(300)) {
+
+  auto cpus = tf::available_cpus();
+
+  // each pair of CPUs shares an L3 domain and each four a NUMA node
+  std::vector<tf::CPUTopology::CPU> domains(cpus.back() + 1);
+  for(size_t c=0; c<domains.size(); c++) {
+    domains[c] = {c / 2, c / 4};
+  }
+  tf::CPUTopology topology(domains);
+
+  auto pinning = std::make_shared<tf::ScatterCPUPinning>(topology);
+  auto order = pinning->cpus();
+
+  REQUIRE(std::is_permutation(order.begin(), order.end(), cpus.begin(), cpus.end()));
+
+  // the first CPUs cover all L3 domains before any domain repeats
+  std::set<size_t> l3s;
+  for(auto c : cpus) {
+    l3s.insert(topology[c].l3);
+  }
+  std::set<size_t> first;
+  for(size_t i=0; i<l3s.size(); i++) {
+    first.insert(topology[order[i]].l3);
+  }
+  REQUIRE(first == l3s);
+
+  // consecutive CPUs alternate NUMA nodes while more than one node remains
+  std::set<size_t> nodes;
+  for(auto c : cpus) {
+    nodes.insert(topology[c].numa);
+  }
+  if(nodes.size() > 1) {
+    REQUIRE(topology[order[0]].numa != topology[order[1]].numa);
+  }
+
+  // a synthetic two-node machine of eight CPUs
+  std::vector<size_t> all(8);
+  std::iota(all.begin(), all.end(), 0);
+  tf::CPUTopology eight({
+    {0, 0}, {0, 0}, {2, 0}, {2, 0}, {4, 1}, {4, 1}, {6, 1}, {6, 1}
+  });
+  if(cpus == all) {
+    REQUIRE(tf::ScatterCPUPinning(eight).cpus() == std::vector<size_t>{0, 4, 2, 6, 1, 5, 3, 7});
+    REQUIRE(tf::CompactCPUPinning(eight).cpus() == all);
+  }
+
+  for(size_t W=1; W<=4; W++) {
+    cpu_pinning(W, pinning);
+  }
+}